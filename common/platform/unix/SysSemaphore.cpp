@@ -325,7 +325,7 @@ void SysSemaphore::reset()
  * @param createSem
  * @param critical  Indicates this is a critical-time semaphore only held for a short period of time (ignored for unix-based)
  */
-SysMutex::SysMutex(bool createSem, bool critical)
+SysMutex::SysMutex(bool createSem, bool critical) : created(false)
 {
     if (createSem)
     {
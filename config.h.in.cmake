@@ -90,6 +90,9 @@
 /* Define to 1 if you have the 'nsleep' function. */
 #cmakedefine HAVE_NSLEEP
 
+/* Define to 1 if you have the 'pipe2' function. */
+#cmakedefine HAVE_PIPE2
+
 /* Define to 1 if you have pthread_mutex_timedlock function */
 #cmakedefine HAVE_PTHREAD_MUTEX_TIMEDLOCK
 
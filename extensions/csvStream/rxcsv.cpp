@@ -0,0 +1,753 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* Object REXX Support                                             rxcsv.cpp  */
+/* Native CSV record decoding for csvStream.cls                               */
+/*                                                                            */
+/******************************************************************************/
+#include "oorexxapi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define CSV_QUALIFIER  0x01             // character is one of the qualifiers
+#define CSV_DELIMITER  0x02             // character is one of the delimiters
+
+#define CSV_STRIP_NONE 0                // stripOption N, fields are kept as is
+#define CSV_STRIP_SELF 1                // stripping is done here
+#define CSV_STRIP_SEND 2                // stripping is left to String~strip
+
+
+/*************************************************************/
+/* class CsvBuffer                                           */
+/*                                                           */
+/* a growable character buffer for the line, field and raw   */
+/* text of the record being decoded.                         */
+/*************************************************************/
+class CsvBuffer
+{
+  public:
+    CsvBuffer()
+    {
+        size = 256;
+        length = 0;
+        buffer = (char *)malloc(size);
+    }
+
+    ~CsvBuffer()
+    {
+        free(buffer);
+    }
+
+    inline void append(const char *s, size_t n)
+    {
+        if (length + n > size)
+        {
+            grow(n);
+        }
+        memcpy(buffer + length, s, n);
+        length += n;
+    }
+
+    inline void append(char c)
+    {
+        if (length == size)
+        {
+            grow(1);
+        }
+        buffer[length++] = c;
+    }
+
+    inline void clear()
+    {
+        length = 0;
+    }
+
+    // true if the text is equal to '' in a Rexx (non-strict) comparison
+    bool isBlank()
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            if (buffer[i] != ' ' && buffer[i] != '\t')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    char   *buffer;                    // the collected text
+    size_t  length;                    // length of the text
+
+  private:
+    void grow(size_t n)
+    {
+        while (size < length + n)
+        {
+            size *= 2;
+        }
+        buffer = (char *)realloc(buffer, size);
+    }
+
+    size_t  size;                      // size of the buffer
+};
+
+
+/*************************************************************/
+/* class CsvReader                                           */
+/*                                                           */
+/* decodes CSV records from a CsvStream exactly the way the  */
+/* Rexx version of csvLineIn did: lines are read with        */
+/* LINEIN until no literal is open, the delimiter and the    */
+/* qualifier are sets of characters, and data errors are     */
+/* recorded in csvState and lastDataError instead of being   */
+/* raised.                                                   */
+/*************************************************************/
+class CsvReader
+{
+  public:
+    CsvReader(RexxMethodContext *c);
+
+    ~CsvReader()
+    {
+        free(literals);
+    }
+
+    bool moreData();
+    RexxArrayObject readRecord();
+    void putLiterals(RexxObjectPtr literalFields);
+    void setRawText();
+
+  private:
+    void setup(const char *name, const char *&data, size_t &length);
+    bool parseLine();
+    bool endField();
+    void dataError(const char *problem, const char *detail);
+    inline bool matchAt(size_t i, int type);
+    inline char charAt(size_t i);
+
+    RexxMethodContext *context;        // the method context of the CsvStream
+    RexxObjectPtr self;                // the CsvStream
+
+    const char *qualifier;             // the qualifier characters
+    size_t qualifierLength;
+    const char *delimiter;             // the delimiter characters
+    size_t delimiterLength;
+    const char *lineEnd;               // joins the lines of a multiline record
+    size_t lineEndLength;
+    CsvBuffer doubleQualifier;         // a qualifier in literal text
+    unsigned char classes[256];        // CSV_QUALIFIER and CSV_DELIMITER flags
+
+    int stripMode;                     // CSV_STRIP_xxx
+    char stripOption;                  // L, T or B for CSV_STRIP_SELF
+    const char *stripSet;              // the characters to strip
+    size_t stripSetLength;
+    RexxObjectPtr stripOptionObject;   // the arguments for CSV_STRIP_SEND
+    RexxObjectPtr stripCharObject;
+
+    CsvBuffer text;                    // the current line
+    size_t textLength;                 // its length, may include an implied delimiter
+    CsvBuffer field;                   // the text of the current field
+    CsvBuffer value;                   // the decoded value of a field
+    CsvBuffer rawText;                 // all lines of the current record
+    bool inLiteral;                    // inside a qualified literal
+    size_t fieldNo;                    // number of the current field
+    RexxArrayObject fields;            // the fields of the current record
+
+    char *literals;                    // flags for the fields that were literals
+    size_t literalsSize;
+};
+
+
+/*************************************************************/
+/* CsvReader::CsvReader                                      */
+/*                                                           */
+/* pick up the settings of the stream. these are fixed while */
+/* the reader is in use.                                     */
+/*************************************************************/
+CsvReader::CsvReader(RexxMethodContext *c)
+{
+    context = c;
+    self = context->GetSelf();
+    literals = NULL;
+    literalsSize = 0;
+
+    setup("QUALIFIER", qualifier, qualifierLength);
+    setup("DELIMITER", delimiter, delimiterLength);
+    setup("LINEEND", lineEnd, lineEndLength);
+
+    doubleQualifier.append(qualifier, qualifierLength);
+    doubleQualifier.append(qualifier, qualifierLength);
+
+    memset(classes, 0, sizeof(classes));
+    for (size_t i = 0; i < qualifierLength; i++)
+    {
+        classes[(unsigned char)qualifier[i]] |= CSV_QUALIFIER;
+    }
+    for (size_t i = 0; i < delimiterLength; i++)
+    {
+        classes[(unsigned char)delimiter[i]] |= CSV_DELIMITER;
+    }
+
+    // the common strip options are handled here, anything unusual is
+    // passed on to String~strip, which also raises any errors
+    stripOptionObject = context->GetObjectVariable("STRIPOPTION");
+    stripCharObject = context->GetObjectVariable("STRIPCHAR");
+    stripMode = CSV_STRIP_SEND;
+    stripOption = 0;
+    stripSet = NULL;
+    stripSetLength = 0;
+    if (stripOptionObject != NULLOBJECT && context->IsString(stripOptionObject) &&
+        context->StringLength((RexxStringObject)stripOptionObject) > 0)
+    {
+        char option = toupper(*context->StringData((RexxStringObject)stripOptionObject));
+        if (option == 'N')
+        {
+            stripMode = CSV_STRIP_NONE;
+        }
+        else if ((option == 'L' || option == 'T' || option == 'B') &&
+                 stripCharObject != NULLOBJECT && context->IsString(stripCharObject))
+        {
+            stripMode = CSV_STRIP_SELF;
+            stripOption = option;
+            stripSet = context->StringData((RexxStringObject)stripCharObject);
+            stripSetLength = context->StringLength((RexxStringObject)stripCharObject);
+        }
+    }
+}
+
+
+/*************************************************************/
+/* CsvReader::setup                                          */
+/*                                                           */
+/* get the string value of one of the stream's settings.     */
+/*************************************************************/
+void CsvReader::setup(const char *name, const char *&data, size_t &length)
+{
+    RexxObjectPtr setting = context->GetObjectVariable(name);
+    if (setting == NULLOBJECT)
+    {
+        data = "";
+        length = 0;
+        return;
+    }
+    RexxStringObject string = context->ObjectToString(setting);
+    data = context->StringData(string);
+    length = context->StringLength(string);
+}
+
+
+/*************************************************************/
+/* CsvReader::moreData                                       */
+/*                                                           */
+/* check if there is anything left to read.                  */
+/*************************************************************/
+bool CsvReader::moreData()
+{
+    RexxObjectPtr chars = context->SendMessage0(self, "CHARS");
+    if (chars == NULLOBJECT)
+    {
+        return false;
+    }
+    wholenumber_t count = 1;
+    context->ObjectToWholeNumber(chars, &count);
+    context->ReleaseLocalReference(chars);
+    return count != 0;
+}
+
+
+/*************************************************************/
+/* CsvReader::matchAt                                        */
+/*                                                           */
+/* the equivalent of text~matchChar(i, qualifier/delimiter). */
+/*************************************************************/
+inline bool CsvReader::matchAt(size_t i, int type)
+{
+    return i <= text.length && (classes[(unsigned char)text.buffer[i - 1]] & type) != 0;
+}
+
+
+/*************************************************************/
+/* CsvReader::charAt                                         */
+/*                                                           */
+/* the equivalent of text~substr(i, 1).                      */
+/*************************************************************/
+inline char CsvReader::charAt(size_t i)
+{
+    return i <= text.length ? text.buffer[i - 1] : ' ';
+}
+
+
+/*************************************************************/
+/* CsvReader::dataError                                      */
+/*                                                           */
+/* record bad CSV data in csvState and lastDataError.        */
+/*************************************************************/
+void CsvReader::dataError(const char *problem, const char *detail)
+{
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "Bad CSV data field %zu - ", fieldNo);
+
+    CsvBuffer message;
+    message.append(prefix, strlen(prefix));
+    message.append(problem, strlen(problem));
+    message.append(" (", 2);
+    message.append(qualifier, qualifierLength);
+    message.append(')');
+    message.append(detail, strlen(detail));
+
+    RexxStringObject state = context->String("ERROR");
+    context->SetObjectVariable("CSVSTATE", state);
+    context->ReleaseLocalReference(state);
+    RexxStringObject error = context->NewString(message.buffer, message.length);
+    context->SetObjectVariable("LASTDATAERROR", error);
+    context->ReleaseLocalReference(error);
+}
+
+
+/*************************************************************/
+/* CsvReader::readRecord                                     */
+/*                                                           */
+/* read the lines of the next record and return the array of */
+/* its fields, or NULLOBJECT if a condition was raised.      */
+/*************************************************************/
+RexxArrayObject CsvReader::readRecord()
+{
+    rawText.clear();
+    field.clear();
+    inLiteral = false;
+    fieldNo = 1;
+    fields = context->NewArray(0);
+
+    do
+    {
+        RexxObjectPtr line = context->SendMessage0(self, "LINEIN");
+        if (line == NULLOBJECT || context->CheckCondition())
+        {
+            return NULLOBJECT;
+        }
+        RexxStringObject string = context->ObjectToString(line);
+        text.clear();
+        text.append(context->StringData(string), context->StringLength(string));
+        context->ReleaseLocalReference(line);
+
+        bool firstLine = rawText.isBlank();
+
+        // not really a csv file if the first line has neither a
+        // delimiter nor a qualifier
+        if (firstLine)
+        {
+            size_t i = 0;
+            while (i < text.length && classes[(unsigned char)text.buffer[i]] == 0)
+            {
+                i++;
+            }
+            if (i == text.length)
+            {
+                text.append(delimiter, delimiterLength);
+            }
+            rawText.clear();
+            rawText.append(text.buffer, text.length);
+        }
+        else
+        {
+            // this is a multiline field
+            rawText.append(lineEnd, lineEndLength);
+            rawText.append(text.buffer, text.length);
+            field.append(lineEnd, lineEndLength);
+        }
+
+        if (!parseLine())
+        {
+            return NULLOBJECT;
+        }
+    } while (inLiteral && moreData());
+
+    if (context->CheckCondition())
+    {
+        return NULLOBJECT;
+    }
+    return fields;
+}
+
+
+/*************************************************************/
+/* CsvReader::parseLine                                      */
+/*                                                           */
+/* split a line into fields. a field that is still open at   */
+/* the end of the line continues on the next line.           */
+/*************************************************************/
+bool CsvReader::parseLine()
+{
+    textLength = text.length;
+
+    for (size_t i = 1; ; i++)
+    {
+        if (i > textLength)
+        {
+            if (!field.isBlank())
+            {
+                dataError("unmatched qualifier", "");
+            }
+            return true;
+        }
+
+        if (matchAt(i, CSV_QUALIFIER))
+        {
+            inLiteral = !inLiteral;
+            field.append(qualifier, qualifierLength);
+            if ((classes[(unsigned char)field.buffer[0]] & CSV_QUALIFIER) == 0)
+            {
+                dataError("qualifier", " present but is not first character");
+            }
+        }
+        else if ((matchAt(i, CSV_DELIMITER) || text.length == 0 || i == textLength) && !inLiteral)
+        {
+            // end of field
+            if (!matchAt(i, CSV_DELIMITER))
+            {
+                field.append(charAt(i));
+            }
+            if (!endField())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            field.append(charAt(i));
+        }
+
+        // natural end of row, add an implied field separator
+        if (i == textLength && !inLiteral && field.length != 0)
+        {
+            text.append(delimiter, delimiterLength);
+            textLength++;
+        }
+    }
+}
+
+
+/*************************************************************/
+/* CsvReader::endField                                       */
+/*                                                           */
+/* decode the text of a complete field and store it.         */
+/*************************************************************/
+bool CsvReader::endField()
+{
+    const char *data = field.buffer;
+    size_t length = field.length;
+
+    // if the field is encased in qualifiers then strip them
+    if (length > 1 && (classes[(unsigned char)data[0]] & CSV_QUALIFIER) != 0 &&
+        (classes[(unsigned char)data[length - 1]] & CSV_QUALIFIER) != 0)
+    {
+        data++;
+        length -= 2;
+        if (fieldNo > literalsSize)
+        {
+            size_t newSize = literalsSize == 0 ? 64 : literalsSize;
+            while (newSize < fieldNo)
+            {
+                newSize *= 2;
+            }
+            literals = (char *)realloc(literals, newSize);
+            memset(literals + literalsSize, 0, newSize - literalsSize);
+            literalsSize = newSize;
+        }
+        literals[fieldNo - 1] = 1;
+    }
+
+    // an odd number of qualifiers means one is unmatched
+    size_t count = 0;
+    if (qualifierLength > 0)
+    {
+        for (size_t i = 0; i + qualifierLength <= length; )
+        {
+            if (memcmp(data + i, qualifier, qualifierLength) == 0)
+            {
+                count++;
+                i += qualifierLength;
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+    if (count % 2 != 0)
+    {
+        dataError("unmatched qualifier", " found");
+    }
+
+    // qualifiers are represented in text as doubled qualifiers
+    if (count > 0)
+    {
+        value.clear();
+        for (size_t i = 0; i < length; )
+        {
+            if (i + doubleQualifier.length <= length &&
+                memcmp(data + i, doubleQualifier.buffer, doubleQualifier.length) == 0)
+            {
+                value.append(qualifier, qualifierLength);
+                i += doubleQualifier.length;
+            }
+            else
+            {
+                value.append(data[i++]);
+            }
+        }
+        data = value.buffer;
+        length = value.length;
+    }
+
+    // N (for normal or none) means do not strip
+    const char *start = data;
+    if (stripMode == CSV_STRIP_SELF)
+    {
+        if (stripOption != 'T')
+        {
+            while (length > 0 && memchr(stripSet, *start, stripSetLength) != NULL)
+            {
+                start++;
+                length--;
+            }
+        }
+        if (stripOption != 'L')
+        {
+            while (length > 0 && memchr(stripSet, start[length - 1], stripSetLength) != NULL)
+            {
+                length--;
+            }
+        }
+    }
+
+    // the fields are numbered consecutively, so appending them
+    // stores them at fieldNo without creating a local reference
+    if (stripMode == CSV_STRIP_SEND)
+    {
+        RexxObjectPtr result = context->NewString(start, length);
+        RexxObjectPtr stripped = context->SendMessage2(result, "STRIP", stripOptionObject, stripCharObject);
+        context->ReleaseLocalReference(result);
+        if (stripped == NULLOBJECT || context->CheckCondition())
+        {
+            return false;
+        }
+        context->ArrayAppend(fields, stripped);
+        context->ReleaseLocalReference(stripped);
+    }
+    else
+    {
+        context->ArrayAppendString(fields, start, length);
+    }
+    fieldNo++;
+    field.clear();
+    return true;
+}
+
+
+/*************************************************************/
+/* CsvReader::putLiterals                                    */
+/*                                                           */
+/* add the numbers of all fields that were literals in any   */
+/* of the records read so far to a set.                      */
+/*************************************************************/
+void CsvReader::putLiterals(RexxObjectPtr literalFields)
+{
+    for (size_t i = 0; i < literalsSize; i++)
+    {
+        if (literals[i])
+        {
+            RexxObjectPtr number = context->StringSizeToObject(i + 1);
+            context->SendMessage1(literalFields, "PUT", number);
+            context->ReleaseLocalReference(number);
+        }
+    }
+}
+
+
+/*************************************************************/
+/* CsvReader::setRawText                                     */
+/*                                                           */
+/* make the text of the last record the rawText attribute.   */
+/*************************************************************/
+void CsvReader::setRawText()
+{
+    RexxStringObject raw = context->NewString(rawText.buffer, rawText.length);
+    context->SetObjectVariable("RAWTEXT", raw);
+    context->ReleaseLocalReference(raw);
+}
+
+
+/*************************************************************/
+/* CSV_RecordIn                                              */
+/*                                                           */
+/* read the next record and return the array of its fields.  */
+/* the numbers of the literal fields are added to the        */
+/* optional set.                                             */
+/*************************************************************/
+RexxMethod1(RexxObjectPtr,                // Return type
+            CSV_RecordIn,                 // Object_method name
+            OPTIONAL_RexxObjectPtr, literalFields) // receives the literal field numbers
+{
+    CsvReader reader(context);
+
+    RexxArrayObject fields = reader.readRecord();
+    if (fields == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    reader.setRawText();
+    if (literalFields != NULLOBJECT && literalFields != context->Nil())
+    {
+        reader.putLiterals(literalFields);
+    }
+    return fields;
+}
+
+
+/*************************************************************/
+/* CSV_RecordsIn                                             */
+/*                                                           */
+/* read all remaining records. without an array of header   */
+/* names, each record is an array of fields, otherwise it's  */
+/* a directory of the fields by header name.                 */
+/*************************************************************/
+RexxMethod2(RexxObjectPtr,                // Return type
+            CSV_RecordsIn,                // Object_method name
+            OPTIONAL_RexxObjectPtr, headerNames, // the array of header names
+            OPTIONAL_RexxObjectPtr, literalFields) // receives the literal field numbers
+{
+    CsvReader reader(context);
+    RexxArrayObject records = context->NewArray(0);
+    RexxObjectPtr nullString = context->NullString();
+
+    RexxArrayObject names = NULLOBJECT;
+    if (headerNames != NULLOBJECT && context->IsArray(headerNames))
+    {
+        names = (RexxArrayObject)headerNames;
+    }
+    size_t nameCount = names == NULLOBJECT ? 0 : context->ArraySize(names);
+    RexxStringObject *indexes = NULL;
+    if (nameCount > 0)
+    {
+        indexes = (RexxStringObject *)malloc(nameCount * sizeof(RexxStringObject));
+        for (size_t i = 0; i < nameCount; i++)
+        {
+            RexxObjectPtr name = context->ArrayAt(names, i + 1);
+            indexes[i] = context->ObjectToString(name == NULLOBJECT ? nullString : name);
+        }
+    }
+
+    bool ok = true;
+    while (reader.moreData())
+    {
+        RexxArrayObject fields = reader.readRecord();
+        if (fields == NULLOBJECT)
+        {
+            ok = false;
+            break;
+        }
+        if (names == NULLOBJECT)
+        {
+            context->ArrayAppend(records, fields);
+        }
+        else
+        {
+            RexxDirectoryObject record = context->NewDirectory();
+            for (size_t i = 0; i < nameCount; i++)
+            {
+                RexxObjectPtr field = context->ArrayAt(fields, i + 1);
+                if (field == NULLOBJECT)
+                {
+                    field = nullString;
+                }
+                const char *index = context->StringData(indexes[i]);
+                // the directory API can't handle an index with a NUL in it
+                if (memchr(index, '\0', context->StringLength(indexes[i])) == NULL)
+                {
+                    context->DirectoryPut(record, field, index);
+                }
+                else
+                {
+                    context->SendMessage2(record, "PUT", field, indexes[i]);
+                }
+            }
+            context->ArrayAppend(records, record);
+            context->ReleaseLocalReference(record);
+        }
+        context->ReleaseLocalReference(fields);
+    }
+    free(indexes);
+
+    if (!ok || context->CheckCondition())
+    {
+        return NULLOBJECT;
+    }
+    reader.setRawText();
+    if (literalFields != NULLOBJECT && literalFields != context->Nil())
+    {
+        reader.putLiterals(literalFields);
+    }
+    return records;
+}
+
+
+// now build the actual entry list
+RexxMethodEntry rxcsv_methods[] =
+{
+    REXX_METHOD(CSV_RecordIn,  CSV_RecordIn),
+    REXX_METHOD(CSV_RecordsIn, CSV_RecordsIn),
+    REXX_LAST_METHOD()
+};
+
+
+RexxPackageEntry rxcsv_package_entry =
+{
+    STANDARD_PACKAGE_HEADER
+    REXX_INTERPRETER_4_0_0,              // anything after 4.0.0 will work
+    "RXCSV",                             // name of the package
+    "5.0",                               // package information
+    NULL,                                // no load/unload functions
+    NULL,
+    NULL,                                // the exported functions
+    rxcsv_methods                        // the exported methods
+};
+
+// package loading stub.
+OOREXX_GET_PACKAGE(rxcsv);
@@ -0,0 +1,1538 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* Object REXX Support                                            rxjson.cpp  */
+/* Native JSON decoding and encoding for json.cls                             */
+/*                                                                            */
+/******************************************************************************/
+#include "oorexxapi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_BUFFER_SIZE 65536          // chunk size for file input and output
+#define JSON_MAX_DEPTH   1000           // maximum nesting of objects and arrays
+#define JSON_END         -1             // peek() result at the end of the input
+
+#ifdef WIN32
+  #define JSON_EOL "\r\n"
+#else
+  #define JSON_EOL "\n"
+#endif
+
+
+/*************************************************************/
+/* class JsonInput                                           */
+/*                                                           */
+/* the JSON text to decode, either a string in memory or a   */
+/* file that is read in chunks. positions are 1-based and    */
+/* relative to the start of the text after any UTF-8 BOM,    */
+/* just like the positions json.cls used to report.          */
+/*************************************************************/
+class JsonInput
+{
+  public:
+    JsonInput(const char *d, size_t l)
+    {
+        file = NULL;
+        buffer = NULL;
+        text = d;
+        textLength = l;
+        origin = 0;
+        if (l >= 3 && memcmp(d, "\xEF\xBB\xBF", 3) == 0)
+        {
+            origin = 3;
+        }
+        restart();
+    }
+
+    JsonInput(FILE *f)
+    {
+        file = f;
+        buffer = (char *)malloc(JSON_BUFFER_SIZE);
+        text = NULL;
+        textLength = 0;
+        origin = 0;
+        restart();
+        if (available(3) >= 3 && memcmp(current, "\xEF\xBB\xBF", 3) == 0)
+        {
+            origin = 3;
+            current += 3;
+        }
+        base = 0;
+        data = current;
+    }
+
+    ~JsonInput()
+    {
+        free(buffer);
+    }
+
+    inline int peek()
+    {
+        if (current < end || refill())
+        {
+            return (unsigned char)*current;
+        }
+        return JSON_END;
+    }
+
+    inline size_t position()
+    {
+        return base + (current - data) + 1;
+    }
+
+    void restart();
+    size_t available(size_t n);
+    void locate(size_t pos, size_t &line, size_t &column, char *&context, size_t &contextLength);
+
+    const char *data;                  // start of the buffered data
+    const char *current;               // next character
+    const char *end;                   // end of the buffered data
+
+  private:
+    bool refill();
+
+    FILE       *file;                  // file to read, NULL for a string
+    char       *buffer;                // read buffer for a file
+    const char *text;                  // the string data
+    size_t      textLength;            // length of the string data
+    size_t      origin;                // offset of the text (skips a BOM)
+    size_t      base;                  // position of data within the text
+};
+
+
+/*************************************************************/
+/* JsonInput::restart                                        */
+/*                                                           */
+/* go back to the start of the text.                         */
+/*************************************************************/
+void JsonInput::restart()
+{
+    base = 0;
+    if (file == NULL)
+    {
+        data = text + origin;
+        current = data;
+        end = text + textLength;
+    }
+    else
+    {
+        fseek(file, (long)origin, SEEK_SET);
+        data = buffer;
+        current = buffer;
+        end = buffer;
+    }
+}
+
+
+/*************************************************************/
+/* JsonInput::refill                                         */
+/*                                                           */
+/* read the next chunk of a file once the buffered data has  */
+/* been used up. returns false at the end of the input.      */
+/*************************************************************/
+bool JsonInput::refill()
+{
+    if (file == NULL)
+    {
+        return false;
+    }
+    base += end - data;
+    size_t count = fread(buffer, 1, JSON_BUFFER_SIZE, file);
+    data = buffer;
+    current = buffer;
+    end = buffer + count;
+    return count > 0;
+}
+
+
+/*************************************************************/
+/* JsonInput::available                                      */
+/*                                                           */
+/* make sure that up to n characters following the current   */
+/* one are buffered, so that escape sequences can be looked  */
+/* at in one piece. returns the number of characters that    */
+/* are actually available, which is less than n only at the  */
+/* end of the input.                                         */
+/*************************************************************/
+size_t JsonInput::available(size_t n)
+{
+    size_t count = end - current;
+    if (count >= n || file == NULL)
+    {
+        return count;
+    }
+
+    // move the remaining characters to the front and top up the buffer
+    base += current - data;
+    memmove(buffer, current, count);
+    count += fread(buffer + count, 1, JSON_BUFFER_SIZE - count, file);
+    data = buffer;
+    current = buffer;
+    end = buffer + count;
+    return count;
+}
+
+
+/*************************************************************/
+/* JsonInput::locate                                         */
+/*                                                           */
+/* compute the line and column of a position for an error    */
+/* message, and return the line it is in. a CR LF sequence   */
+/* counts as a single line end. the returned context line    */
+/* must be freed by the caller.                              */
+/*************************************************************/
+void JsonInput::locate(size_t pos, size_t &line, size_t &column, char *&context, size_t &contextLength)
+{
+    size_t lineStart = 1;
+
+    line = 1;
+    restart();
+    for (size_t i = 1; i < pos; i++)
+    {
+        int c = peek();
+        if (c == JSON_END)
+        {
+            break;
+        }
+        current++;
+        // the last character of the text doesn't start a new line
+        if (peek() == JSON_END)
+        {
+            break;
+        }
+        if (c == '\n' || c == '\r')
+        {
+            line++;
+            if (c == '\r' && peek() == '\n')
+            {
+                current++;
+                i++;
+            }
+            lineStart = i + 1;
+        }
+    }
+    column = pos - lineStart + 1;
+
+    // now collect the line the position is in
+    restart();
+    for (size_t i = 1; i < lineStart && peek() != JSON_END; i++)
+    {
+        current++;
+    }
+    size_t contextSize = 128;
+    context = (char *)malloc(contextSize);
+    contextLength = 0;
+    for (int c = peek(); c != JSON_END && c != '\n' && c != '\r'; c = peek())
+    {
+        if (contextLength == contextSize)
+        {
+            contextSize *= 2;
+            context = (char *)realloc(context, contextSize);
+        }
+        context[contextLength++] = (char)c;
+        current++;
+    }
+}
+
+
+/*************************************************************/
+/* isJsonNumber                                              */
+/*                                                           */
+/* validate a string against the JSON number grammar of      */
+/* RFC 8259, see the isJsonNumber routine in json.cls.       */
+/*************************************************************/
+static bool isJsonNumber(const char *s, size_t length)
+{
+    const char *end = s + length;
+
+    if (s < end && *s == '-')
+    {
+        s++;
+    }
+    if (s >= end)
+    {
+        return false;
+    }
+    // integer part, no leading zeros
+    if (*s == '0')
+    {
+        s++;
+    }
+    else if (*s >= '1' && *s <= '9')
+    {
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            s++;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    // optional fraction
+    if (s < end && *s == '.')
+    {
+        s++;
+        if (s >= end || *s < '0' || *s > '9')
+        {
+            return false;
+        }
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            s++;
+        }
+    }
+    // optional exponent
+    if (s < end && (*s == 'e' || *s == 'E'))
+    {
+        s++;
+        if (s < end && (*s == '+' || *s == '-'))
+        {
+            s++;
+        }
+        if (s >= end || *s < '0' || *s > '9')
+        {
+            return false;
+        }
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            s++;
+        }
+    }
+    return s == end;
+}
+
+
+/*************************************************************/
+/* hugeExponent                                              */
+/*                                                           */
+/* check if a JSON number has an exponent that's too large   */
+/* for it to be a valid Rexx number.                         */
+/*************************************************************/
+static bool hugeExponent(const char *s, size_t length)
+{
+    const char *exponent = (const char *)memchr(s, 'e', length);
+    if (exponent == NULL)
+    {
+        exponent = (const char *)memchr(s, 'E', length);
+    }
+    return exponent != NULL && s + length - exponent > 8;
+}
+
+
+/*************************************************************/
+/* isHex                                                     */
+/*                                                           */
+/* check if n characters are all hexadecimal digits.         */
+/*************************************************************/
+static bool isHex(const char *s, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = s[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*************************************************************/
+/* maybeRexxNumber                                           */
+/*                                                           */
+/* the quick validation the interpreter does before it       */
+/* converts a string to a number. if this fails, the string  */
+/* is certainly not a number; if it succeeds, it most likely */
+/* is, but only the interpreter can tell for sure.           */
+/*************************************************************/
+static bool maybeRexxNumber(const char *s, size_t length)
+{
+    const char *end = s + length;
+
+    if (length == 0)
+    {
+        return false;
+    }
+    while (s < end && (*s == ' ' || *s == '\t'))
+    {
+        s++;
+    }
+    if (s < end && (*s == '-' || *s == '+'))
+    {
+        s++;
+        while (s < end && (*s == ' ' || *s == '\t'))
+        {
+            s++;
+        }
+    }
+    bool hadPeriod = false;
+    if (s < end && *s == '.')
+    {
+        s++;
+        hadPeriod = true;
+    }
+    while (s < end && *s >= '0' && *s <= '9')
+    {
+        s++;
+    }
+    if (s < end && *s == '.')
+    {
+        if (hadPeriod)
+        {
+            return false;
+        }
+        s++;
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            s++;
+        }
+    }
+    if (s < end && (*s == 'e' || *s == 'E'))
+    {
+        s++;
+        if (s < end && (*s == '-' || *s == '+'))
+        {
+            s++;
+        }
+        if (s >= end || *s < '0' || *s > '9')
+        {
+            return false;
+        }
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            s++;
+        }
+    }
+    while (s < end && (*s == ' ' || *s == '\t'))
+    {
+        s++;
+    }
+    return s == end;
+}
+
+
+/*************************************************************/
+/* class JsonParser                                          */
+/*                                                           */
+/* a recursive descent parser that builds the Rexx objects   */
+/* for a JSON text directly: objects become a .Directory,    */
+/* arrays an .Array, strings a .JsonString, numbers a plain  */
+/* string, booleans the .JsonBoolean singletons and null     */
+/* .nil. the methods return NULLOBJECT if the text is not    */
+/* valid, with the message and position kept for error().    */
+/*************************************************************/
+class JsonParser
+{
+  public:
+    JsonParser(RexxMethodContext *c, JsonInput &i) : context(c), input(i)
+    {
+        text = NULL;
+        textLength = 0;
+        textSize = 0;
+        errorMessage = NULL;
+        errorPosition = 0;
+        jsonStringClass = context->FindContextClass("JSONSTRING");
+        RexxClassObject booleanClass = context->FindContextClass("JSONBOOLEAN");
+        trueObject = context->SendMessage0(booleanClass, "TRUE");
+        falseObject = context->SendMessage0(booleanClass, "FALSE");
+    }
+
+    ~JsonParser()
+    {
+        free(text);
+    }
+
+    RexxObjectPtr parse();
+    void error();
+
+  private:
+    RexxObjectPtr parseValue(size_t depth);
+    RexxObjectPtr parseObject(size_t depth);
+    RexxObjectPtr parseArray(size_t depth);
+    RexxObjectPtr parseString();
+    RexxObjectPtr parseOther();
+    bool readString();
+    void release(RexxObjectPtr value);
+
+    inline void skipWhitespace()
+    {
+        for (;;)
+        {
+            int c = input.peek();
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            {
+                return;
+            }
+            input.current++;
+        }
+    }
+
+    inline void append(const char *s, size_t n)
+    {
+        if (textLength + n > textSize)
+        {
+            textSize = textSize == 0 ? 256 : textSize * 2;
+            if (textSize < textLength + n)
+            {
+                textSize = textLength + n;
+            }
+            text = (char *)realloc(text, textSize);
+        }
+        memcpy(text + textLength, s, n);
+        textLength += n;
+    }
+
+    inline RexxObjectPtr fail(const char *message)
+    {
+        return fail(message, input.position());
+    }
+
+    inline RexxObjectPtr fail(const char *message, size_t pos)
+    {
+        errorMessage = message;
+        errorPosition = pos;
+        return NULLOBJECT;
+    }
+
+    RexxMethodContext *context;        // the method call context
+    JsonInput   &input;                // the JSON text
+    char        *text;                 // collects strings and other values
+    size_t       textLength;           // length of the collected value
+    size_t       textSize;             // size of the text buffer
+    const char  *errorMessage;         // why decoding failed
+    size_t       errorPosition;        // and where
+    RexxClassObject jsonStringClass;   // the .JsonString class
+    RexxObjectPtr trueObject;          // .JsonBoolean~true
+    RexxObjectPtr falseObject;         // .JsonBoolean~false
+};
+
+
+/*************************************************************/
+/* JsonParser::parse                                         */
+/*                                                           */
+/* decode the complete text, which must consist of a single  */
+/* value surrounded by optional whitespace.                  */
+/*************************************************************/
+RexxObjectPtr JsonParser::parse()
+{
+    skipWhitespace();
+    RexxObjectPtr value = parseValue(0);
+    if (value == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    skipWhitespace();
+    if (input.peek() != JSON_END)
+    {
+        return fail("Expected end of input");
+    }
+    return value;
+}
+
+
+/*************************************************************/
+/* JsonParser::error                                         */
+/*                                                           */
+/* raise the syntax error for a failed parse. the additional */
+/* information is a .JsonError, which gives the line, column */
+/* and text of the line where the error was detected. if the */
+/* parse stopped because a message we sent raised a          */
+/* condition, there's no message of ours and that condition  */
+/* is left to propagate instead.                             */
+/*************************************************************/
+void JsonParser::error()
+{
+    size_t line;
+    size_t column;
+    char *contextLine;
+    size_t contextLength;
+
+    if (errorMessage == NULL || context->CheckCondition())
+    {
+        return;
+    }
+
+    input.locate(errorPosition, line, column, contextLine, contextLength);
+
+    RexxArrayObject args = context->NewArray(4);
+    context->ArrayPut(args, context->String(errorMessage), 1);
+    context->ArrayPut(args, context->StringSizeToObject(line), 2);
+    context->ArrayPut(args, context->StringSizeToObject(column), 3);
+    context->ArrayPut(args, context->String(contextLine, contextLength), 4);
+    free(contextLine);
+
+    // like RAISE ... ADDITIONAL with a string, each line of the
+    // description becomes an item of the additional information
+    RexxObjectPtr jsonError = context->SendMessage(context->FindContextClass("JSONERROR"), "NEW", args);
+    if (jsonError != NULLOBJECT)
+    {
+        RexxObjectPtr lines = context->SendMessage0(context->ObjectToString(jsonError), "MAKEARRAY");
+        if (lines != NULLOBJECT)
+        {
+            context->RaiseException(Rexx_Error_Incorrect_method_user_defined, (RexxArrayObject)lines);
+        }
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::release                                       */
+/*                                                           */
+/* drop our local reference to a value once it has been      */
+/* stored in its container, so that decoding a large text    */
+/* doesn't pile up references. the shared objects are left   */
+/* alone.                                                    */
+/*************************************************************/
+void JsonParser::release(RexxObjectPtr value)
+{
+    if (value != trueObject && value != falseObject && value != context->Nil())
+    {
+        context->ReleaseLocalReference(value);
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::parseValue                                    */
+/*                                                           */
+/* decode a value of any type.                               */
+/*************************************************************/
+RexxObjectPtr JsonParser::parseValue(size_t depth)
+{
+    switch (input.peek())
+    {
+        case '{':
+            if (depth >= JSON_MAX_DEPTH)
+            {
+                return fail("Maximum nesting depth exceeded");
+            }
+            input.current++;
+            return parseObject(depth + 1);
+
+        case '[':
+            if (depth >= JSON_MAX_DEPTH)
+            {
+                return fail("Maximum nesting depth exceeded");
+            }
+            input.current++;
+            return parseArray(depth + 1);
+
+        case '"':
+            input.current++;
+            return parseString();
+
+        default:
+            return parseOther();
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::parseObject                                   */
+/*                                                           */
+/* decode the members of an object into a .Directory. the    */
+/* opening brace has already been consumed.                  */
+/*************************************************************/
+RexxObjectPtr JsonParser::parseObject(size_t depth)
+{
+    RexxDirectoryObject directory = context->NewDirectory();
+
+    skipWhitespace();
+    if (input.peek() == '}')
+    {
+        input.current++;
+        return directory;
+    }
+
+    for (;;)
+    {
+        skipWhitespace();
+        if (input.peek() != '"')
+        {
+            return fail("Name must be a quoted string");
+        }
+        input.current++;
+        if (!readString())
+        {
+            return NULLOBJECT;
+        }
+        RexxStringObject name = context->NewString(text, textLength);
+
+        skipWhitespace();
+        if (input.peek() != ':')
+        {
+            return fail("Expected colon separating object name and value");
+        }
+        input.current++;
+        skipWhitespace();
+        RexxObjectPtr value = parseValue(depth);
+        if (value == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+
+        // DirectoryPut() needs a C string, which won't do for names
+        // with an embedded \u0000
+        const char *nameData = context->StringData(name);
+        size_t nameLength = context->StringLength(name);
+        if (memchr(nameData, '\0', nameLength) == NULL)
+        {
+            context->DirectoryPut(directory, value, nameData);
+        }
+        else
+        {
+            context->SendMessage2(directory, "PUT", value, name);
+        }
+        context->ReleaseLocalReference(name);
+        release(value);
+
+        skipWhitespace();
+        int c = input.peek();
+        if (c == '}')
+        {
+            input.current++;
+            return directory;
+        }
+        if (c != ',')
+        {
+            return fail("Expected end of an object or new value");
+        }
+        input.current++;
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::parseArray                                    */
+/*                                                           */
+/* decode the elements of an array into an .Array. the       */
+/* opening bracket has already been consumed.                */
+/*************************************************************/
+RexxObjectPtr JsonParser::parseArray(size_t depth)
+{
+    RexxArrayObject array = context->NewArray(0);
+
+    skipWhitespace();
+    if (input.peek() == ']')
+    {
+        input.current++;
+        return array;
+    }
+
+    for (;;)
+    {
+        skipWhitespace();
+        RexxObjectPtr value = parseValue(depth);
+        if (value == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        context->ArrayAppend(array, value);
+        release(value);
+
+        skipWhitespace();
+        int c = input.peek();
+        if (c == ']')
+        {
+            input.current++;
+            return array;
+        }
+        if (c != ',')
+        {
+            return fail("Expected end of an array or new value");
+        }
+        input.current++;
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::parseString                                   */
+/*                                                           */
+/* decode a quoted string value into a .JsonString.          */
+/*************************************************************/
+RexxObjectPtr JsonParser::parseString()
+{
+    if (!readString())
+    {
+        return NULLOBJECT;
+    }
+    RexxStringObject string = context->NewString(text, textLength);
+    RexxObjectPtr value = context->SendMessage1(jsonStringClass, "NEW", string);
+    context->ReleaseLocalReference(string);
+    return value;
+}
+
+
+/*************************************************************/
+/* JsonParser::readString                                    */
+/*                                                           */
+/* decode the characters of a quoted string into the text    */
+/* buffer. the opening quote has already been consumed.      */
+/* \u00XX escapes are decoded to a single character, other   */
+/* \uXXXX escapes are kept as they are, since Rexx strings   */
+/* have no notion of Unicode.                                */
+/*************************************************************/
+bool JsonParser::readString()
+{
+    textLength = 0;
+    for (;;)
+    {
+        int c = input.peek();
+        if (c == '\\')
+        {
+            size_t count = input.available(6);
+            const char *escape = input.current;
+            char decoded;
+
+            switch (count >= 2 ? escape[1] : 0)
+            {
+                case '"':  decoded = '"';  break;
+                case '\\': decoded = '\\'; break;
+                case '/':  decoded = '/';  break;
+                case 'b':  decoded = '\b'; break;
+                case 'f':  decoded = '\f'; break;
+                case 'n':  decoded = '\n'; break;
+                case 'r':  decoded = '\r'; break;
+                case 't':  decoded = '\t'; break;
+                default:   decoded = 0;    break;
+            }
+
+            if (decoded != 0)
+            {
+                append(&decoded, 1);
+                input.current += 2;
+            }
+            else if (count >= 6 && escape[1] == 'u' && isHex(escape + 2, 4))
+            {
+                if (escape[2] == '0' && escape[3] == '0')
+                {
+                    char hex[3] = { escape[4], escape[5], '\0' };
+                    decoded = (char)strtol(hex, NULL, 16);
+                    append(&decoded, 1);
+                }
+                else
+                {
+                    append(escape, 6);
+                }
+                input.current += 6;
+            }
+            else
+            {
+                fail("Invalid escape sequence");
+                return false;
+            }
+        }
+        else if (c == '"')
+        {
+            input.current++;
+            return true;
+        }
+        // RFC 8259 does not allow raw control characters in strings
+        else if (c == JSON_END || c <= 0x1f)
+        {
+            fail("Unescaped control character in string");
+            return false;
+        }
+        else
+        {
+            // take everything up to the next quote, backslash or control character
+            const char *start = input.current;
+            const char *end = input.end;
+            const char *scan = start;
+            while (scan < end && *scan != '"' && *scan != '\\' && (unsigned char)*scan > 0x1f)
+            {
+                scan++;
+            }
+            append(start, scan - start);
+            input.current = scan;
+        }
+
+        if (input.peek() == JSON_END)
+        {
+            fail("Expected end of a quoted string");
+            return false;
+        }
+    }
+}
+
+
+/*************************************************************/
+/* JsonParser::parseOther                                    */
+/*                                                           */
+/* decode a number, a boolean or null. the value extends up  */
+/* to the next whitespace, closing bracket or comma.         */
+/*************************************************************/
+RexxObjectPtr JsonParser::parseOther()
+{
+    size_t start = input.position();
+
+    textLength = 0;
+    for (;;)
+    {
+        const char *scan = input.current;
+        const char *end = input.end;
+        while (scan < end && *scan != ' ' && *scan != '}' && *scan != ']' && *scan != ',' &&
+               *scan != '\t' && *scan != '\n' && *scan != '\r')
+        {
+            scan++;
+        }
+        append(input.current, scan - input.current);
+        input.current = scan;
+        if (scan < end || input.peek() == JSON_END)
+        {
+            break;
+        }
+    }
+
+    if (isJsonNumber(text, textLength))
+    {
+        return context->NewString(text, textLength);
+    }
+    if (textLength == 5 && memcmp(text, "false", 5) == 0)
+    {
+        return falseObject;
+    }
+    if (textLength == 4 && memcmp(text, "true", 4) == 0)
+    {
+        return trueObject;
+    }
+    if (textLength == 4 && memcmp(text, "null", 4) == 0)
+    {
+        return context->Nil();
+    }
+    return fail("Invalid JSON value", start);
+}
+
+
+/*************************************************************/
+/* class JsonOutput                                          */
+/*                                                           */
+/* collects the encoded JSON text, either in memory or for a */
+/* file, which is written whenever a chunk is complete.      */
+/*************************************************************/
+class JsonOutput
+{
+  public:
+    JsonOutput(FILE *f)
+    {
+        file = f;
+        size = JSON_BUFFER_SIZE;
+        length = 0;
+        buffer = (char *)malloc(size);
+    }
+
+    ~JsonOutput()
+    {
+        free(buffer);
+    }
+
+    inline void append(const char *s, size_t n)
+    {
+        if (length + n > size)
+        {
+            grow(n);
+        }
+        memcpy(buffer + length, s, n);
+        length += n;
+    }
+
+    inline void append(char c)
+    {
+        if (length == size)
+        {
+            grow(1);
+        }
+        buffer[length++] = c;
+    }
+
+    void flush()
+    {
+        if (file != NULL && length > 0)
+        {
+            fwrite(buffer, 1, length, file);
+            length = 0;
+        }
+    }
+
+    char   *buffer;                    // the collected text
+    size_t  length;                    // length of the text
+
+  private:
+    void grow(size_t n)
+    {
+        if (file != NULL)
+        {
+            flush();
+            if (n <= size)
+            {
+                return;
+            }
+        }
+        while (size < length + n)
+        {
+            size *= 2;
+        }
+        buffer = (char *)realloc(buffer, size);
+    }
+
+    FILE   *file;                      // file to write, NULL for a string
+    size_t  size;                      // size of the buffer
+};
+
+
+/*************************************************************/
+/* class JsonEncoder                                         */
+/*                                                           */
+/* encodes an object tree the same way the emitValue methods */
+/* of json.cls did. numeric strings that are not already     */
+/* valid JSON numbers need Rexx arithmetic to be normalized; */
+/* these are handed back to json.cls.                        */
+/*************************************************************/
+class JsonEncoder
+{
+  public:
+    JsonEncoder(RexxMethodContext *c, JsonOutput &o, bool l) : context(c), output(o), legible(l)
+    {
+        stringClass = context->FindContextClass("STRING");
+        jsonStringClass = context->FindContextClass("JSONSTRING");
+        orderedClass = context->FindContextClass("ORDEREDCOLLECTION");
+        mapClass = context->FindContextClass("MAPCOLLECTION");
+        RexxClassObject booleanClass = context->FindContextClass("JSONBOOLEAN");
+        trueObject = context->SendMessage0(booleanClass, "TRUE");
+        falseObject = context->SendMessage0(booleanClass, "FALSE");
+    }
+
+    bool emitValue(RexxObjectPtr value, size_t level);
+
+  private:
+    bool emitString(RexxObjectPtr value);
+    bool emitArray(RexxArrayObject array, size_t level);
+    bool emitObject(RexxObjectPtr collection, size_t level);
+    void emitQuoted(const char *s, size_t length);
+    bool normalize(RexxObjectPtr value);
+    void newLine(size_t level);
+
+    RexxMethodContext *context;        // the method call context
+    JsonOutput  &output;               // where the text goes
+    bool         legible;              // add whitespace for human readers
+    RexxClassObject stringClass;       // .String
+    RexxClassObject jsonStringClass;   // .JsonString
+    RexxClassObject orderedClass;      // .OrderedCollection
+    RexxClassObject mapClass;          // .MapCollection
+    RexxObjectPtr trueObject;          // .JsonBoolean~true
+    RexxObjectPtr falseObject;         // .JsonBoolean~false
+};
+
+
+/*************************************************************/
+/* JsonEncoder::emitValue                                    */
+/*                                                           */
+/* encode any object, dispatching on its type. returns false */
+/* if a message sent to the object raised a condition.       */
+/*************************************************************/
+bool JsonEncoder::emitValue(RexxObjectPtr value, size_t level)
+{
+    // a collection that contains itself would recurse forever
+    if (level > JSON_MAX_DEPTH)
+    {
+        context->RaiseException0(Rexx_Error_Control_stack_full);
+        return false;
+    }
+    if (context->IsString(value) || context->IsInstanceOf(value, stringClass))
+    {
+        return emitString(value);
+    }
+    if (context->IsInstanceOf(value, orderedClass))
+    {
+        if (context->IsArray(value))
+        {
+            return emitArray((RexxArrayObject)value, level);
+        }
+        RexxObjectPtr array = context->SendMessage0(value, "MAKEARRAY");
+        bool ok = array != NULLOBJECT && emitArray((RexxArrayObject)array, level);
+        context->ReleaseLocalReference(array);
+        return ok;
+    }
+    if (context->IsInstanceOf(value, mapClass))
+    {
+        return emitObject(value, level);
+    }
+    if (value == context->Nil())
+    {
+        output.append("null", 4);
+        return true;
+    }
+    // the .JsonBoolean singletons are common enough to skip makeJSON
+    if (value == trueObject)
+    {
+        output.append("true", 4);
+        return true;
+    }
+    if (value == falseObject)
+    {
+        output.append("false", 5);
+        return true;
+    }
+
+    RexxObjectPtr result;
+    if (context->HasMethod(value, "MAKEJSON"))
+    {
+        // the object renders itself, which covers .JsonBoolean
+        result = context->SendMessage0(value, "MAKEJSON");
+        if (result != NULLOBJECT)
+        {
+            RexxStringObject string = context->ObjectToString(result);
+            output.append(context->StringData(string), context->StringLength(string));
+            context->ReleaseLocalReference(string);
+        }
+    }
+    else if (context->HasMethod(value, "MAKEARRAY"))
+    {
+        result = context->SendMessage0(value, "MAKEARRAY");
+        if (result != NULLOBJECT && !emitValue(result, level))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        result = context->SendMessage0(value, context->HasMethod(value, "MAKESTRING") ? "MAKESTRING" : "STRING");
+        if (result != NULLOBJECT && !emitString(result))
+        {
+            return false;
+        }
+    }
+    if (result == NULLOBJECT)
+    {
+        return false;
+    }
+    context->ReleaseLocalReference(result);
+    return true;
+}
+
+
+/*************************************************************/
+/* JsonEncoder::emitString                                   */
+/*                                                           */
+/* encode a string. anything that can't be a Rexx number is */
+/* quoted and escaped, valid JSON numbers are written as     */
+/* they are (quoted for a .JsonString), and the rest goes to */
+/* string2json, which knows how Rexx would format it.        */
+/*************************************************************/
+bool JsonEncoder::emitString(RexxObjectPtr value)
+{
+    // numbers and subclass instances need to be converted to get at the data
+    RexxStringObject string = (RexxStringObject)value;
+    bool jsonString = false;
+    if (!context->IsString(value))
+    {
+        string = context->ObjectToString(value);
+        jsonString = context->IsInstanceOf(value, jsonStringClass) != 0;
+    }
+    const char *data = context->StringData(string);
+    size_t length = context->StringLength(string);
+
+    bool ok = true;
+    if (!maybeRexxNumber(data, length))
+    {
+        emitQuoted(data, length);
+    }
+    // a numeric .JsonString is quoted as is, which gives the same result as
+    // escaping it unless there's a tab in it
+    else if (jsonString && memchr(data, '\t', length) == NULL)
+    {
+        output.append('"');
+        output.append(data, length);
+        output.append('"');
+    }
+    else if (isJsonNumber(data, length) && !hugeExponent(data, length))
+    {
+        output.append(data, length);
+    }
+    else
+    {
+        ok = normalize(value);
+    }
+
+    if (string != value)
+    {
+        context->ReleaseLocalReference(string);
+    }
+    return ok;
+}
+
+
+/*************************************************************/
+/* JsonEncoder::normalize                                    */
+/*                                                           */
+/* encode a string through the emitJSONstring method, which  */
+/* uses the string2json routine.                             */
+/*************************************************************/
+bool JsonEncoder::normalize(RexxObjectPtr value)
+{
+    RexxObjectPtr result = context->SendMessage1(context->GetSelf(), "EMITJSONSTRING", value);
+    if (result == NULLOBJECT)
+    {
+        return false;
+    }
+    RexxStringObject string = context->ObjectToString(result);
+    output.append(context->StringData(string), context->StringLength(string));
+    context->ReleaseLocalReference(result);
+    return true;
+}
+
+
+/*************************************************************/
+/* JsonEncoder::emitQuoted                                   */
+/*                                                           */
+/* write a string as a quoted JSON string. a \uXXXX sequence */
+/* already in the string is passed through unchanged.        */
+/*************************************************************/
+void JsonEncoder::emitQuoted(const char *s, size_t length)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    output.append('"');
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)s[i];
+        switch (c)
+        {
+            case '"':  output.append("\\\"", 2); break;
+            case '\\':
+                if (i + 5 < length && s[i + 1] == 'u' && isHex(s + i + 2, 4))
+                {
+                    output.append(s + i, 6);
+                    i += 5;
+                }
+                else
+                {
+                    output.append("\\\\", 2);
+                }
+                break;
+            case '/':  output.append("\\/", 2); break;
+            case '\b': output.append("\\b", 2); break;
+            case '\t': output.append("\\t", 2); break;
+            case '\n': output.append("\\n", 2); break;
+            case '\f': output.append("\\f", 2); break;
+            case '\r': output.append("\\r", 2); break;
+            default:
+                if (c <= 0x1f)
+                {
+                    char escape[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0x0f] };
+                    output.append(escape, 6);
+                }
+                else
+                {
+                    output.append((char)c);
+                }
+                break;
+        }
+    }
+    output.append('"');
+}
+
+
+/*************************************************************/
+/* JsonEncoder::newLine                                      */
+/*                                                           */
+/* start a new, indented line in legible mode.               */
+/*************************************************************/
+void JsonEncoder::newLine(size_t level)
+{
+    if (legible)
+    {
+        output.append(JSON_EOL, sizeof(JSON_EOL) - 1);
+        for (size_t i = 0; i < level; i++)
+        {
+            output.append("   ", 3);
+        }
+    }
+}
+
+
+/*************************************************************/
+/* JsonEncoder::emitArray                                    */
+/*                                                           */
+/* encode the items of an array as a JSON array.            */
+/*************************************************************/
+bool JsonEncoder::emitArray(RexxArrayObject array, size_t level)
+{
+    size_t size = context->ArraySize(array);
+    size_t items = context->ArrayItems(array);
+
+    output.append('[');
+    if (items == 0)
+    {
+        output.append(']');
+        return true;
+    }
+
+    newLine(level + 1);
+    size_t count = 0;
+    for (size_t i = 1; i <= size; i++)
+    {
+        RexxObjectPtr item = context->ArrayAt(array, i);
+        if (item == NULLOBJECT)
+        {
+            continue;
+        }
+        if (!emitValue(item, level + 1))
+        {
+            return false;
+        }
+        context->ReleaseLocalReference(item);
+        if (++count < items)
+        {
+            output.append(',');
+            newLine(level + 1);
+        }
+    }
+    newLine(level);
+    output.append(']');
+    return true;
+}
+
+
+/*************************************************************/
+/* JsonEncoder::emitObject                                   */
+/*                                                           */
+/* encode a MapCollection as a JSON object. the names are    */
+/* sorted for a reproducible result and always quoted.       */
+/*************************************************************/
+bool JsonEncoder::emitObject(RexxObjectPtr collection, size_t level)
+{
+    RexxObjectPtr indexes = context->SendMessage0(collection, "ALLINDEXES");
+    if (indexes == NULLOBJECT || context->SendMessage0(indexes, "SORT") == NULLOBJECT)
+    {
+        return false;
+    }
+    RexxArrayObject names = (RexxArrayObject)indexes;
+    size_t items = context->ArrayItems(names);
+
+    output.append('{');
+    if (items == 0)
+    {
+        output.append('}');
+        return true;
+    }
+
+    newLine(level + 1);
+    for (size_t i = 1; i <= items; i++)
+    {
+        RexxObjectPtr index = context->ArrayAt(names, i);
+        RexxStringObject name = context->ObjectToString(index);
+        emitQuoted(context->StringData(name), context->StringLength(name));
+        output.append(':');
+        if (legible)
+        {
+            output.append(' ');
+        }
+
+        RexxObjectPtr value = context->SendMessage1(collection, "[]", index);
+        if (value == NULLOBJECT || !emitValue(value, level + 1))
+        {
+            return false;
+        }
+        context->ReleaseLocalReference(value);
+        context->ReleaseLocalReference(name);
+        context->ReleaseLocalReference(index);
+        if (i < items)
+        {
+            output.append(',');
+            newLine(level + 1);
+        }
+    }
+    newLine(level);
+    output.append('}');
+    context->ReleaseLocalReference(indexes);
+    return true;
+}
+
+
+/*************************************************************/
+/* fileError                                                 */
+/*                                                           */
+/* raise the error for a file that can't be opened.          */
+/*************************************************************/
+static void fileError(RexxMethodContext *context, const char *message, const char *fileName)
+{
+    size_t length = strlen(message) + strlen(fileName) + 2;
+    char *text = (char *)malloc(length);
+    snprintf(text, length, "%s %s", message, fileName);
+    context->RaiseException1(Rexx_Error_Incorrect_method_user_defined, context->String(text));
+    free(text);
+}
+
+
+/*************************************************************/
+/* JSON_ParseText                                            */
+/*                                                           */
+/* decode a JSON text held in a string.                      */
+/*************************************************************/
+RexxMethod1(RexxObjectPtr,                // Return type
+            JSON_ParseText,               // Object_method name
+            RexxStringObject, jsonText)   // the JSON text
+{
+    JsonInput input(context->StringData(jsonText), context->StringLength(jsonText));
+    JsonParser parser(context, input);
+
+    RexxObjectPtr result = parser.parse();
+    if (result == NULLOBJECT)
+    {
+        parser.error();
+    }
+    return result;
+}
+
+
+/*************************************************************/
+/* JSON_ParseFile                                            */
+/*                                                           */
+/* decode a JSON file, which is read in chunks rather than   */
+/* as a single string.                                       */
+/*************************************************************/
+RexxMethod1(RexxObjectPtr,                // Return type
+            JSON_ParseFile,               // Object_method name
+            CSTRING, fileName)            // the file to read
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        fileError(context, "Cannot open file:", fileName);
+        return NULLOBJECT;
+    }
+
+    RexxObjectPtr result;
+    {
+        JsonInput input(file);
+        JsonParser parser(context, input);
+
+        result = parser.parse();
+        if (result == NULLOBJECT)
+        {
+            parser.error();
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+
+/*************************************************************/
+/* JSON_EmitText                                             */
+/*                                                           */
+/* encode an object as a JSON text.                          */
+/*************************************************************/
+RexxMethod2(RexxObjectPtr,                // Return type
+            JSON_EmitText,                // Object_method name
+            RexxObjectPtr, rexxObject,    // the object to encode
+            logical_t, legible)           // add whitespace for human readers
+{
+    JsonOutput output(NULL);
+    JsonEncoder encoder(context, output, legible != 0);
+
+    if (!encoder.emitValue(rexxObject, 0))
+    {
+        return NULLOBJECT;
+    }
+    return context->NewString(output.buffer, output.length);
+}
+
+
+/*************************************************************/
+/* JSON_EmitFile                                             */
+/*                                                           */
+/* encode an object as a JSON text and write it to a file,   */
+/* replacing any previous content.                           */
+/*************************************************************/
+RexxMethod3(int,                          // Return type
+            JSON_EmitFile,                // Object_method name
+            CSTRING, fileName,            // the file to write
+            RexxObjectPtr, rexxObject,    // the object to encode
+            logical_t, legible)           // add whitespace for human readers
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL)
+    {
+        fileError(context, "Cannot open file for writing:", fileName);
+        return 0;
+    }
+
+    bool ok;
+    {
+        JsonOutput output(file);
+        JsonEncoder encoder(context, output, legible != 0);
+
+        ok = encoder.emitValue(rexxObject, 0);
+        output.flush();
+    }
+    fclose(file);
+    return ok ? 0 : 1;
+}
+
+
+// now build the actual entry list
+RexxMethodEntry rxjson_methods[] =
+{
+    REXX_METHOD(JSON_ParseText, JSON_ParseText),
+    REXX_METHOD(JSON_ParseFile, JSON_ParseFile),
+    REXX_METHOD(JSON_EmitText,  JSON_EmitText),
+    REXX_METHOD(JSON_EmitFile,  JSON_EmitFile),
+    REXX_LAST_METHOD()
+};
+
+
+RexxPackageEntry rxjson_package_entry =
+{
+    STANDARD_PACKAGE_HEADER
+    REXX_INTERPRETER_4_0_0,              // anything after 4.0.0 will work
+    "RXJSON",                            // name of the package
+    "5.0",                               // package information
+    NULL,                                // no load/unload functions
+    NULL,
+    NULL,                                // the exported functions
+    rxjson_methods                       // the exported methods
+};
+
+// package loading stub.
+OOREXX_GET_PACKAGE(rxjson);
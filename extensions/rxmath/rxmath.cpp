@@ -63,6 +63,14 @@
 *       RxCalcArcSin           -- ArcSine function                    *
 *       RxCalcArcCos           -- ArcCosine function                  *
 *       RxCalcArcTan           -- ArcTangent function                 *
+*       RxCalcArray            -- Apply a function to an array        *
+*       RxCalcPowerArray       -- Raise an array of numbers to a power*
+*       RxCalcSum              -- Sum of an array of numbers          *
+*       RxCalcMean             -- Arithmetic mean of an array         *
+*       RxCalcVariance         -- Variance of an array of numbers     *
+*       RxCalcMin              -- Smallest number in an array         *
+*       RxCalcMax              -- Largest number in an array          *
+*       RxCalcPercentile       -- Percentile of an array of numbers   *
 *                                                                     *
 **********************************************************************/
 
@@ -70,7 +78,7 @@
  * program defines
  *------------------------------------------------------------------*/
 #define PROG_DESC "REXX mathematical function library"
-#define PROG_VERS "1.2"
+#define PROG_VERS "1.3"
 #define PROG_COPY "Copyright (c) 2005-2021 Rexx Language Association."
 #define PROG_ALRR "All rights reserved."
 
@@ -82,6 +90,8 @@
 #include <string.h>
 #include <ctype.h>
 #include <math.h>
+#include <vector>
+#include <algorithm>
 
 /*------------------------------------------------------------------
  * rexx includes
@@ -139,6 +149,8 @@ public:
         return context->DoubleToObjectWithPrecision(x, precision);
     }
 
+    bool hadError() { return optionError; }
+
 protected:
     wholenumber_t precision;
     RexxCallContext *context;
@@ -150,7 +162,7 @@ class TrigFormatter : public NumericFormatter
 {
 public:
 
-    TrigFormatter(RexxCallContext *c, bool explicitPrecision, wholenumber_t p, const char *u) : NumericFormatter(c, explicitPrecision, p)
+    TrigFormatter(RexxCallContext *c, bool explicitPrecision, wholenumber_t p, const char *u, size_t unitsPosition = 3) : NumericFormatter(c, explicitPrecision, p)
     {
         units = DEGREES;
         // process any units option
@@ -176,7 +188,7 @@ public:
                 default:
                     context->RaiseException(Rexx_Error_Invalid_argument_list,
                       context->ArrayOfThree(
-                        context->WholeNumberToObject(3),
+                        context->WholeNumberToObject(unitsPosition),
                         context->String("D, R, or G"),
                         context->String(u)));
                     optionError = true;
@@ -192,6 +204,12 @@ public:
             return NULLOBJECT;
         }
 
+        // now format based on precision setting
+        return format(compute(angle, function));
+    }
+
+    double compute(double angle, int function)
+    {
         double    nsi;                       /* convertion factor          */
         double    nco;                       /* convertion factor          */
         double    result;                    /* result                     */
@@ -288,9 +306,7 @@ public:
                 result = nsi * nco / tan(angle); /* real result            */
                 break;
         }
-
-        // now format based on precision setting
-        return format(result);
+        return result;
     }
 
     RexxObjectPtr evaluateArc(double x, int function)
@@ -301,6 +317,20 @@ public:
             return NULLOBJECT;
         }
 
+        // now format based on precision setting
+        return format(computeArc(x, function));
+    }
+
+    double computeArc(double x, int function)
+    {
+        // on SunOS/Solaris/OpenIndiana asin(2) and acos(2) return 0, not nan
+        // https://docs.oracle.com/cd/E36784_01/html/E36877/matherr-3m.html
+        // we manually check here for a valid domain
+        if (function != ARCTANGENT && (x < -1.0 || x > 1.0))
+        {
+            return nan("");
+        }
+
         double    angle;                     /* working angle              */
         double    nsi;                       /* convertion factor          */
         double    nco;                       /* convertion factor          */
@@ -328,8 +358,7 @@ public:
         {
             angle = angle * 200. / pi;       /* convert to base 400        */
         }
-        // now format based on precision setting
-        return format(angle);
+        return angle;
     }
 
 protected:
@@ -344,6 +373,95 @@ protected:
 };
 
 
+// on SunOS/Solaris/OpenIndiana log(-1) and log10(-1) return -infinity, not
+// nan, so we manually check here for a valid domain
+inline double calcLog(double x)
+{
+    return x < 0.0 ? nan("") : log(x);
+}
+
+inline double calcLog10(double x)
+{
+    return x < 0.0 ? nan("") : log10(x);
+}
+
+
+/**
+ * The array routines convert all of the values to doubles in a single pass
+ * into a contiguous buffer, do their arithmetic over that buffer, and only
+ * convert back to Rexx objects for the final results.  Empty slots of a
+ * sparse array are skipped, and element-wise results are stored at the
+ * same index as their source value.
+ */
+class NumberArray
+{
+public:
+    NumberArray(RexxCallContext *c, RexxArrayObject a)
+    {
+        context = c;
+        array = a;
+        size = context->ArraySize(array);
+        valid = true;
+
+        values.reserve(size);
+        indexes.reserve(size);
+
+        for (size_t i = 1; i <= size; i++)
+        {
+            RexxObjectPtr item = context->ArrayAt(array, i);
+            if (item == NULLOBJECT)
+            {
+                continue;
+            }
+            double x;
+            if (!context->ObjectToDouble(item, &x))
+            {
+                char name[32];
+                snprintf(name, sizeof(name), "values[%zu]", i);
+                context->RaiseException2(Rexx_Error_Invalid_argument_number, context->String(name), item);
+                valid = false;
+                return;
+            }
+            values.push_back(x);
+            indexes.push_back(i);
+            // the array keeps this alive, and a local reference for every
+            // item would grow the activation's save table to the array size
+            context->ReleaseLocalReference(item);
+        }
+    }
+
+    // create an array matching the source with the formatted results.  A
+    // value that can't be formatted leaves its error to the caller
+    RexxArrayObject results(NumericFormatter &formatter)
+    {
+        RexxArrayObject result = context->NewArray(size);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            RexxObjectPtr value = formatter.format(values[i]);
+            if (formatter.hadError() || value == NULLOBJECT)
+            {
+                return NULLOBJECT;
+            }
+            context->ArrayPut(result, value, indexes[i]);
+            // now anchored by the result array
+            context->ReleaseLocalReference(value);
+        }
+        return result;
+    }
+
+    bool isValid() { return valid; }
+    size_t count() { return values.size(); }
+
+    std::vector<double> values;        // the converted values
+    std::vector<size_t> indexes;       // the array index each value came from
+
+protected:
+    RexxCallContext *context;
+    RexxArrayObject array;
+    size_t size;
+    bool valid;
+};
+
 /*
 We no longer use matherr()
 We can't on Windows (https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/matherr)
@@ -428,28 +546,16 @@ RexxRoutine2(RexxObjectPtr, RxCalcLog, double, x, OPTIONAL_positive_wholenumber_
 {
     NumericFormatter formatter(context, argumentExists(2), precision);
 
-    // on SunOS/Solaris/OpenIndiana log(-1) returns -infinity, not nan
-    // we manually check here for a valid domain
-    if (x < 0.0)
-    {
-        return formatter.format(nan(""));
-    }
     // calculate and return
-    return formatter.format(log(x));
+    return formatter.format(calcLog(x));
 }
 
 RexxRoutine2(RexxObjectPtr, RxCalcLog10, double, x, OPTIONAL_positive_wholenumber_t, precision)
 {
     NumericFormatter formatter(context, argumentExists(2), precision);
 
-    // on SunOS/Solaris/OpenIndiana log10(-1) returns -infinity, not nan
-    // we manually check here for a valid domain
-    if (x < 0.0)
-    {
-        return formatter.format(nan(""));
-    }
     // calculate and return
-    return formatter.format(log10(x));
+    return formatter.format(calcLog10(x));
 }
 
 
@@ -577,14 +683,6 @@ RexxRoutine1(RexxObjectPtr, RxCalcPi, OPTIONAL_positive_wholenumber_t, precision
 RexxRoutine3(RexxObjectPtr, RxCalcArcSin, double, x, OPTIONAL_positive_wholenumber_t, precision, OPTIONAL_CSTRING, units)
 {
     TrigFormatter formatter(context, argumentExists(2), precision, units);
-
-    // on SunOS/Solaris/OpenIndiana asin(2) returns 0, not nan
-    // https://docs.oracle.com/cd/E36784_01/html/E36877/matherr-3m.html
-    // we manually check here for a valid domain
-    if (x < -1.0 || x > 1.0)
-    {
-        return formatter.format(nan(""));
-    }
     // calculate and return
     return formatter.evaluateArc(x, ARCSINE);
 }
@@ -593,14 +691,6 @@ RexxRoutine3(RexxObjectPtr, RxCalcArcSin, double, x, OPTIONAL_positive_wholenumb
 RexxRoutine3(RexxObjectPtr, RxCalcArcCos, double, x, OPTIONAL_positive_wholenumber_t, precision, OPTIONAL_CSTRING, units)
 {
     TrigFormatter formatter(context, argumentExists(2), precision, units);
-
-    // on SunOS/Solaris/OpenIndiana acos(2) returns 0, not nan
-    // https://docs.oracle.com/cd/E36784_01/html/E36877/matherr-3m.html
-    // we manually check here for a valid domain
-    if (x < -1.0 || x > 1.0)
-    {
-        return formatter.format(nan(""));
-    }
     // calculate and return
     return formatter.evaluateArc(x, ARCCOSINE);
 }
@@ -613,6 +703,324 @@ RexxRoutine3(RexxObjectPtr, RxCalcArcTan, double, x, OPTIONAL_positive_wholenumb
     return formatter.evaluateArc(x, ARCTANGENT);
 }
 
+/********************************************************************/
+/* Functions:           RxCalcArray(), RxCalcPowerArray()           */
+/* Description:         Applies a function to an array of numbers.  */
+/* Input:               Function name and an array of numbers.      */
+/* Output:              An array of the function values, at the     */
+/*                      same indexes as the input values.           */
+/* Notes:                                                           */
+/*   The function is one of SQRT, EXP, LOG, LOG10, SINH, COSH,      */
+/*   TANH, SIN, COS, TAN, COTAN, ARCSIN, ARCCOS or ARCTAN, and the  */
+/*   units apply to the trigonometric functions only.               */
+/*   The form of the call is:                                       */
+/*   a = RxCalcArray(function, values <, prec> <, [R | D | G]>)     */
+/*   a = RxCalcPowerArray(values, y <, prec>)                       */
+/*                                                                  */
+/********************************************************************/
+
+// apply a function to every value in place.  This is a plain loop over
+// contiguous doubles, so the compiler can vectorize it where the function allows.
+template <typename Function> inline void applyAll(std::vector<double> &values, Function f)
+{
+    size_t count = values.size();
+    double *x = values.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        x[i] = f(x[i]);
+    }
+}
+
+typedef enum
+{
+    CALC_SQRT, CALC_EXP, CALC_LOG, CALC_LOG10, CALC_SINH, CALC_COSH, CALC_TANH,
+    CALC_SIN, CALC_COS, CALC_TAN, CALC_COTAN, CALC_ARCSIN, CALC_ARCCOS, CALC_ARCTAN
+} ArrayFunction;
+
+static const struct
+{
+    const char   *name;
+    ArrayFunction function;
+} arrayFunctions[] =
+{
+    {"SQRT", CALC_SQRT}, {"EXP", CALC_EXP}, {"LOG", CALC_LOG}, {"LOG10", CALC_LOG10},
+    {"SINH", CALC_SINH}, {"COSH", CALC_COSH}, {"TANH", CALC_TANH},
+    {"SIN", CALC_SIN}, {"COS", CALC_COS}, {"TAN", CALC_TAN}, {"COTAN", CALC_COTAN},
+    {"ARCSIN", CALC_ARCSIN}, {"ARCCOS", CALC_ARCCOS}, {"ARCTAN", CALC_ARCTAN},
+};
+
+// caseless lookup of a function name, returns false if not found
+static bool findArrayFunction(const char *name, ArrayFunction &function)
+{
+    for (size_t i = 0; i < sizeof(arrayFunctions) / sizeof(arrayFunctions[0]); i++)
+    {
+        const char *candidate = arrayFunctions[i].name;
+        const char *n = name;
+        while (*candidate != '\0' && toupper((unsigned char)*n) == *candidate)
+        {
+            candidate++;
+            n++;
+        }
+        if (*candidate == '\0' && *n == '\0')
+        {
+            function = arrayFunctions[i].function;
+            return true;
+        }
+    }
+    return false;
+}
+
+RexxRoutine4(RexxObjectPtr, RxCalcArray, CSTRING, name, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision, OPTIONAL_CSTRING, units)
+{
+    ArrayFunction function;
+    if (!findArrayFunction(name, function))
+    {
+        context->RaiseException(Rexx_Error_Invalid_argument_list,
+          context->ArrayOfThree(
+            context->WholeNumberToObject(1),
+            context->String("SQRT, EXP, LOG, LOG10, SINH, COSH, TANH, SIN, COS, TAN, COTAN, ARCSIN, ARCCOS, or ARCTAN"),
+            context->String(name)));
+        return NULLOBJECT;
+    }
+
+    TrigFormatter formatter(context, argumentExists(3), precision, units, 4);
+    NumberArray numbers(context, values);
+    if (formatter.hadError() || !numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+
+    std::vector<double> &x = numbers.values;
+    switch (function)
+    {
+        case CALC_SQRT:   applyAll(x, [](double v) { return sqrt(v); }); break;
+        case CALC_EXP:    applyAll(x, [](double v) { return exp(v); }); break;
+        case CALC_LOG:    applyAll(x, [](double v) { return calcLog(v); }); break;
+        case CALC_LOG10:  applyAll(x, [](double v) { return calcLog10(v); }); break;
+        case CALC_SINH:   applyAll(x, [](double v) { return sinh(v); }); break;
+        case CALC_COSH:   applyAll(x, [](double v) { return cosh(v); }); break;
+        case CALC_TANH:   applyAll(x, [](double v) { return tanh(v); }); break;
+        case CALC_SIN:    applyAll(x, [&formatter](double v) { return formatter.compute(v, SINE); }); break;
+        case CALC_COS:    applyAll(x, [&formatter](double v) { return formatter.compute(v, COSINE); }); break;
+        case CALC_TAN:    applyAll(x, [&formatter](double v) { return formatter.compute(v, TANGENT); }); break;
+        case CALC_COTAN:  applyAll(x, [&formatter](double v) { return formatter.compute(v, COTANGENT); }); break;
+        case CALC_ARCSIN: applyAll(x, [&formatter](double v) { return formatter.computeArc(v, ARCSINE); }); break;
+        case CALC_ARCCOS: applyAll(x, [&formatter](double v) { return formatter.computeArc(v, ARCCOSINE); }); break;
+        case CALC_ARCTAN: applyAll(x, [&formatter](double v) { return formatter.computeArc(v, ARCTANGENT); }); break;
+    }
+    return numbers.results(formatter);
+}
+
+/*==================================================================*/
+RexxRoutine3(RexxObjectPtr, RxCalcPowerArray, RexxArrayObject, values, double, y, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(3), precision);
+    NumberArray numbers(context, values);
+    if (formatter.hadError() || !numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+
+    applyAll(numbers.values, [y](double v) { return pow(v, y); });
+    return numbers.results(formatter);
+}
+
+/********************************************************************/
+/* Functions:           RxCalcSum(), RxCalcMean(), RxCalcVariance(),*/
+/*                      RxCalcMin(), RxCalcMax(), RxCalcPercentile()*/
+/* Description:         Statistics over an array of numbers.        */
+/* Input:               An array of numbers.                        */
+/* Output:              The statistic.  Anything undefined for the  */
+/*                      given number of values (e.g., the mean of   */
+/*                      an empty array) returns nan.  So do MIN,    */
+/*                      MAX and PERCENTILE if any value is nan.     */
+/* Notes:                                                           */
+/*   RxCalcVariance returns the sample variance by default, or the  */
+/*   population variance with the P option.  RxCalcPercentile       */
+/*   interpolates linearly between the closest ranks.               */
+/*   The form of the call is:                                       */
+/*   s = func_name(values <, prec>)                                 */
+/*   v = RxCalcVariance(values <, prec> <, [S | P]>)                */
+/*   p = RxCalcPercentile(values, percent <, prec>)                 */
+/*                                                                  */
+/********************************************************************/
+
+// plain running sum over a contiguous buffer
+inline double sumValues(const std::vector<double> &values)
+{
+    double sum = 0.0;
+    size_t count = values.size();
+    const double *x = values.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        sum += x[i];
+    }
+    return sum;
+}
+
+// a nan has no place in an ordering, so the order statistics are nan too
+inline bool hasNan(const std::vector<double> &values)
+{
+    return std::any_of(values.begin(), values.end(), [](double v) { return std::isnan(v); });
+}
+
+RexxRoutine2(RexxObjectPtr, RxCalcSum, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(2), precision);
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+    return formatter.format(sumValues(numbers.values));
+}
+
+/*==================================================================*/
+RexxRoutine2(RexxObjectPtr, RxCalcMean, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(2), precision);
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+    if (numbers.count() == 0)
+    {
+        return formatter.format(nan(""));
+    }
+    return formatter.format(sumValues(numbers.values) / numbers.count());
+}
+
+/*==================================================================*/
+RexxRoutine3(RexxObjectPtr, RxCalcVariance, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision, OPTIONAL_CSTRING, option)
+{
+    NumericFormatter formatter(context, argumentExists(2), precision);
+
+    bool population = false;
+    if (option != NULL)
+    {
+        switch (*option)
+        {
+            case 'S':
+            case 's':
+                population = false;
+                break;
+
+            case 'P':
+            case 'p':
+                population = true;
+                break;
+
+            default:
+                context->RaiseException(Rexx_Error_Invalid_argument_list,
+                  context->ArrayOfThree(
+                    context->WholeNumberToObject(3),
+                    context->String("S or P"),
+                    context->String(option)));
+                return NULLOBJECT;
+        }
+    }
+
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+
+    size_t count = numbers.count();
+    size_t divisor = population ? count : count - 1;
+    if (count == 0 || divisor == 0)
+    {
+        return formatter.format(nan(""));
+    }
+
+    // two passes over the buffer are cheap and much better behaved
+    // numerically than accumulating the sum of squares
+    double mean = sumValues(numbers.values) / count;
+    const double *x = numbers.values.data();
+    double squares = 0.0;
+    for (size_t i = 0; i < count; i++)
+    {
+        double delta = x[i] - mean;
+        squares += delta * delta;
+    }
+    return formatter.format(squares / divisor);
+}
+
+/*==================================================================*/
+RexxRoutine2(RexxObjectPtr, RxCalcMin, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(2), precision);
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+    if (numbers.count() == 0 || hasNan(numbers.values))
+    {
+        return formatter.format(nan(""));
+    }
+    return formatter.format(*std::min_element(numbers.values.begin(), numbers.values.end()));
+}
+
+/*==================================================================*/
+RexxRoutine2(RexxObjectPtr, RxCalcMax, RexxArrayObject, values, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(2), precision);
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+    if (numbers.count() == 0 || hasNan(numbers.values))
+    {
+        return formatter.format(nan(""));
+    }
+    return formatter.format(*std::max_element(numbers.values.begin(), numbers.values.end()));
+}
+
+/*==================================================================*/
+RexxRoutine3(RexxObjectPtr, RxCalcPercentile, RexxArrayObject, values, double, percent, OPTIONAL_positive_wholenumber_t, precision)
+{
+    NumericFormatter formatter(context, argumentExists(3), precision);
+
+    if (!(percent >= 0.0 && percent <= 100.0))
+    {
+        context->RaiseException(Rexx_Error_Invalid_argument_range,
+          context->ArrayOfFour(
+            context->WholeNumberToObject(2),
+            context->WholeNumberToObject(0),
+            context->WholeNumberToObject(100),
+            context->DoubleToObject(percent)));
+        return NULLOBJECT;
+    }
+
+    NumberArray numbers(context, values);
+    if (!numbers.isValid())
+    {
+        return NULLOBJECT;
+    }
+
+    size_t count = numbers.count();
+    if (count == 0 || hasNan(numbers.values))
+    {
+        return formatter.format(nan(""));
+    }
+
+    std::vector<double> &x = numbers.values;
+    std::sort(x.begin(), x.end());
+
+    // the fractional rank between the two closest values
+    double rank = percent / 100.0 * (count - 1);
+    size_t lower = (size_t)rank;
+    if (lower + 1 >= count)
+    {
+        return formatter.format(x[count - 1]);
+    }
+    double fraction = rank - lower;
+    return formatter.format(x[lower] + (x[lower + 1] - x[lower]) * fraction);
+}
+
 // now build the actual entry list
 RexxRoutineEntry rxmath_functions[] =
 {
@@ -634,6 +1042,14 @@ RexxRoutineEntry rxmath_functions[] =
     REXX_TYPED_ROUTINE(RxCalcArcSin,  RxCalcArcSin),
     REXX_TYPED_ROUTINE(RxCalcArcCos,  RxCalcArcCos),
     REXX_TYPED_ROUTINE(RxCalcArcTan,  RxCalcArcTan),
+    REXX_TYPED_ROUTINE(RxCalcArray,      RxCalcArray),
+    REXX_TYPED_ROUTINE(RxCalcPowerArray, RxCalcPowerArray),
+    REXX_TYPED_ROUTINE(RxCalcSum,        RxCalcSum),
+    REXX_TYPED_ROUTINE(RxCalcMean,       RxCalcMean),
+    REXX_TYPED_ROUTINE(RxCalcVariance,   RxCalcVariance),
+    REXX_TYPED_ROUTINE(RxCalcMin,        RxCalcMin),
+    REXX_TYPED_ROUTINE(RxCalcMax,        RxCalcMax),
+    REXX_TYPED_ROUTINE(RxCalcPercentile, RxCalcPercentile),
     REXX_LAST_ROUTINE()
 };
 
@@ -45,19 +45,26 @@
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #include "automaton.hpp"
 #include "regexp.hpp"
 //#define MYDEBUG
 
 // constructor: initialize automaton
 automaton::automaton() : ch(NULL), next1(NULL), next2(NULL), final(-1), regexp(NULL),
-                         setArray(NULL), setSize(0), size(16), freeState(1), currentPos(0), minimal(false)
+                         setArray(NULL), setSize(0), size(16), freeState(1), currentPos(0), minimal(false),
+                         dfaSets(NULL), dfaFlags(NULL), dfaNext(NULL), dfaCount(0), dfaAllocated(0),
+                         dfaStartState(-1), scratch(NULL), stateMark(NULL), markGeneration(0),
+                         prefilterBuilt(false)
 {
     int bytes = sizeof(int)*size;
 
     ch    = (int*) malloc(bytes);
     next1 = (int*) malloc(bytes);
     next2 = (int*) malloc(bytes);
+
+    // until a pattern is parsed, match anything
+    setState(0, EPSILON, EOP, EOP);
 }
 
 // destructor: free memory
@@ -77,7 +84,10 @@ automaton::~automaton()
         }
         free(setArray);
     }
-
+    dfaReset();
+    free(dfaSets);
+    free(dfaFlags);
+    free(dfaNext);
 }
 
 
@@ -221,6 +231,7 @@ int automaton::parse(const char *regexp)
         this->regexp = NULL;
         // an error occured!
         setState(0, EPSILON, 0, 0);  // make automaton match anything
+        dfaReset();
         return(int) err;
     }
     // set start state
@@ -282,6 +293,7 @@ int automaton::parse(const char *regexp)
 
     this->regexp = NULL;  // contents only guaranteed during
                           // runtime of this method
+    dfaReset();           // any previously built DFA is no longer valid
     return 0;
 }
 
@@ -772,96 +784,445 @@ int automaton::insertSet(char *range, int rangeSize)
   return setSize-1;
 }
 
+/*************************************************************/
+/* matching                                                  */
+/*                                                           */
+/* the NFA built by parse() is not simulated directly.       */
+/* instead, match() runs a DFA whose states are sets of NFA  */
+/* states. DFA states and their transitions are built on     */
+/* demand and cached, so each character of the string costs  */
+/* a single table lookup once the DFA has warmed up.         */
+/*                                                           */
+/* a DFA state only records the NFA states that consume a    */
+/* character, plus two flags:                                */
+/*   DFA_FINAL the final state has been reached. a minimal   */
+/*             match succeeds here, a maximal match needs    */
+/*             the end of the string (or a 0x00 character).  */
+/*   DFA_EOP   the end of pattern has been reached directly; */
+/*             this only happens for a failed parse, which   */
+/*             matches anything.                             */
+/* handling the final state through a flag lets the same DFA */
+/* serve both minimal and maximal matching.                  */
+/*************************************************************/
+
+#define DFA_FINAL   0x01    // the final state is in the set
+#define DFA_EOP     0x02    // the end of pattern is in the set
+#define DFA_UNKNOWN -1      // transition has not been built yet
+
+/*************************************************************/
+/* automaton::dfaReset                                       */
+/*                                                           */
+/* discard all DFA states built so far.                      */
+/*************************************************************/
+void automaton::dfaReset()
+{
+    for (int i = 0; i < dfaCount; i++)
+    {
+        free(dfaSets[i]);
+    }
+    dfaCount = 0;
+    dfaStartState = -1;
+    prefilterBuilt = false;
+
+    free(scratch);
+    free(stateMark);
+    scratch = NULL;
+    stateMark = NULL;
+    markGeneration = 0;
+}
+
+/*************************************************************/
+/* automaton::consumes                                       */
+/*                                                           */
+/* check if an NFA state consumes the given character.       */
+/* characters are compared the same way as they are stored   */
+/* by the parser, i.e. as (signed) char values.              */
+/*************************************************************/
+bool automaton::consumes(int state, unsigned char c)
+{
+    int value = (int)(char)c;
+
+    switch (ch[state] & SCAN)
+    {
+        case ANY:
+            return true;
+        case SET:
+        case SET|NOT:
+        {
+            int set = (ch[state] & 0x0fff0000)>>16;   // get set number
+            int len = setArray[set][0];               // get number of elements in set
+            bool found = (ch[state]&NOT)?true:false;  // set default value
+
+            for (int i = 1; i <= len; i++)
+            {
+                if (setArray[set][i] == value)
+                {
+                    return !found;
+                }
+            }
+            return found;
+        }
+        default:
+            return ch[state] == value;
+    }
+}
+
+/*************************************************************/
+/* automaton::dfaBuild                                       */
+/*                                                           */
+/* compute the epsilon closure of the given seed states and  */
+/* return the DFA state for it, creating a new one if this   */
+/* set of NFA states hasn't been seen before.                */
+/* the seeds are expected to be in the scratch area.         */
+/*************************************************************/
+int automaton::dfaBuild(int *seeds, int seedCount, int flags)
+{
+    // the stack grows above the seeds, the collected states go
+    // to the top end of the scratch area (see dfaStart)
+    int *stack = seeds;
+    int top = seedCount;
+    int *members = scratch + 3 * (freeState + 2);
+    int count = 0;
+
+    // start over with a clean set of marks before the counter wraps
+    if (markGeneration == INT_MAX)
+    {
+        memset(stateMark, 0, (freeState + 2) * sizeof(int));
+        markGeneration = 0;
+    }
+    markGeneration++;
+
+    while (top > 0)
+    {
+        int state = stack[--top];
+
+        if (state == EOP)
+        {
+            flags |= DFA_EOP;
+            continue;
+        }
+        if (stateMark[state] == markGeneration)
+        {
+            continue;
+        }
+        stateMark[state] = markGeneration;
+
+        if (state == final)
+        {
+            flags |= DFA_FINAL;
+        }
+        else if ((ch[state] & SCAN) == EPSILON)
+        {
+            stack[top++] = next1[state];
+            if (next1[state] != next2[state])
+            {
+                stack[top++] = next2[state];
+            }
+        }
+        else
+        {
+            // insert sorted, sets are small
+            int i = count++;
+            while (i > 0 && members[i - 1] > state)
+            {
+                members[i] = members[i - 1];
+                i--;
+            }
+            members[i] = state;
+        }
+    }
+
+    // do we know this set already?
+    for (int i = 0; i < dfaCount; i++)
+    {
+        if (dfaFlags[i] == flags && dfaSets[i][0] == count &&
+            memcmp(dfaSets[i] + 1, members, count * sizeof(int)) == 0)
+        {
+            return i;
+        }
+    }
+
+    // add a new DFA state
+    if (dfaCount == dfaAllocated)
+    {
+        dfaAllocated = dfaAllocated == 0 ? 16 : dfaAllocated * 2;
+        dfaSets  = (int**) realloc(dfaSets, dfaAllocated * sizeof(int*));
+        dfaFlags = (int*) realloc(dfaFlags, dfaAllocated * sizeof(int));
+        dfaNext  = (int*) realloc(dfaNext, dfaAllocated * 256 * sizeof(int));
+    }
+    int *set = (int*) malloc((count + 1) * sizeof(int));
+    set[0] = count;
+    memcpy(set + 1, members, count * sizeof(int));
+
+    dfaSets[dfaCount] = set;
+    dfaFlags[dfaCount] = flags;
+    for (int i = 0; i < 256; i++)
+    {
+        dfaNext[dfaCount * 256 + i] = DFA_UNKNOWN;
+    }
+    return dfaCount++;
+}
+
+/*************************************************************/
+/* automaton::dfaStart                                       */
+/*                                                           */
+/* return the DFA start state, building it if necessary.     */
+/*************************************************************/
+int automaton::dfaStart()
+{
+    if (dfaStartState == -1)
+    {
+        if (scratch == NULL)
+        {
+            // room for the seeds and the closure stack (each state pushes
+            // at most two others), followed by the collected members
+            scratch = (int*) malloc(4 * (freeState + 2) * sizeof(int));
+            stateMark = (int*) calloc(freeState + 2, sizeof(int));
+        }
+        scratch[0] = next1[0];
+        dfaStartState = dfaBuild(scratch, 1, 0);
+    }
+    return dfaStartState;
+}
+
+/*************************************************************/
+/* automaton::dfaStep                                        */
+/*                                                           */
+/* return the DFA state reached from a state by consuming a  */
+/* character. unknown transitions are built and cached; if   */
+/* the cache is full, it is flushed first. the state passed  */
+/* in is no longer valid after a flush, so callers must only */
+/* keep the returned state.                                  */
+/*************************************************************/
+int automaton::dfaStep(int state, unsigned char c)
+{
+    int next = dfaNext[state * 256 + c];
+    if (next != DFA_UNKNOWN)
+    {
+        return next;
+    }
+
+    // collect the states reached by consuming the character
+    int *set = dfaSets[state];
+    int seedCount = 0;
+    for (int i = 1; i <= set[0]; i++)
+    {
+        if (consumes(set[i], c))
+        {
+            scratch[seedCount++] = next1[set[i]];
+        }
+    }
+
+    if (dfaCount == DFA_MAX_STATES)
+    {
+        // keep the scratch area, it holds our seeds
+        for (int i = 0; i < dfaCount; i++)
+        {
+            free(dfaSets[i]);
+        }
+        dfaCount = 0;
+        dfaStartState = -1;
+        next = dfaBuild(scratch, seedCount, 0);
+    }
+    else
+    {
+        next = dfaBuild(scratch, seedCount, 0);
+        dfaNext[state * 256 + c] = next;
+    }
+    return next;
+}
+
+/*************************************************************/
+/* automaton::run                                            */
+/*                                                           */
+/* run the DFA over a string. this behaves like the original */
+/* NFA simulation: the string is treated as if it had a 0x00 */
+/* terminator, a minimal match succeeds as soon as the final */
+/* state is reached, and a maximal match needs to consume    */
+/* the terminator (or a 0x00 character) in the final state.  */
+/* returns 1 on success and 0 on failure. currentPos is set  */
+/* to the number of characters matched, or on failure to the */
+/* position at which matching stopped.                       */
+/*************************************************************/
+int automaton::run(const char *a, int N, bool minimalMatch)
+{
+    int state = dfaStart();
+
+    for (int j = 0; ; j++)
+    {
+        int flags = dfaFlags[state];
+
+        if (flags & DFA_EOP)
+        {
+            currentPos = j;
+            return 1;
+        }
+        if (flags & DFA_FINAL)
+        {
+            if (minimalMatch)
+            {
+                currentPos = j;
+                return 1;
+            }
+            // the final state consumes the terminator
+            if (j == N || a[j] == 0x00)
+            {
+                currentPos = j < N ? j + 1 : N;
+                return 1;
+            }
+        }
+        if (j >= N)
+        {
+            break;
+        }
+        state = dfaStep(state, (unsigned char)a[j]);
+        // no way to continue?
+        if (dfaFlags[state] == 0 && dfaSets[state][0] == 0)
+        {
+            currentPos = j;
+            return 0;
+        }
+    }
+
+    currentPos = N;
+    return 0;
+}
+
 /*************************************************/
 /* automaton::match                              */
 /*                                               */
 /* try to match a string with the automaton.     */
 /* returns 1 on success and 0 on failure.        */
-/* matching is non-recursively done with a queue */
-/* that has a push, put and pop method.          */
 /*************************************************/
 int automaton::match(const char *a, int N)  // string length passed in
                                       // instead of strlen
 {
-  int n1, n2;
-  int j = 0;
-  int state = next1[0];  // get start state
-  doubleQueue dq(64);    // create a double queue
-                         // one SCAN symbol will be put into the queue
-  int i;
-  int set;
-  int len;
-  bool found;
-
-  // terminates when end state (==0) is reached
-  while (state) {
-#ifdef MYDEBUG
-    printf("          ");
-    dq.dump();
-#endif
-    // go to next character
-    if (state == SCAN) {
-      if (minimal == true && j == N) break; // for minimal match
-#ifdef MYDEBUG
-      printf("consume %2d %c\n",j,a[j]);
-#endif
-      j++;
-      dq.put(SCAN);
-    }
-    else
-    switch (ch[state] & SCAN) {
-    case EPSILON:        // epsilon transition
-      n1 = next1[state];
-      n2 = next2[state];
-      dq.push(n1);
-      if (n1 != n2) dq.push(n2);
-      break;
-    case SET:            // inclusive set
-    case SET|NOT:        // exclusive set
-      set = (ch[state] & 0x0fff0000)>>16;   // get set number
-      len = setArray[set][0];               // get number of elements in set
-      found = (ch[state]&NOT)?true:false;   // set default value
+    return run(a, N, minimal);
+}
 
-      for (i=1; i<=len; i++) {
-        if (setArray[set][i] == (int) a[j]) {
-          found = !found;
-          break;
+/*************************************************************/
+/* automaton::longestMatch                                   */
+/*                                                           */
+/* find the longest leading part of the string that matches  */
+/* maximally. this gives the same result as trying maximal   */
+/* matches with decreasing lengths, but with a single pass.  */
+/* returns 1 on success and 0 on failure, currentPos is set  */
+/* to the length of the match.                               */
+/*************************************************************/
+int automaton::longestMatch(const char *a, int N)
+{
+    int state = dfaStart();
+    int longest = -1;
+
+    for (int j = 0; ; j++)
+    {
+        int flags = dfaFlags[state];
+
+        if (flags & DFA_EOP)
+        {
+            currentPos = j;
+            return 1;
         }
-      }
-      if (found) {
-        dq.put(next1[state]);
-      }
-      break;
-    case ANY:            // just match any character
-      dq.put(next1[state]);
-      break;
-    default:
-      if (j < N) { // freeState: we can't read past end of string
-        // normal character?
-        if (ch[state] == (int) a[j]) {
-          dq.put(next1[state]);
+        if (flags & DFA_FINAL)
+        {
+            // a 0x00 character terminates all longer matches as well
+            if (j < N && a[j] == 0x00)
+            {
+                currentPos = j + 1;
+                return 1;
+            }
+            longest = j;
         }
-      } else if (j == N) {  // simulate zero-terminated string in any case
-        if (ch[state] == (int) 0) {
-          dq.put(next1[state]);
+        if (j >= N || dfaSets[state][0] == 0)
+        {
+            break;
         }
-      }
-      break;
+        state = dfaStep(state, (unsigned char)a[j]);
+    }
+
+    if (longest >= 0)
+    {
+        currentPos = longest;
+        return 1;
+    }
+    currentPos = 0;
+    return 0;
+}
+
+/*************************************************************/
+/* automaton::buildPrefilter                                 */
+/*                                                           */
+/* determine the characters a minimal match can start with.  */
+/*************************************************************/
+void automaton::buildPrefilter()
+{
+    int state = dfaStart();
+
+    matchesEmpty = (dfaFlags[state] & (DFA_FINAL | DFA_EOP)) != 0;
+    startCount = 0;
+    for (int c = 0; c < 256; c++)
+    {
+        // dfaStep() might flush the cache, so always refetch the start
+        int next = dfaStep(dfaStart(), (unsigned char)c);
+        startBytes[c] = dfaFlags[next] != 0 || dfaSets[next][0] != 0;
+        if (startBytes[c])
+        {
+            startCount++;
+            startByte = (unsigned char)c;
+        }
+    }
+    prefilterBuilt = true;
+}
+
+/*************************************************************/
+/* automaton::search                                         */
+/*                                                           */
+/* find the first position in the string at which a minimal */
+/* match succeeds. positions that cannot start a match are   */
+/* skipped without running the DFA; if there's just a single */
+/* possible start character, memchr() is used to find them. */
+/* returns the offset of the match or -1 if there is none.   */
+/* currentPos is set to the length of the minimal match.     */
+/*************************************************************/
+int automaton::search(const char *a, int N)
+{
+    if (!prefilterBuilt)
+    {
+        buildPrefilter();
+    }
+
+    // every position matches the null string
+    if (matchesEmpty)
+    {
+        currentPos = 0;
+        return 0;
     }
-#ifdef MYDEBUG
-    printf("%s",dq.isEmpty()?"    empty ":"NOT empty ");
-    dq.dump();
-#endif
-    // break out if we've reached the end of the string
-    // or no more states are available
-    if (dq.isEmpty() || (j>(N+1)) ) break;
-    state = dq.pop();
-  }
 
-  currentPos = j;
+    const char *end = a + N;
+    const char *ptr = a;
+    while (ptr < end)
+    {
+        if (startCount == 1)
+        {
+            ptr = (const char*) memchr(ptr, startByte, end - ptr);
+            if (ptr == NULL)
+            {
+                break;
+            }
+        }
+        else if (!startBytes[(unsigned char)*ptr])
+        {
+            ptr++;
+            continue;
+        }
 
-  if (currentPos > N) currentPos = N;
+        if (run(ptr, (int)(end - ptr), true))
+        {
+            return (int)(ptr - a);
+        }
+        ptr++;
+    }
 
-  // return 1 if end state (EOP) has been reached
-  return state==EOP?1:0;
+    currentPos = 0;
+    return -1;
 }
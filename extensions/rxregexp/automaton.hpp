@@ -45,7 +45,11 @@
 #ifndef AUTOMATON
 #define AUTOMATON
 
-#include "dblqueue.hpp"
+#include <mutex>
+
+// upper limit for the number of cached DFA states.  Once reached, the
+// cache is flushed and rebuilt from the states actually needed.
+#define DFA_MAX_STATES 1024
 
 class automaton {
   public:
@@ -53,6 +57,8 @@ class automaton {
     ~automaton();             // DTOR
     int parse(const char*);         // parse regular expression
     int match(const char*, int);    // match a string
+    int search(const char*, int);   // find the first (minimal) match
+    int longestMatch(const char*, int); // maximal match at string start
 
     // in case of a parsing error, this can be used
     // to detect the position at which the error
@@ -63,6 +69,12 @@ class automaton {
     void setMinimal(bool);
     bool getMinimal() { return minimal; }
 
+    // The lazily built DFA and the match results are shared by all users
+    // of the automaton.  Native methods run without the kernel lock, so any
+    // parse or match sequence has to hold this lock until it has fetched
+    // its results.
+    std::mutex &getLock() { return lock; }
+
   private:
     // methods to parse a regular expression
     int expression();
@@ -78,6 +90,15 @@ class automaton {
     // helper function for set building
     int checkRange(char*, int, char);
 
+    // methods to run the lazily built DFA
+    int  run(const char*, int, bool);
+    void dfaReset();
+    int  dfaStart();
+    int  dfaStep(int, unsigned char);
+    int  dfaBuild(int*, int, int);
+    bool consumes(int, unsigned char);
+    void buildPrefilter();
+
     int *ch;        // characters to match
     int *next1;     // first transition possibility
     int *next2;     // second transition possibility
@@ -93,6 +114,26 @@ class automaton {
     int  freeState; // number of next free state
     int  currentPos;// current position in parsing
     bool minimal;   // minimal matching?
+
+    // DFA states are built on demand from sets of NFA states
+    int **dfaSets;      // the consuming NFA states of each DFA state
+    int  *dfaFlags;     // DFA_FINAL/DFA_EOP flags of each DFA state
+    int  *dfaNext;      // 256 transitions per DFA state, DFA_UNKNOWN if not built yet
+    int   dfaCount;     // number of DFA states in use
+    int   dfaAllocated; // number of DFA states allocated
+    int   dfaStartState;// the DFA start state, -1 if not built yet
+    int  *scratch;      // work area for building NFA state sets
+    int  *stateMark;    // marks NFA states visited while building a set
+    int   markGeneration; // current stateMark value
+
+    // prefilter for search(): the bytes a match can start with
+    bool  prefilterBuilt; // prefilter data is valid
+    bool  matchesEmpty; // the pattern matches the null string
+    int   startCount;   // number of possible start bytes
+    unsigned char startByte; // the start byte if there's just one
+    bool  startBytes[256]; // possible start bytes
+
+    std::mutex lock;    // serializes the use of the automaton by several threads
 };
 
 #endif
@@ -40,12 +40,12 @@
 /* Regular Expression Utility functions                                       */
 /*                                                                            */
 /******************************************************************************/
-#include "dblqueue.hpp"
 #include "automaton.hpp"
 #include "regexp.hpp"
 
 #include "oorexxapi.h"
 #include <string.h>
+#include <stdlib.h>
 
 // strcasecmp is called _stricmp by MSVC  
 #ifdef WIN32
@@ -111,15 +111,16 @@ RexxMethod3(int,                            // Return type
     automaton  *pAutomaton = (automaton *)self;
     // moved some ptrs to re-use variables
     // optional matchtype given?
+    int minimal = -1;          // -1 keeps the current matching
     if (matchtype != NULL)
     {
         if ( strcasecmp(matchtype, "MINIMAL") == 0)
         {
-            pAutomaton->setMinimal(true); // set minimal matching
+            minimal = 1;       // set minimal matching
         }
         else if (strcasecmp(matchtype, "MAXIMAL") == 0)
         {
-            pAutomaton->setMinimal(false); // set maximal matching
+            minimal = 0;       // set maximal matching
         }
         else if (strcasecmp(matchtype, "CURRENT") == 0)
         {
@@ -130,8 +131,18 @@ RexxMethod3(int,                            // Return type
             context->RaiseException0(Rexx_Error_Incorrect_method);
         }
     }
-    int i = pAutomaton->parse( expression);
-    context->SetObjectVariable("!POS", context->WholeNumber(pAutomaton->getCurrentPos()));
+    int i;
+    int position;
+    {
+        std::lock_guard<std::mutex> guard(pAutomaton->getLock());
+        if (minimal != -1)
+        {
+            pAutomaton->setMinimal(minimal == 1);
+        }
+        i = pAutomaton->parse( expression);
+        position = pAutomaton->getCurrentPos();
+    }
+    context->SetObjectVariable("!POS", context->WholeNumber(position));
     return i;
 }
 
@@ -141,8 +152,14 @@ RexxMethod2(int,                          // Return type
             RexxStringObject, string)     // string to match
 {
     automaton  *pAutomaton = (automaton *)self;
-    int i = pAutomaton->match( context->StringData(string), (int)context->StringLength(string));
-    context->SetObjectVariable("!POS", context->WholeNumber(pAutomaton->getCurrentPos()));
+    int i;
+    int position;
+    {
+        std::lock_guard<std::mutex> guard(pAutomaton->getLock());
+        i = pAutomaton->match( context->StringData(string), (int)context->StringLength(string));
+        position = pAutomaton->getCurrentPos();
+    }
+    context->SetObjectVariable("!POS", context->WholeNumber(position));
     return i;
 }
 
@@ -152,55 +169,225 @@ RexxMethod2(int,                          // Return type
             RexxStringObject, string)     // string to match
 {
     automaton  *pAutomaton = (automaton *)self;
-    bool        fOldState;
-    const char *pszString;
-    int         strlength;
-    int         i;
+    const char *pszString = context->StringData(string);
+    int         strlength = (int)context->StringLength(string);
+    int         matchPosition = 0;
+    int         i = 0;
 
-    pszString = context->StringData(string);
-    strlength = (int)context->StringLength(string);
-    int matchPosition = 0;
-
-//  if (strlength > 0) // allow null string
     {
-        fOldState = pAutomaton->getMinimal();
-
-        // we start out matching minimal
-        pAutomaton->setMinimal(true);
-        do
-        {
-            i = pAutomaton->match(pszString, strlength);
-            strlength--;
-            pszString++;
-        } while (i == 0 && strlength >= 0);
+        std::lock_guard<std::mutex> guard(pAutomaton->getLock());
+        // find the first position with a minimal match
+        int offset = pAutomaton->search(pszString, strlength);
         // can we match at all?
-        if (i != 0)
+        if (offset >= 0)
         {
-            i = (int) (pszString - context->StringData(string));
+            i = offset + 1;
             // want a maximal match within string?
-            if (fOldState == false)
+            if (pAutomaton->getMinimal() == false)
             {
-                pAutomaton->setMinimal(false);
-                pszString--; // correct starting pos
-                strlength++; // correct starting len
-                while (strlength >= 0)
-                {
-                    if (pAutomaton->match(pszString, strlength) != 0)
-                    {
-                        break;
-                    }
-                    strlength--;
-                }
+                pAutomaton->longestMatch(pszString + offset, strlength - offset);
             }
             matchPosition = i + pAutomaton->getCurrentPos() - 1;
         }
+    }
+
+    context->SetObjectVariable("!POS", context->WholeNumber(matchPosition));
+    return i;
+}
+
+// one item of the source of a bulk operation
+struct BulkItem
+{
+    const char *data;          // the item string value
+    int         length;        // the item string length
+    size_t      index;         // the item index in the source
+    RexxObjectPtr item;        // the source item
+};
+
+/**
+ * Collect the string values of all items of a bulk operation
+ * source.  This is the only part of a bulk operation that needs
+ * to call back into the interpreter; the matching itself then runs
+ * without any API calls and so without holding the kernel lock.
+ *
+ * @param context The method context.
+ * @param source  An Array, or any object that supports MAKEARRAY, like a
+ *                Stream (which returns its lines) or a List.
+ * @param count   Returns the number of collected items.
+ * @param size    Returns the size of the source array, which includes any
+ *                empty slots.
+ *
+ * @return An allocated array of items, or NULL if an error was raised.
+ */
+BulkItem *collectItems(RexxMethodContext *context, RexxObjectPtr source, size_t &count, size_t &size)
+{
+    RexxArrayObject array;
+    count = 0;
+    size = 0;
+
+    if (context->IsArray(source))
+    {
+        array = (RexxArrayObject)source;
+    }
+    else
+    {
+        RexxObjectPtr result = context->SendMessage0(source, "MAKEARRAY");
+        if (result == NULLOBJECT || !context->IsArray(result))
+        {
+            if (!context->CheckCondition())
+            {
+                context->RaiseException1(Rexx_Error_Incorrect_method_noarray, context->WholeNumber(1));
+            }
+            return NULL;
+        }
+        array = (RexxArrayObject)result;
+    }
 
-        context->SetObjectVariable("!POS", context->WholeNumber(matchPosition));
-        pAutomaton->setMinimal(fOldState);  // restore to state at POS invocation time
-        return i;
+    size = context->ArraySize(array);
+    BulkItem *items = (BulkItem *)malloc((size + 1) * sizeof(BulkItem));
+    if (items == NULL)
+    {
+        context->RaiseException0(Rexx_Error_System_resources);
+        return NULL;
     }
 
-    return 0;
+    for (size_t i = 1; i <= size; i++)
+    {
+        RexxObjectPtr item = context->ArrayAt(array, i);
+        // skip any empty slots
+        if (item == NULLOBJECT)
+        {
+            continue;
+        }
+        // only non-string items need a (locking) conversion
+        RexxStringObject string = context->IsString(item) ? (RexxStringObject)item : context->ObjectToString(item);
+        items[count].data = context->StringData(string);
+        items[count].length = (int)context->StringLength(string);
+        items[count].index = i;
+        items[count].item = item;
+        count++;
+    }
+    return items;
+}
+
+RexxMethod3(RexxArrayObject,              // Return type
+            RegExp_MatchAll,              // Object_method name
+            CSELF, self,                  // Pointer to self
+            RexxObjectPtr, source,        // the strings to match
+            OPTIONAL_CSTRING, option)     // return (I)ndexes (def.) or (L)ines
+{
+    automaton  *pAutomaton = (automaton *)self;
+    bool        returnLines = false;
+
+    if (option != NULL)
+    {
+        if (*option == 'L' || *option == 'l')
+        {
+            returnLines = true;
+        }
+        else if (*option != 'I' && *option != 'i')
+        {
+            context->RaiseException0(Rexx_Error_Incorrect_method);
+            return NULLOBJECT;
+        }
+    }
+
+    size_t count, size;
+    BulkItem *items = collectItems(context, source, count, size);
+    if (items == NULL)
+    {
+        return NULLOBJECT;
+    }
+
+    // match everything, compacting the matching items to the front
+    size_t matches = 0;
+    std::unique_lock<std::mutex> guard(pAutomaton->getLock());
+    for (size_t i = 0; i < count; i++)
+    {
+        if (pAutomaton->match(items[i].data, items[i].length))
+        {
+            items[matches++] = items[i];
+        }
+    }
+    guard.unlock();
+
+    RexxArrayObject result = context->NewArray(matches);
+    for (size_t i = 0; i < matches; i++)
+    {
+        context->ArrayPut(result, returnLines ? items[i].item : context->StringSizeToObject(items[i].index), i + 1);
+    }
+    free(items);
+    return result;
+}
+
+RexxMethod3(RexxArrayObject,              // Return type
+            RegExp_PosAll,                // Object_method name
+            CSELF, self,                  // Pointer to self
+            RexxObjectPtr, source,        // the strings to search
+            OPTIONAL_RexxArrayObject, positions) // optional array for the match end positions
+{
+    automaton  *pAutomaton = (automaton *)self;
+
+    size_t count, size;
+    BulkItem *items = collectItems(context, source, count, size);
+    if (items == NULL)
+    {
+        return NULLOBJECT;
+    }
+
+    int *matchStart = (int *)malloc((count + 1) * sizeof(int));
+    int *matchEnd = (int *)malloc((count + 1) * sizeof(int));
+    if (matchStart == NULL || matchEnd == NULL)
+    {
+        free(matchStart);
+        free(matchEnd);
+        free(items);
+        context->RaiseException0(Rexx_Error_System_resources);
+        return NULLOBJECT;
+    }
+
+    // search everything
+    std::unique_lock<std::mutex> guard(pAutomaton->getLock());
+    for (size_t i = 0; i < count; i++)
+    {
+        matchStart[i] = 0;
+        matchEnd[i] = 0;
+        int offset = pAutomaton->search(items[i].data, items[i].length);
+        if (offset >= 0)
+        {
+            matchStart[i] = offset + 1;
+            // want a maximal match within string?
+            if (pAutomaton->getMinimal() == false)
+            {
+                pAutomaton->longestMatch(items[i].data + offset, items[i].length - offset);
+            }
+            matchEnd[i] = matchStart[i] + pAutomaton->getCurrentPos() - 1;
+        }
+    }
+    guard.unlock();
+
+    // one result per source slot, empty slots get zero
+    RexxArrayObject result = context->NewArray(size);
+    for (size_t i = 1, next = 0; i <= size; i++)
+    {
+        wholenumber_t start = 0;
+        wholenumber_t end = 0;
+        if (next < count && items[next].index == i)
+        {
+            start = matchStart[next];
+            end = matchEnd[next];
+            next++;
+        }
+        context->ArrayPut(result, context->WholeNumber(start), i);
+        if (positions != NULLOBJECT)
+        {
+            context->ArrayPut(positions, context->WholeNumber(end), i);
+        }
+    }
+    free(matchStart);
+    free(matchEnd);
+    free(items);
+    return result;
 }
 
 // now build the actual entry list
@@ -211,6 +398,8 @@ RexxMethodEntry rxregexp_methods[] =
     REXX_METHOD(RegExp_Parse,   RegExp_Parse),
     REXX_METHOD(RegExp_Pos,     RegExp_Pos),
     REXX_METHOD(RegExp_Match,   RegExp_Match),
+    REXX_METHOD(RegExp_MatchAll, RegExp_MatchAll),
+    REXX_METHOD(RegExp_PosAll,  RegExp_PosAll),
     REXX_LAST_METHOD()
 };
 
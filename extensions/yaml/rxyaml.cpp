@@ -0,0 +1,2352 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/******************************************************************************/
+/* Object REXX Support                                            rxyaml.cpp  */
+/* Native YAML parsing for yaml.cls                                           */
+/*                                                                            */
+/******************************************************************************/
+#include "oorexxapi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*************************************************************/
+/* class YamlBuffer                                          */
+/*                                                           */
+/* a growable character buffer for assembling plain and     */
+/* quoted scalars.                                           */
+/*************************************************************/
+class YamlBuffer
+{
+  public:
+    YamlBuffer()
+    {
+        size = 256;
+        length = 0;
+        buffer = (char *)malloc(size);
+    }
+
+    ~YamlBuffer()
+    {
+        free(buffer);
+    }
+
+    inline void append(const char *s, size_t n)
+    {
+        if (length + n > size)
+        {
+            grow(n);
+        }
+        memcpy(buffer + length, s, n);
+        length += n;
+    }
+
+    inline void append(char c)
+    {
+        if (length == size)
+        {
+            grow(1);
+        }
+        buffer[length++] = c;
+    }
+
+    inline void clear()
+    {
+        length = 0;
+    }
+
+    char   *buffer;                    // the collected text
+    size_t  length;                    // length of the text
+
+  private:
+    void grow(size_t n)
+    {
+        while (size < length + n)
+        {
+            size *= 2;
+        }
+        buffer = (char *)realloc(buffer, size);
+    }
+
+    size_t  size;                      // size of the buffer
+};
+
+
+/*************************************************************/
+/* struct YamlText                                           */
+/*                                                           */
+/* a piece of an input line. yaml.cls works on substrings of */
+/* the lines all the time, here they are just pointer and    */
+/* length into the line's string data.                       */
+/*************************************************************/
+struct YamlText
+{
+    YamlText() : data(""), length(0) { }
+    YamlText(const char *d, size_t l) : data(d), length(l) { }
+
+    inline bool startsWith(char c) const
+    {
+        return length > 0 && data[0] == c;
+    }
+
+    inline bool startsWith(const char *s) const
+    {
+        size_t n = strlen(s);
+        return length >= n && memcmp(data, s, n) == 0;
+    }
+
+    inline bool equals(const char *s) const
+    {
+        return length == strlen(s) && memcmp(data, s, length) == 0;
+    }
+
+    // like ~left(n) and ~substr(n + 1), but without any padding
+    inline YamlText left(size_t n) const
+    {
+        return YamlText(data, n < length ? n : length);
+    }
+
+    inline YamlText from(size_t n) const
+    {
+        return n < length ? YamlText(data + n, length - n) : YamlText(data + length, 0);
+    }
+
+    const char *data;                  // the characters
+    size_t      length;                // and how many there are
+};
+
+
+/*************************************************************/
+/* helper functions                                          */
+/*                                                           */
+/* these are the text utilities of yaml.cls. the lines never */
+/* contain tabs here (see YamlParser::load), so stripping    */
+/* and indentation only have to deal with blanks.            */
+/*************************************************************/
+static YamlText strip(YamlText text)
+{
+    while (text.length > 0 && text.data[0] == ' ')
+    {
+        text.data++;
+        text.length--;
+    }
+    while (text.length > 0 && text.data[text.length - 1] == ' ')
+    {
+        text.length--;
+    }
+    return text;
+}
+
+
+static int indentOf(YamlText line)
+{
+    size_t i = 0;
+    while (i < line.length && line.data[i] == ' ')
+    {
+        i++;
+    }
+    return (int)i;
+}
+
+
+// "- item" or a lone "-"
+static bool isSequenceEntry(YamlText content)
+{
+    return content.startsWith("- ") || content.equals("-");
+}
+
+
+// "---" or "..." on its own or followed by a blank
+static bool isDocumentMarker(YamlText content)
+{
+    if (!content.startsWith("---") && !content.startsWith("..."))
+    {
+        return false;
+    }
+    return content.length == 3 || content.data[3] == ' ' || content.data[3] == '\t';
+}
+
+
+/*************************************************************/
+/* findMapColon                                              */
+/*                                                           */
+/* the position (1-based) of the ': ' that separates a block */
+/* mapping key from its value, or 0. quotes only count at    */
+/* the start of the key or within a flow collection, a       */
+/* comment ends the search.                                  */
+/*************************************************************/
+static size_t findMapColon(YamlText text)
+{
+    bool inSingle = false;
+    bool inDouble = false;
+    int flowDepth = 0;
+
+    for (size_t i = 0; i < text.length; i++)
+    {
+        char ch = text.data[i];
+        if (inSingle)
+        {
+            if (ch == '\'')
+            {
+                inSingle = false;
+            }
+        }
+        else if (inDouble)
+        {
+            if (ch == '\\')
+            {
+                i++;
+            }
+            else if (ch == '"')
+            {
+                inDouble = false;
+            }
+        }
+        else if (ch == '\'' && (i == 0 || flowDepth > 0))
+        {
+            inSingle = true;
+        }
+        else if (ch == '"' && (i == 0 || flowDepth > 0))
+        {
+            inDouble = true;
+        }
+        else if (ch == '[' || ch == '{')
+        {
+            flowDepth++;
+        }
+        else if (ch == ']' || ch == '}')
+        {
+            if (flowDepth > 0)
+            {
+                flowDepth--;
+            }
+        }
+        else if (ch == '#' && i > 0 && text.data[i - 1] == ' ')
+        {
+            if (flowDepth == 0)
+            {
+                return 0;
+            }
+        }
+        else if (ch == ':' && flowDepth == 0)
+        {
+            if (i + 1 == text.length || text.data[i + 1] == ' ' || text.data[i + 1] == '\t')
+            {
+                return i + 1;
+            }
+        }
+    }
+    return 0;
+}
+
+
+/*************************************************************/
+/* stripComment                                              */
+/*                                                           */
+/* remove a trailing ' #' comment outside of any quotes.     */
+/* returns true if there was a comment.                      */
+/*************************************************************/
+static bool stripComment(YamlText text, YamlText &result)
+{
+    bool inSingle = false;
+    bool inDouble = false;
+
+    for (size_t i = 0; i < text.length; i++)
+    {
+        char ch = text.data[i];
+        if (inSingle)
+        {
+            if (ch == '\'')
+            {
+                inSingle = false;
+            }
+        }
+        else if (inDouble)
+        {
+            if (ch == '\\')
+            {
+                i++;
+            }
+            else if (ch == '"')
+            {
+                inDouble = false;
+            }
+        }
+        else if (ch == '\'')
+        {
+            inSingle = true;
+        }
+        else if (ch == '"')
+        {
+            inDouble = true;
+        }
+        else if (ch == '#' && i > 0 && text.data[i - 1] == ' ')
+        {
+            result = strip(text.left(i - 1));
+            return true;
+        }
+    }
+    result = text;
+    return false;
+}
+
+
+/*************************************************************/
+/* matchBracket                                              */
+/*                                                           */
+/* the position (1-based) of the bracket closing the flow    */
+/* collection the text starts with, or the text length.      */
+/*************************************************************/
+static size_t matchBracket(YamlText text, char openBr, char closeBr)
+{
+    bool inSingle = false;
+    bool inDouble = false;
+    int depth = 0;
+
+    for (size_t i = 0; i < text.length; i++)
+    {
+        char ch = text.data[i];
+        if (inSingle)
+        {
+            if (ch == '\'')
+            {
+                inSingle = false;
+            }
+        }
+        else if (inDouble)
+        {
+            if (ch == '\\')
+            {
+                i++;
+            }
+            else if (ch == '"')
+            {
+                inDouble = false;
+            }
+        }
+        else if (ch == '\'')
+        {
+            inSingle = true;
+        }
+        else if (ch == '"')
+        {
+            inDouble = true;
+        }
+        else if (ch == openBr)
+        {
+            depth++;
+        }
+        else if (ch == closeBr)
+        {
+            depth--;
+            if (depth == 0)
+            {
+                return i + 1;
+            }
+        }
+    }
+    return text.length;
+}
+
+
+/*************************************************************/
+/* isBlockIndicator                                          */
+/*                                                           */
+/* check for a block scalar header: '|' or '>' with at most  */
+/* one chomping indicator and one indentation digit,         */
+/* optionally followed by a comment.                         */
+/*************************************************************/
+static bool isBlockIndicator(YamlText text)
+{
+    if (!text.startsWith('|') && !text.startsWith('>'))
+    {
+        return false;
+    }
+
+    YamlText header = text;
+    for (size_t i = 1; i < text.length; i++)
+    {
+        char c = text.data[i];
+        if (c == ' ' || c == '\t')
+        {
+            YamlText rest = strip(text.from(i));
+            if (rest.length > 0 && rest.data[0] != '#')
+            {
+                return false;
+            }
+            header = text.left(i);
+            break;
+        }
+        if (c != '+' && c != '-' && (c < '0' || c > '9'))
+        {
+            return false;
+        }
+    }
+
+    int digitCount = 0;
+    int chompCount = 0;
+    for (size_t i = 1; i < header.length; i++)
+    {
+        char c = header.data[i];
+        if (c >= '0' && c <= '9')
+        {
+            digitCount++;
+            if (c == '0' || digitCount > 1)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            chompCount++;
+            if (chompCount > 1)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+/*************************************************************/
+/* extractAliasName                                          */
+/*                                                           */
+/* an alias or anchor name ends at a blank or a flow         */
+/* indicator.                                                */
+/*************************************************************/
+static YamlText extractAliasName(YamlText text)
+{
+    for (size_t i = 0; i < text.length; i++)
+    {
+        if (strchr(" \t[]{},", text.data[i]) != NULL)
+        {
+            return text.left(i);
+        }
+    }
+    return text;
+}
+
+
+/*************************************************************/
+/* simpleQuoted                                              */
+/*                                                           */
+/* decode a quoted scalar that is closed on the same line    */
+/* and, if double-quoted, has no escapes. these are the ones */
+/* that need no folding or escape processing, everything     */
+/* else is left to yaml.cls. returns false if the scalar     */
+/* isn't one of them; otherwise the value goes to the buffer */
+/* and rest is what follows the closing quote.               */
+/*************************************************************/
+static bool simpleQuoted(YamlText text, YamlBuffer &value, YamlText &rest)
+{
+    char quote = text.data[0];
+
+    value.clear();
+    for (size_t i = 1; i < text.length; i++)
+    {
+        char ch = text.data[i];
+        if (quote == '"' && ch == '\\')
+        {
+            return false;
+        }
+        if (ch == quote)
+        {
+            // a doubled single quote stands for itself
+            if (quote == '\'' && i + 1 < text.length && text.data[i + 1] == '\'')
+            {
+                value.append('\'');
+                i++;
+                continue;
+            }
+            rest = text.from(i + 1);
+            return true;
+        }
+        value.append(ch);
+    }
+    return false;
+}
+
+
+/*************************************************************/
+/* class YamlParser                                          */
+/*                                                           */
+/* the block structure part of the yaml.cls parser. it works */
+/* on the lines array and the position of the Yaml object    */
+/* and follows the Rexx methods of the same names step by    */
+/* step, so the results are exactly the same: mappings are   */
+/* a .Table, sequences an .Array, null is .nil, booleans are */
+/* the .YamlBoolean singletons and anchors are registered in */
+/* anchors and anchorMap.                                    */
+/*                                                           */
+/* constructs that are rare in practice (tags, complex keys, */
+/* flow collections, block scalars, escaped or multi-line    */
+/* quoted scalars, ...) are handed to the Rexx method that   */
+/* deals with them, with the position passed back and forth. */
+/* an error raised by such a method is left pending, so it   */
+/* reaches the caller of yaml.cls unchanged.                 */
+/*                                                           */
+/* a few constructs can't be handed over in the middle of a  */
+/* mapping or sequence, and a few errors are only noticed    */
+/* here. for those the methods return NULLOBJECT with no     */
+/* condition pending, and the document is parsed again by    */
+/* the Rexx methods (see parseDocuments). the same happens   */
+/* for lines with tabs or other control characters.          */
+/*************************************************************/
+class YamlParser
+{
+  public:
+    YamlParser(RexxMethodContext *c) : context(c)
+    {
+        self = context->GetSelf();
+        lines = NULLOBJECT;
+        lineCount = 0;
+        lineData = NULL;
+        lineLength = NULL;
+        lineEpoch = NULL;
+        epoch = 1;
+        pos = 1;
+        tableClass = context->FindContextClass("TABLE");
+        RexxClassObject booleanClass = context->FindContextClass("YAMLBOOLEAN");
+        trueObject = context->SendMessage0(booleanClass, "TRUE");
+        falseObject = context->SendMessage0(booleanClass, "FALSE");
+        anchors = context->GetObjectVariable("ANCHORS");
+        anchorMap = context->GetObjectVariable("ANCHORMAP");
+        mergeSourceMap = context->GetObjectVariable("MERGESOURCEMAP");
+        directivesMap = context->GetObjectVariable("DIRECTIVESMAP");
+    }
+
+    ~YamlParser()
+    {
+        free(lineData);
+        free(lineLength);
+        free(lineEpoch);
+    }
+
+    void setInput(RexxArrayObject input, size_t offset);
+    bool load();
+    RexxObjectPtr parseOneDoc();
+    RexxObjectPtr parseDocs(RexxArrayObject docs, bool hadDocEnd, size_t limit);
+    RexxObjectPtr delegate(const char *method, RexxArrayObject args);
+
+    size_t position()
+    {
+        return pos;
+    }
+
+    RexxArrayObject saveState();
+    void restoreState(RexxArrayObject saved);
+
+  private:
+    RexxObjectPtr blockNode(int minIndent, bool hasScalarParent, int scalarParentIndent);
+    RexxObjectPtr blockMap(int blockIndent);
+    RexxObjectPtr mapValue(YamlText valPart, int parentIndent);
+    RexxObjectPtr blockSeq(int blockIndent);
+    RexxObjectPtr compactMap(YamlText firstLine, int virtualIndent);
+    RexxObjectPtr plainContinuation(YamlText first, int minIndent, bool hasSeqIndent, int seqIndent);
+    RexxObjectPtr quotedValue(YamlText text, int minIndent);
+    RexxObjectPtr resolve(const char *text, size_t length);
+    RexxObjectPtr unquoteIfNeeded(YamlText text);
+    RexxObjectPtr getAnchor(YamlText name);
+    bool registerAnchor(YamlText name, RexxObjectPtr node);
+    bool applyMerges(RexxObjectPtr map, RexxArrayObject merges);
+    RexxObjectPtr parseDirectives();
+    RexxObjectPtr documentNode();
+    bool consumeDocEnd(bool &found);
+    bool isDocumentStart();
+    bool endsPlain(YamlText line, YamlText content, bool hasSeqIndent, int seqIndent);
+    void setLine(size_t i, YamlText text, int indent);
+
+    YamlText line(size_t i)
+    {
+        // Rexx code we delegated to may have replaced lines
+        if (lineEpoch[i] != epoch)
+        {
+            RexxObjectPtr string = context->ArrayAt(lines, i);
+            lineData[i] = context->StringData((RexxStringObject)string);
+            lineLength[i] = context->StringLength((RexxStringObject)string);
+            lineEpoch[i] = epoch;
+        }
+        return YamlText(lineData[i], lineLength[i]);
+    }
+
+    // skipBlanks and skipBlanksOnly: pass blank and comment lines
+    void skipBlanks()
+    {
+        while (pos <= lineCount)
+        {
+            YamlText content = strip(line(pos));
+            if (content.length != 0 && content.data[0] != '#')
+            {
+                break;
+            }
+            pos++;
+        }
+    }
+
+    inline RexxObjectPtr string(YamlText text)
+    {
+        return context->NewString(text.data, text.length);
+    }
+
+    inline RexxObjectPtr number(int n)
+    {
+        return context->WholeNumberToObject(n);
+    }
+
+    inline RexxObjectPtr newTable()
+    {
+        return context->SendMessage0(tableClass, "NEW");
+    }
+
+    inline bool isTable(RexxObjectPtr o)
+    {
+        return o != context->Nil() && context->IsInstanceOf(o, tableClass);
+    }
+
+    inline bool put(RexxObjectPtr collection, RexxObjectPtr value, RexxObjectPtr index)
+    {
+        context->SendMessage2(collection, "PUT", value, index);
+        return !context->CheckCondition();
+    }
+
+    // drop our local reference to a value once it has been stored,
+    // so a large document doesn't pile up references
+    inline void release(RexxObjectPtr value)
+    {
+        if (value != trueObject && value != falseObject && value != context->Nil())
+        {
+            context->ReleaseLocalReference(value);
+        }
+    }
+
+    RexxMethodContext *context;        // the method call context
+    RexxObjectPtr   self;              // the Yaml object
+    RexxArrayObject lines;             // its lines array
+    size_t          lineCount;         // lines~items
+    const char    **lineData;          // string data of the lines
+    size_t         *lineLength;        // and their lengths
+    size_t         *lineEpoch;         // when a line was fetched
+    size_t          epoch;             // bumped whenever Rexx code ran
+    size_t          pos;               // the current line
+    RexxClassObject tableClass;        // the .Table class
+    RexxObjectPtr   trueObject;        // .YamlBoolean~true
+    RexxObjectPtr   falseObject;       // .YamlBoolean~false
+    RexxObjectPtr   anchors;           // anchor name -> node
+    RexxObjectPtr   anchorMap;         // node -> anchor name
+    RexxObjectPtr   mergeSourceMap;    // mapping -> merged mappings
+    RexxObjectPtr   directivesMap;     // document -> directives
+    YamlBuffer      plain;             // collects plain scalars
+    YamlBuffer      quoted;            // collects quoted scalars
+};
+
+
+/*************************************************************/
+/* YamlParser::setInput                                      */
+/*                                                           */
+/* make a piece of the input the lines of the Yaml object,   */
+/* starting at its first line. offset is the number of input */
+/* lines before the piece, for the line numbers of errors.   */
+/*************************************************************/
+void YamlParser::setInput(RexxArrayObject input, size_t offset)
+{
+    if (lines != NULLOBJECT)
+    {
+        context->ReleaseLocalReference(lines);
+    }
+    lines = input;
+    pos = 1;
+    context->SetObjectVariable("LINES", lines);
+    context->SetObjectVariable("POS", context->StringSizeToObject(pos));
+    context->SetObjectVariable("LINEOFFSET", context->StringSizeToObject(offset));
+}
+
+
+/*************************************************************/
+/* YamlParser::saveState                                     */
+/*                                                           */
+/* copies of the anchors and of the maps the parse adds to,  */
+/* so restoreState can undo what parsing a piece did.        */
+/*************************************************************/
+RexxArrayObject YamlParser::saveState()
+{
+    RexxArrayObject saved = context->NewArray(4);
+    context->ArrayPut(saved, context->SendMessage0(anchors, "COPY"), 1);
+    context->ArrayPut(saved, context->SendMessage0(anchorMap, "COPY"), 2);
+    context->ArrayPut(saved, context->SendMessage0(mergeSourceMap, "COPY"), 3);
+    context->ArrayPut(saved, context->SendMessage0(directivesMap, "COPY"), 4);
+    return saved;
+}
+
+
+/*************************************************************/
+/* YamlParser::restoreState                                  */
+/*                                                           */
+/* go back to what saveState saved, which stays as it is.    */
+/*************************************************************/
+void YamlParser::restoreState(RexxArrayObject saved)
+{
+    anchors = context->SendMessage0(context->ArrayAt(saved, 1), "COPY");
+    anchorMap = context->SendMessage0(context->ArrayAt(saved, 2), "COPY");
+    mergeSourceMap = context->SendMessage0(context->ArrayAt(saved, 3), "COPY");
+    directivesMap = context->SendMessage0(context->ArrayAt(saved, 4), "COPY");
+    context->SetObjectVariable("ANCHORS", anchors);
+    context->SetObjectVariable("ANCHORMAP", anchorMap);
+    context->SetObjectVariable("MERGESOURCEMAP", mergeSourceMap);
+    context->SetObjectVariable("DIRECTIVESMAP", directivesMap);
+}
+
+
+/*************************************************************/
+/* YamlParser::load                                          */
+/*                                                           */
+/* pick up the lines setInput gave us. returns false if      */
+/* they aren't all strings, or if any contains a tab or      */
+/* another control character, which we leave to yaml.cls.    */
+/*************************************************************/
+bool YamlParser::load()
+{
+    free(lineData);
+    free(lineLength);
+    free(lineEpoch);
+    epoch++;
+    lineCount = context->ArrayItems(lines);
+    lineData = (const char **)malloc((lineCount + 1) * sizeof(const char *));
+    lineLength = (size_t *)malloc((lineCount + 1) * sizeof(size_t));
+    lineEpoch = (size_t *)calloc(lineCount + 1, sizeof(size_t));
+
+    for (size_t i = 1; i <= lineCount; i++)
+    {
+        RexxObjectPtr string = context->ArrayAt(lines, i);
+        if (string == NULLOBJECT || !context->IsString(string))
+        {
+            return false;
+        }
+        const char *data = context->StringData((RexxStringObject)string);
+        size_t length = context->StringLength((RexxStringObject)string);
+        for (size_t j = 0; j < length; j++)
+        {
+            if ((unsigned char)data[j] < 0x20)
+            {
+                return false;
+            }
+        }
+        lineData[i] = data;
+        lineLength[i] = length;
+        lineEpoch[i] = epoch;
+    }
+    return true;
+}
+
+
+/*************************************************************/
+/* YamlParser::delegate                                      */
+/*                                                           */
+/* run one of the private yaml.cls parsing methods. the Rexx */
+/* method sees our position and may move it or change lines, */
+/* so both are picked up again afterwards. an error raised   */
+/* by the method stays pending and ends the parse.           */
+/*************************************************************/
+RexxObjectPtr YamlParser::delegate(const char *method, RexxArrayObject args)
+{
+    context->SetObjectVariable("POS", context->StringSizeToObject(pos));
+    RexxObjectPtr result = context->SendMessage(self, method, args);
+    context->ReleaseLocalReference(args);
+    epoch++;
+
+    size_t newPos;
+    if (context->CheckCondition())
+    {
+        return NULLOBJECT;
+    }
+    if (result == NULLOBJECT ||
+        !context->ObjectToStringSize(context->GetObjectVariable("POS"), &newPos))
+    {
+        return NULLOBJECT;
+    }
+    pos = newPos;
+    return result;
+}
+
+
+/*************************************************************/
+/* YamlParser::setLine                                       */
+/*                                                           */
+/* replace a line with the given text, indented by the given */
+/* number of blanks (lines[i] = copies(" ", indent) || text) */
+/*************************************************************/
+void YamlParser::setLine(size_t i, YamlText text, int indent)
+{
+    quoted.clear();
+    for (int n = 0; n < indent; n++)
+    {
+        quoted.append(' ');
+    }
+    quoted.append(text.data, text.length);
+    RexxObjectPtr string = context->NewString(quoted.buffer, quoted.length);
+    context->ArrayPut(lines, string, i);
+    lineData[i] = context->StringData((RexxStringObject)string);
+    lineLength[i] = context->StringLength((RexxStringObject)string);
+    lineEpoch[i] = epoch;
+}
+
+
+/*************************************************************/
+/* YamlParser::parseDirectives                               */
+/*                                                           */
+/* the %YAML and %TAG directives of a document are left to   */
+/* yaml.cls. returns the directives or .nil.                 */
+/*************************************************************/
+RexxObjectPtr YamlParser::parseDirectives()
+{
+    RexxObjectPtr directives = delegate("PARSEDIRECTIVES", context->NewArray(0));
+    if (directives != NULLOBJECT)
+    {
+        context->SetObjectVariable("CURRENTDIRECTIVES", directives);
+    }
+    return directives;
+}
+
+
+/*************************************************************/
+/* YamlParser::documentNode                                  */
+/*                                                           */
+/* parse the root node of a document, after skipping its     */
+/* '---'. an empty document becomes an empty .Table.         */
+/*************************************************************/
+RexxObjectPtr YamlParser::documentNode()
+{
+    // skipDocStart returns "" for a bare '---', .false if there is
+    // none, and otherwise the content following it on the same line
+    RexxObjectPtr residual = delegate("SKIPDOCSTART", context->NewArray(0));
+    if (residual == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    RexxStringObject text = context->ObjectToString(residual);
+    size_t length = context->StringLength(text);
+    bool startLine = length > 1 || (length == 1 && context->StringData(text)[0] != '0');
+
+    RexxObjectPtr doc = blockNode(startLine ? -1 : 0, false, 0);
+    if (doc == context->Nil())
+    {
+        doc = newTable();
+    }
+    return doc;
+}
+
+
+/*************************************************************/
+/* YamlParser::consumeDocEnd                                 */
+/*                                                           */
+/* skip the '...' ending a document, if there is one.        */
+/*************************************************************/
+bool YamlParser::consumeDocEnd(bool &found)
+{
+    RexxObjectPtr result = delegate("CONSUMEDOCEND", context->NewArray(0));
+    logical_t value;
+    if (result == NULLOBJECT || !context->ObjectToLogical(result, &value))
+    {
+        return false;
+    }
+    found = value != 0;
+    return true;
+}
+
+
+/*************************************************************/
+/* YamlParser::isDocumentStart                               */
+/*                                                           */
+/* check if the current line is a '---' document start.      */
+/*************************************************************/
+bool YamlParser::isDocumentStart()
+{
+    if (pos > lineCount)
+    {
+        return false;
+    }
+    YamlText peek = strip(line(pos));
+    return peek.startsWith("---") && (peek.length == 3 || peek.data[3] == ' ' || peek.data[3] == '\t');
+}
+
+
+/*************************************************************/
+/* YamlParser::parseOneDoc                                   */
+/*                                                           */
+/* parse the first document of the input.                    */
+/*************************************************************/
+RexxObjectPtr YamlParser::parseOneDoc()
+{
+    RexxObjectPtr directives = parseDirectives();
+    if (directives == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    RexxObjectPtr doc = documentNode();
+    bool found;
+    if (doc == NULLOBJECT || !consumeDocEnd(found))
+    {
+        return NULLOBJECT;
+    }
+    if (directives != context->Nil() && !put(directivesMap, directives, doc))
+    {
+        return NULLOBJECT;
+    }
+    context->SetObjectVariable("POS", context->StringSizeToObject(pos));
+    return doc;
+}
+
+
+/*************************************************************/
+/* YamlParser::parseDocs                                     */
+/*                                                           */
+/* parse the documents that start at or before line limit    */
+/* and append them to docs (parseMoreDocs). hadDocEnd tells  */
+/* if the document before them ended with '...'. returns     */
+/* .true or .false for the last document parsed, or .nil if  */
+/* the rest of the input is not to be parsed.                */
+/*************************************************************/
+RexxObjectPtr YamlParser::parseDocs(RexxArrayObject docs, bool hadDocEnd, size_t limit)
+{
+    while (pos <= limit)
+    {
+        skipBlanks();
+        if (pos > limit)
+        {
+            break;
+        }
+        size_t savedPos = pos;
+        RexxObjectPtr directives = parseDirectives();
+        if (directives == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        size_t count = context->ArrayItems(docs);
+        if (directives != context->Nil())
+        {
+            // directives between documents need a '...' before them and
+            // a '---' after them; without the '---', what looked like a
+            // directive ends the stream (unless it is the first document)
+            if (count > 0 && !hadDocEnd)
+            {
+                return NULLOBJECT;
+            }
+            skipBlanks();
+            if (!isDocumentStart())
+            {
+                if (count == 0)
+                {
+                    return NULLOBJECT;
+                }
+                pos = savedPos;
+                context->SetObjectVariable("POS", context->StringSizeToObject(pos));
+                return context->Nil();
+            }
+        }
+        // content after a document without '...' must start a new one
+        if (count > 0 && !hadDocEnd && directives == context->Nil() && !isDocumentStart())
+        {
+            return NULLOBJECT;
+        }
+
+        RexxObjectPtr doc = documentNode();
+        if (doc == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        if (directives != context->Nil() && !put(directivesMap, directives, doc))
+        {
+            return NULLOBJECT;
+        }
+        context->ArrayAppend(docs, doc);
+        if (!consumeDocEnd(hadDocEnd))
+        {
+            return NULLOBJECT;
+        }
+    }
+
+    context->SetObjectVariable("POS", context->StringSizeToObject(pos));
+    return hadDocEnd ? context->True() : context->False();
+}
+
+
+/*************************************************************/
+/* YamlParser::blockNode                                     */
+/*                                                           */
+/* parse the node starting at the current line: a block      */
+/* sequence, a block mapping or a plain scalar. for anything */
+/* else, the whole node is parsed by yaml.cls.               */
+/*************************************************************/
+RexxObjectPtr YamlParser::blockNode(int minIndent, bool hasScalarParent, int scalarParentIndent)
+{
+    skipBlanks();
+    if (pos > lineCount)
+    {
+        return context->Nil();
+    }
+
+    YamlText text = line(pos);
+    int indent = indentOf(text);
+    if (indent < minIndent)
+    {
+        return context->Nil();
+    }
+    YamlText content = strip(text);
+
+    // anchors, aliases, tags, complex keys, flow collections, quoted and
+    // block scalars and the reserved indicators
+    if (strchr("&*!?[{|>\"'%@`", content.data[0]) != NULL)
+    {
+        RexxArrayObject args = context->ArrayOfTwo(number(minIndent),
+            hasScalarParent ? number(scalarParentIndent) : context->Nil());
+        return delegate("BLOCKNODE", args);
+    }
+
+    if (isSequenceEntry(content))
+    {
+        // not allowed on the '---' line, let yaml.cls complain
+        if (minIndent < 0)
+        {
+            return NULLOBJECT;
+        }
+        return blockSeq(indent);
+    }
+
+    if (findMapColon(content) > 0)
+    {
+        if (minIndent < 0)
+        {
+            return NULLOBJECT;
+        }
+        return blockMap(indent);
+    }
+
+    // blockScalarOrPlain for a plain scalar
+    YamlText stripped;
+    bool comment = stripComment(content, stripped);
+    pos++;
+    // a trailing comment ends the scalar right away
+    if (comment)
+    {
+        return resolve(stripped.data, stripped.length);
+    }
+    return plainContinuation(stripped, minIndent < 0 ? minIndent : indent, false, 0);
+}
+
+
+/*************************************************************/
+/* YamlParser::blockMap                                      */
+/*                                                           */
+/* parse a block mapping at the given indentation, including */
+/* alias keys and merge keys (<<). entries with an anchor or */
+/* a tag before the key, and complex keys (?), make us give  */
+/* up.                                                       */
+/*************************************************************/
+RexxObjectPtr YamlParser::blockMap(int blockIndent)
+{
+    RexxObjectPtr map = newTable();
+    RexxArrayObject merges = context->NewArray(0);
+
+    while (pos <= lineCount)
+    {
+        skipBlanks();
+        if (pos > lineCount)
+        {
+            break;
+        }
+
+        YamlText text = line(pos);
+        int indent = indentOf(text);
+        if (indent != blockIndent)
+        {
+            break;
+        }
+        YamlText content = strip(text);
+        if (content.startsWith('&') || content.startsWith("? ") || content.equals("?"))
+        {
+            return NULLOBJECT;
+        }
+
+        size_t colonPos = findMapColon(content);
+        if (colonPos == 0)
+        {
+            break;
+        }
+        YamlText key = strip(content.left(colonPos - 1));
+        YamlText valPart = strip(content.from(colonPos));
+        // the colon is followed by a blank, so this is a comment
+        if (valPart.startsWith('#'))
+        {
+            valPart = YamlText();
+        }
+        if (key.startsWith('!'))
+        {
+            return NULLOBJECT;
+        }
+
+        RexxObjectPtr keyObject = unquoteIfNeeded(key);
+        if (keyObject == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        RexxStringObject keyString = (RexxStringObject)keyObject;
+        YamlText keyText(context->StringData(keyString), context->StringLength(keyString));
+        // alias keys: *name stands for the anchored value
+        if (keyText.startsWith('*'))
+        {
+            keyObject = getAnchor(extractAliasName(keyText.from(1)));
+            if (keyObject == NULLOBJECT)
+            {
+                return NULLOBJECT;
+            }
+        }
+        pos++;
+
+        // "a: b: c" is an error, let yaml.cls report it
+        if (valPart.length > 0 && strchr("&*!'\"[{", valPart.data[0]) == NULL && findMapColon(valPart) > 0)
+        {
+            return NULLOBJECT;
+        }
+
+        RexxObjectPtr value = mapValue(valPart, indent);
+        if (value == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+
+        // key == "<<", which can only be true for a string
+        bool mergeKey = false;
+        if (context->IsString(keyObject))
+        {
+            RexxStringObject s = (RexxStringObject)keyObject;
+            mergeKey = context->StringLength(s) == 2 && memcmp(context->StringData(s), "<<", 2) == 0;
+        }
+
+        if (mergeKey)
+        {
+            if (context->IsArray(value))
+            {
+                RexxArrayObject items = (RexxArrayObject)value;
+                size_t size = context->ArraySize(items);
+                for (size_t i = 1; i <= size; i++)
+                {
+                    RexxObjectPtr item = context->ArrayAt(items, i);
+                    if (item != NULLOBJECT && isTable(item))
+                    {
+                        context->ArrayAppend(merges, item);
+                    }
+                }
+            }
+            else if (isTable(value))
+            {
+                context->ArrayAppend(merges, value);
+            }
+        }
+        else
+        {
+            if (!put(map, value, keyObject))
+            {
+                return NULLOBJECT;
+            }
+            release(value);
+            release(keyObject);
+        }
+    }
+
+    if (context->ArrayItems(merges) > 0)
+    {
+        if (!applyMerges(map, merges))
+        {
+            return NULLOBJECT;
+        }
+    }
+    context->ReleaseLocalReference(merges);
+    return map;
+}
+
+
+/*************************************************************/
+/* YamlParser::applyMerges                                   */
+/*                                                           */
+/* add the entries of the merged mappings that the mapping   */
+/* doesn't have itself, the first merged mapping wins, and   */
+/* record the merged mappings in mergeSourceMap.             */
+/*************************************************************/
+bool YamlParser::applyMerges(RexxObjectPtr map, RexxArrayObject merges)
+{
+    for (size_t i = context->ArrayItems(merges); i >= 1; i--)
+    {
+        RexxObjectPtr supplier = context->SendMessage0(context->ArrayAt(merges, i), "SUPPLIER");
+        if (supplier == NULLOBJECT)
+        {
+            return false;
+        }
+        while (context->SupplierAvailable((RexxSupplierObject)supplier))
+        {
+            RexxObjectPtr index = context->SupplierIndex((RexxSupplierObject)supplier);
+            RexxObjectPtr hasIndex = context->SendMessage1(map, "HASINDEX", index);
+            if (hasIndex == NULLOBJECT)
+            {
+                return false;
+            }
+            if (hasIndex != context->True())
+            {
+                if (!put(map, context->SupplierItem((RexxSupplierObject)supplier), index))
+                {
+                    return false;
+                }
+            }
+            context->SupplierNext((RexxSupplierObject)supplier);
+        }
+    }
+    return put(mergeSourceMap, merges, map);
+}
+
+
+/*************************************************************/
+/* YamlParser::mapValue                                      */
+/*                                                           */
+/* parse the value of a mapping entry: a node on the lines   */
+/* below, an alias, a quoted scalar or a plain scalar. tags, */
+/* block scalars, flow collections and anchors are handed to */
+/* yaml.cls.                                                 */
+/*************************************************************/
+RexxObjectPtr YamlParser::mapValue(YamlText valPart, int parentIndent)
+{
+    if (valPart.length > 0 && strchr("!|>[{&", valPart.data[0]) != NULL)
+    {
+        return delegate("MAPVALUE", context->ArrayOfTwo(string(valPart), number(parentIndent)));
+    }
+
+    if (valPart.length == 0)
+    {
+        skipBlanks();
+        if (pos > lineCount)
+        {
+            return context->Nil();
+        }
+        YamlText text = line(pos);
+        int ni = indentOf(text);
+        YamlText nextContent = strip(text);
+        if (ni > parentIndent)
+        {
+            // a standalone anchor line
+            if (nextContent.startsWith('&'))
+            {
+                return delegate("MAPVALUE", context->ArrayOfTwo(string(valPart), number(parentIndent)));
+            }
+            return blockNode(ni, true, parentIndent);
+        }
+        // a compact sequence at the indentation of the key
+        if (ni == parentIndent && isSequenceEntry(nextContent))
+        {
+            return blockSeq(ni);
+        }
+        return context->Nil();
+    }
+
+    if (valPart.startsWith('*'))
+    {
+        return getAnchor(extractAliasName(valPart.from(1)));
+    }
+
+    if (valPart.startsWith('"') || valPart.startsWith('\''))
+    {
+        return quotedValue(valPart, parentIndent + 1);
+    }
+
+    YamlText stripped;
+    if (stripComment(valPart, stripped))
+    {
+        return resolve(stripped.data, stripped.length);
+    }
+    return plainContinuation(stripped, parentIndent + 1, false, 0);
+}
+
+
+/*************************************************************/
+/* YamlParser::blockSeq                                      */
+/*                                                           */
+/* parse a block sequence at the given indentation. a tag on */
+/* an entry makes us give up.                                */
+/*************************************************************/
+RexxObjectPtr YamlParser::blockSeq(int blockIndent)
+{
+    RexxArrayObject arr = context->NewArray(0);
+
+    while (pos <= lineCount)
+    {
+        skipBlanks();
+        if (pos > lineCount)
+        {
+            break;
+        }
+
+        YamlText text = line(pos);
+        int indent = indentOf(text);
+        if (indent != blockIndent)
+        {
+            break;
+        }
+        YamlText content = strip(text);
+        if (!isSequenceEntry(content))
+        {
+            break;
+        }
+
+        YamlText afterDash = strip(content.from(1));
+        if (afterDash.startsWith('!'))
+        {
+            return NULLOBJECT;
+        }
+        if (afterDash.startsWith('#'))
+        {
+            afterDash = YamlText();
+        }
+        pos++;
+
+        RexxObjectPtr node;
+        char first = afterDash.length > 0 ? afterDash.data[0] : '\0';
+
+        if (afterDash.length == 0)
+        {
+            skipBlanks();
+            node = context->Nil();
+            if (pos <= lineCount)
+            {
+                int ni = indentOf(line(pos));
+                if (ni > blockIndent)
+                {
+                    node = blockNode(ni, false, 0);
+                }
+            }
+        }
+        else if (isBlockIndicator(afterDash))
+        {
+            node = delegate("PARSEBLOCKSCALAR", context->ArrayOfTwo(string(afterDash), number(indent)));
+        }
+        else if (first == '[' || first == '{')
+        {
+            char closeBr = first == '[' ? ']' : '}';
+            size_t ep = matchBracket(afterDash, first, closeBr);
+            YamlText afterBracket = afterDash.from(ep);
+            YamlText residual = strip(afterBracket);
+            // only a comment may follow
+            if (residual.length > 0 && (residual.data[0] != '#' || afterBracket.data[0] != ' '))
+            {
+                return NULLOBJECT;
+            }
+            context->SetObjectVariable("FLOWMININDENT", number(blockIndent + 1));
+            node = delegate(first == '[' ? "FLOWSEQ" : "FLOWMAP", context->ArrayOfOne(string(afterDash.left(ep))));
+        }
+        else if (findMapColon(afterDash) > 0)
+        {
+            node = compactMap(afterDash, indent + 2);
+        }
+        else if (first == '&')
+        {
+            // parse var afterDash aTag rest
+            size_t blank = 0;
+            while (blank < afterDash.length && afterDash.data[blank] != ' ')
+            {
+                blank++;
+            }
+            YamlText name = afterDash.left(blank).from(1);
+            YamlText rest = strip(afterDash.from(blank));
+            if (rest.length == 0)
+            {
+                skipBlanks();
+                node = context->Nil();
+                if (pos <= lineCount)
+                {
+                    int ni = indentOf(line(pos));
+                    if (ni > blockIndent)
+                    {
+                        node = blockNode(ni, false, 0);
+                    }
+                }
+            }
+            else
+            {
+                YamlText stripped;
+                stripComment(rest, stripped);
+                node = resolve(stripped.data, stripped.length);
+            }
+            if (node != NULLOBJECT && !registerAnchor(name, node))
+            {
+                return NULLOBJECT;
+            }
+        }
+        else if (first == '*')
+        {
+            YamlText name = afterDash.from(1);
+            for (size_t i = 0; i + 1 < name.length; i++)
+            {
+                if (name.data[i] == ' ' && name.data[i + 1] == '#')
+                {
+                    name = strip(name.left(i));
+                    break;
+                }
+            }
+            node = getAnchor(strip(name));
+        }
+        else if (isSequenceEntry(afterDash))
+        {
+            // "- - item": the inner sequence gets a line of its own
+            setLine(pos - 1, afterDash, indent + 2);
+            pos--;
+            node = blockSeq(indent + 2);
+        }
+        else if (first == '"' || first == '\'')
+        {
+            node = quotedValue(afterDash, blockIndent + 1);
+        }
+        else
+        {
+            YamlText stripped;
+            if (stripComment(afterDash, stripped))
+            {
+                node = resolve(stripped.data, stripped.length);
+            }
+            else
+            {
+                node = plainContinuation(stripped, indent + 1, true, indent);
+            }
+        }
+
+        if (node == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        context->ArrayAppend(arr, node);
+        release(node);
+    }
+    return arr;
+}
+
+
+/*************************************************************/
+/* YamlParser::compactMap                                    */
+/*                                                           */
+/* parse a mapping that starts on the line of a sequence     */
+/* entry ("- key: value"); further entries follow at the     */
+/* virtual indentation or deeper.                            */
+/*************************************************************/
+RexxObjectPtr YamlParser::compactMap(YamlText firstLine, int virtualIndent)
+{
+    RexxObjectPtr map = newTable();
+
+    size_t colonPos = findMapColon(firstLine);
+    RexxObjectPtr key = unquoteIfNeeded(strip(firstLine.left(colonPos - 1)));
+    if (key == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    RexxObjectPtr value = mapValue(strip(firstLine.from(colonPos)), virtualIndent - 2);
+    if (value == NULLOBJECT || !put(map, value, key))
+    {
+        return NULLOBJECT;
+    }
+    release(value);
+    release(key);
+
+    while (pos <= lineCount)
+    {
+        skipBlanks();
+        if (pos > lineCount)
+        {
+            break;
+        }
+        YamlText text = line(pos);
+        int indent = indentOf(text);
+        if (indent < virtualIndent)
+        {
+            break;
+        }
+        YamlText content = strip(text);
+        colonPos = findMapColon(content);
+        if (colonPos == 0)
+        {
+            break;
+        }
+        key = unquoteIfNeeded(strip(content.left(colonPos - 1)));
+        if (key == NULLOBJECT)
+        {
+            return NULLOBJECT;
+        }
+        YamlText valPart = strip(content.from(colonPos));
+        pos++;
+        value = mapValue(valPart, indent);
+        if (value == NULLOBJECT || !put(map, value, key))
+        {
+            return NULLOBJECT;
+        }
+        release(value);
+        release(key);
+    }
+    return map;
+}
+
+
+/*************************************************************/
+/* YamlParser::endsPlain                                     */
+/*                                                           */
+/* check if a line ends a multi-line plain scalar: document  */
+/* markers, sequence entries, mapping entries and comments.  */
+/*************************************************************/
+bool YamlParser::endsPlain(YamlText text, YamlText content, bool hasSeqIndent, int seqIndent)
+{
+    if (isDocumentMarker(content))
+    {
+        return true;
+    }
+    if (isSequenceEntry(content) && (!hasSeqIndent || indentOf(text) == seqIndent))
+    {
+        return true;
+    }
+    return findMapColon(content) > 0 || content.startsWith('#');
+}
+
+
+/*************************************************************/
+/* YamlParser::plainContinuation                             */
+/*                                                           */
+/* collect the continuation lines of a plain scalar. lines   */
+/* are joined with a blank, blank lines in between become    */
+/* newlines, but only if the scalar continues after them.    */
+/*************************************************************/
+RexxObjectPtr YamlParser::plainContinuation(YamlText first, int minIndent, bool hasSeqIndent, int seqIndent)
+{
+    size_t newlines = 0;
+
+    plain.clear();
+    plain.append(first.data, first.length);
+
+    while (pos <= lineCount)
+    {
+        YamlText text = line(pos);
+        YamlText content = strip(text);
+
+        if (content.length == 0)
+        {
+            size_t blankCount = 0;
+            size_t lookahead = pos;
+            while (lookahead <= lineCount && strip(line(lookahead)).length == 0)
+            {
+                blankCount++;
+                lookahead++;
+            }
+            if (lookahead > lineCount)
+            {
+                break;
+            }
+            YamlText laLine = line(lookahead);
+            if (indentOf(laLine) < minIndent || endsPlain(laLine, strip(laLine), hasSeqIndent, seqIndent))
+            {
+                break;
+            }
+            newlines += blankCount;
+            pos = lookahead;
+            continue;
+        }
+
+        if (indentOf(text) < minIndent || endsPlain(text, content, hasSeqIndent, seqIndent))
+        {
+            break;
+        }
+        YamlText stripped;
+        bool comment = stripComment(content, stripped);
+        // a newline replaces the blank that would join the lines
+        if (newlines > 0)
+        {
+            for (; newlines > 0; newlines--)
+            {
+                plain.append('\n');
+            }
+        }
+        else
+        {
+            plain.append(' ');
+        }
+        plain.append(stripped.data, stripped.length);
+        pos++;
+        if (comment)
+        {
+            break;
+        }
+    }
+    return resolve(plain.buffer, plain.length);
+}
+
+
+/*************************************************************/
+/* YamlParser::quotedValue                                   */
+/*                                                           */
+/* parse a quoted scalar (multiLineQuoted), which may only   */
+/* be followed by a comment.                                 */
+/*************************************************************/
+RexxObjectPtr YamlParser::quotedValue(YamlText text, int minIndent)
+{
+    RexxObjectPtr value;
+    YamlText rest;
+
+    if (simpleQuoted(text, quoted, rest))
+    {
+        value = context->NewString(quoted.buffer, quoted.length);
+    }
+    else
+    {
+        RexxObjectPtr pair = delegate("MULTILINEQUOTED", context->ArrayOfTwo(string(text), number(minIndent)));
+        if (pair == NULLOBJECT || !context->IsArray(pair))
+        {
+            return NULLOBJECT;
+        }
+        value = context->ArrayAt((RexxArrayObject)pair, 1);
+        RexxStringObject restString = context->ObjectToString(context->ArrayAt((RexxArrayObject)pair, 2));
+        rest = YamlText(context->StringData(restString), context->StringLength(restString));
+    }
+
+    // the comment must be separated by a blank
+    YamlText trailing = strip(rest);
+    if (trailing.length > 0 && (trailing.data[0] != '#' || rest.data[0] != ' '))
+    {
+        return NULLOBJECT;
+    }
+    return value;
+}
+
+
+/*************************************************************/
+/* YamlParser::resolve                                       */
+/*                                                           */
+/* resolve a plain scalar according to the core schema:      */
+/* null, booleans, numbers or a string. whole numbers of up  */
+/* to nine digits are normalized here; all other numbers,    */
+/* and anything that might be one, go to the resolve method  */
+/* of yaml.cls, which needs Rexx arithmetic for them.        */
+/*************************************************************/
+RexxObjectPtr YamlParser::resolve(const char *text, size_t length)
+{
+    static const char *nullWords[] = { "null", "Null", "NULL", "~", NULL };
+    static const char *trueWords[] = { "true", "True", "TRUE", "yes", "Yes", "YES", "on", "On", "ON", NULL };
+    static const char *falseWords[] = { "false", "False", "FALSE", "no", "No", "NO", "off", "Off", "OFF", NULL };
+
+    YamlText value(text, length);
+    if (value.startsWith('"') || value.startsWith('\''))
+    {
+        return delegate("RESOLVE", context->ArrayOfOne(string(value)));
+    }
+    for (int i = 0; nullWords[i] != NULL; i++)
+    {
+        if (value.equals(nullWords[i]))
+        {
+            return context->Nil();
+        }
+    }
+    for (int i = 0; trueWords[i] != NULL; i++)
+    {
+        if (value.equals(trueWords[i]))
+        {
+            return trueObject;
+        }
+    }
+    for (int i = 0; falseWords[i] != NULL; i++)
+    {
+        if (value.equals(falseWords[i]))
+        {
+            return falseObject;
+        }
+    }
+
+    // plain = text~changeStr("_", ""), and see what it could be
+    char number[16];
+    size_t digits = 0;
+    size_t significant = 0;
+    bool negative = false;
+    bool whole = true;
+    bool numeric = true;
+    size_t plainLength = 0;
+    char lead[6];
+
+    for (size_t i = 0; i < length; i++)
+    {
+        char c = text[i];
+        if (c == '_')
+        {
+            continue;
+        }
+        if (plainLength < sizeof(lead))
+        {
+            lead[plainLength] = (char)(c >= 'A' && c <= 'Z' ? c + 'a' - 'A' : c);
+        }
+        if (c >= '0' && c <= '9')
+        {
+            digits++;
+            // leading zeros go away when adding 0
+            if (significant > 0 || c != '0')
+            {
+                if (significant < sizeof(number))
+                {
+                    number[significant] = c;
+                }
+                significant++;
+            }
+        }
+        else if ((c == '+' || c == '-') && plainLength == 0)
+        {
+            negative = c == '-';
+        }
+        else
+        {
+            whole = false;
+            if (strchr(" \n+-.eE", c) == NULL)
+            {
+                numeric = false;
+            }
+        }
+        plainLength++;
+    }
+
+    // a whole number that fits into NUMERIC DIGITS 9, i.e. plain + 0
+    if (whole && digits > 0 && digits <= 9)
+    {
+        if (significant == 0)
+        {
+            return context->NewString("0", 1);
+        }
+        char result[16];
+        size_t n = 0;
+        if (negative)
+        {
+            result[n++] = '-';
+        }
+        memcpy(result + n, number, significant);
+        return context->NewString(result, n + significant);
+    }
+
+    // other numbers, 0x and 0o prefixes, .inf and .nan
+    bool special = false;
+    if (plainLength > 2 && lead[0] == '0' && (lead[1] == 'x' || lead[1] == 'o'))
+    {
+        special = true;
+    }
+    else if (plainLength == 4 || plainLength == 5)
+    {
+        special = memcmp(lead, ".inf", 4) == 0 || memcmp(lead, ".nan", 4) == 0 ||
+                  (plainLength == 5 && (memcmp(lead, "+.inf", 5) == 0 || memcmp(lead, "-.inf", 5) == 0));
+    }
+    if (special || (numeric && plainLength > 0))
+    {
+        return delegate("RESOLVE", context->ArrayOfOne(string(value)));
+    }
+    return context->NewString(text, length);
+}
+
+
+/*************************************************************/
+/* YamlParser::unquoteIfNeeded                               */
+/*                                                           */
+/* the string value of a mapping key, which is unquoted if   */
+/* it is a quoted scalar.                                    */
+/*************************************************************/
+RexxObjectPtr YamlParser::unquoteIfNeeded(YamlText text)
+{
+    if (!text.startsWith('"') && !text.startsWith('\''))
+    {
+        return string(text);
+    }
+    YamlText rest;
+    if (simpleQuoted(text, quoted, rest))
+    {
+        return context->NewString(quoted.buffer, quoted.length);
+    }
+    RexxObjectPtr result = delegate("UNQUOTEIFNEEDED", context->ArrayOfOne(string(text)));
+    return result == NULLOBJECT ? NULLOBJECT : (RexxObjectPtr)context->ObjectToString(result);
+}
+
+
+/*************************************************************/
+/* YamlParser::getAnchor                                     */
+/*                                                           */
+/* the value of a previously defined anchor. unknown anchors */
+/* are an error.                                             */
+/*************************************************************/
+RexxObjectPtr YamlParser::getAnchor(YamlText name)
+{
+    RexxObjectPtr index = string(name);
+    RexxObjectPtr known = context->SendMessage1(anchors, "HASINDEX", index);
+    if (known != context->True())
+    {
+        context->ClearCondition();
+        return NULLOBJECT;
+    }
+    RexxObjectPtr value = context->SendMessage1(anchors, "AT", index);
+    context->ReleaseLocalReference(index);
+    return value;
+}
+
+
+/*************************************************************/
+/* YamlParser::registerAnchor                                */
+/*                                                           */
+/* anchors[name] = node, and anchorMap[node] = name unless   */
+/* the node is .nil.                                         */
+/*************************************************************/
+bool YamlParser::registerAnchor(YamlText name, RexxObjectPtr node)
+{
+    RexxObjectPtr index = string(name);
+    if (!put(anchors, node, index))
+    {
+        return false;
+    }
+    if (node != context->Nil() && !put(anchorMap, index, node))
+    {
+        return false;
+    }
+    return true;
+}
+
+
+/*************************************************************/
+/* class YamlReader                                          */
+/*                                                           */
+/* hands the input to the parser a piece at a time. a piece  */
+/* ends before a '---' in column 1 that follows some content */
+/* or, after a '...', before the directives leading up to    */
+/* such a '---'. those always start a new document, so a     */
+/* piece normally holds whole documents. the first line of   */
+/* the next piece comes along as a lookahead line; if the    */
+/* parser moves past it, the piece wasn't complete after all */
+/* (a top level block scalar may hold a '---') and extend()  */
+/* adds the next piece to it.                                */
+/*                                                           */
+/* the input is the lines array of the Yaml object or a      */
+/* stream, which is read in blocks, so only the current      */
+/* piece of a file has to be in memory.                      */
+/*************************************************************/
+class YamlReader
+{
+  public:
+    YamlReader(RexxMethodContext *c, RexxArrayObject input, RexxObjectPtr s) : context(c)
+    {
+        source = input;
+        sourceCount = input == NULLOBJECT ? 0 : context->ArrayItems(input);
+        stream = s;
+        next = 1;
+        eof = false;
+        started = false;
+        blockPos = 0;
+        held = context->NewArray(0);
+        heldCount = 0;
+        size = 0;
+        offset = 0;
+        lookahead = false;
+        marked = false;
+    }
+
+    bool nextPiece();
+    bool extend();
+    RexxArrayObject piece();
+
+    size_t size;                       // lines in the piece
+    size_t offset;                     // input lines before it
+    bool   lookahead;                  // piece() adds the next line
+    bool   marked;                     // there is an '&', '<<' or '%' in them
+
+  private:
+    static const size_t ReadSize = 65536;   // bytes read from a stream at a time
+
+    bool readLine();
+    void collect(bool content);
+
+    RexxMethodContext *context;        // the method call context
+    RexxArrayObject source;            // the input lines, or NULLOBJECT
+    size_t          sourceCount;       // how many there are
+    RexxObjectPtr   stream;            // or the input stream
+    size_t          next;              // next line of source
+    bool            eof;               // the stream is exhausted
+    bool            started;           // a piece has been returned
+    YamlBuffer      block;             // what was read from the stream
+    size_t          blockPos;          // start of the next line in it
+    RexxArrayObject held;              // the piece and the lines after it
+    size_t          heldCount;         // lines in held
+};
+
+
+/*************************************************************/
+/* YamlReader::readLine                                      */
+/*                                                           */
+/* add the next input line to the held lines. lines read     */
+/* from a stream are split like ~arrayIn does: at a LF or a  */
+/* CR LF, and a last line without either counts.             */
+/*************************************************************/
+bool YamlReader::readLine()
+{
+    RexxObjectPtr line;
+    if (source != NULLOBJECT)
+    {
+        if (next > sourceCount)
+        {
+            return false;
+        }
+        line = context->ArrayAt(source, next++);
+        if (line == NULLOBJECT)
+        {
+            line = context->Nil();
+        }
+    }
+    else
+    {
+        for (;;)
+        {
+            char *start = block.buffer + blockPos;
+            char *end = (char *)memchr(start, '\n', block.length - blockPos);
+            if (end != NULL)
+            {
+                size_t length = end - start;
+                if (length > 0 && start[length - 1] == '\r')
+                {
+                    length--;
+                }
+                line = context->NewString(start, length);
+                blockPos = end - block.buffer + 1;
+                break;
+            }
+            if (eof)
+            {
+                if (blockPos == block.length)
+                {
+                    return false;
+                }
+                line = context->NewString(start, block.length - blockPos);
+                blockPos = block.length;
+                break;
+            }
+
+            // keep the start of the line and read the next block
+            memmove(block.buffer, start, block.length - blockPos);
+            block.length -= blockPos;
+            blockPos = 0;
+            RexxArrayObject args = context->NewArray(2);
+            context->ArrayPut(args, context->StringSizeToObject(ReadSize), 2);
+            RexxObjectPtr data = context->SendMessage(stream, "CHARIN", args);
+            context->ReleaseLocalReference(args);
+            // reading up to the end of the stream raises NOTREADY
+            context->ClearCondition();
+            if (data == NULLOBJECT || !context->IsString(data) || context->StringLength((RexxStringObject)data) == 0)
+            {
+                eof = true;
+            }
+            else
+            {
+                block.append(context->StringData((RexxStringObject)data), context->StringLength((RexxStringObject)data));
+            }
+            if (data != NULLOBJECT)
+            {
+                context->ReleaseLocalReference(data);
+            }
+        }
+    }
+    context->ArrayPut(held, line, ++heldCount);
+    context->ReleaseLocalReference(line);
+    return true;
+}
+
+
+/*************************************************************/
+/* YamlReader::collect                                       */
+/*                                                           */
+/* add lines to the piece until it ends, see above. content  */
+/* tells if the piece has any content yet.                   */
+/*************************************************************/
+void YamlReader::collect(bool content)
+{
+    bool afterEnd = !content;          // at the start or after a '...'
+    size_t directives = 0;             // where the directives after it start
+    bool contentBefore = false;        // and if there was content before them
+
+    for (size_t i = size + 1; ; i++)
+    {
+        if (i > heldCount && !readLine())
+        {
+            size = heldCount;
+            lookahead = false;
+            return;
+        }
+
+        RexxObjectPtr line = context->ArrayAt(held, i);
+        if (!context->IsString(line))
+        {
+            context->ReleaseLocalReference(line);
+            content = true;
+            afterEnd = false;
+            directives = 0;
+            continue;
+        }
+        YamlText text(context->StringData((RexxStringObject)line), context->StringLength((RexxStringObject)line));
+        context->ReleaseLocalReference(line);
+        // only lines with these can add anchors, merges or directives
+        if (memchr(text.data, '&', text.length) != NULL || memchr(text.data, '<', text.length) != NULL ||
+            text.startsWith('%'))
+        {
+            marked = true;
+        }
+
+        size_t first = 0;
+        while (first < text.length && (text.data[first] == ' ' || text.data[first] == '\t'))
+        {
+            first++;
+        }
+
+        if (text.startsWith("---") && isDocumentMarker(text))
+        {
+            if (directives > 0 && contentBefore)
+            {
+                size = directives - 1;
+                break;
+            }
+            if (content)
+            {
+                size = i - 1;
+                break;
+            }
+            content = true;
+            afterEnd = false;
+            directives = 0;
+        }
+        else if (text.startsWith("...") && isDocumentMarker(text))
+        {
+            content = true;
+            afterEnd = true;
+            directives = 0;
+        }
+        else if (first == text.length || text.data[first] == '#')
+        {
+            // blank lines and comments go with either side
+        }
+        else if (text.startsWith('%') && afterEnd)
+        {
+            if (directives == 0)
+            {
+                directives = i;
+                contentBefore = content;
+            }
+        }
+        else
+        {
+            content = true;
+            afterEnd = false;
+            directives = 0;
+        }
+    }
+    lookahead = true;
+}
+
+
+/*************************************************************/
+/* YamlReader::nextPiece                                     */
+/*                                                           */
+/* move on to the next piece of the input. returns false at  */
+/* the end; empty input makes a single, empty piece.         */
+/*************************************************************/
+bool YamlReader::nextPiece()
+{
+    if (size > 0)
+    {
+        RexxArrayObject rest = context->NewArray(heldCount - size);
+        for (size_t i = size + 1; i <= heldCount; i++)
+        {
+            RexxObjectPtr line = context->ArrayAt(held, i);
+            context->ArrayPut(rest, line, i - size);
+            context->ReleaseLocalReference(line);
+        }
+        context->ReleaseLocalReference(held);
+        held = rest;
+        heldCount -= size;
+        offset += size;
+        size = 0;
+    }
+
+    marked = false;
+    if (heldCount == 0 && !readLine())
+    {
+        lookahead = false;
+        if (started)
+        {
+            return false;
+        }
+        started = true;
+        return true;
+    }
+    started = true;
+    collect(false);
+    return true;
+}
+
+
+/*************************************************************/
+/* YamlReader::extend                                        */
+/*                                                           */
+/* add the next piece to the current one.                    */
+/*************************************************************/
+bool YamlReader::extend()
+{
+    if (!lookahead)
+    {
+        return false;
+    }
+    size++;
+    collect(true);
+    return true;
+}
+
+
+/*************************************************************/
+/* YamlReader::piece                                         */
+/*                                                           */
+/* a new array with the lines of the piece and the lookahead */
+/* line, for the parser to work on (and change).             */
+/*************************************************************/
+RexxArrayObject YamlReader::piece()
+{
+    size_t count = lookahead ? size + 1 : size;
+    RexxArrayObject result = context->NewArray(count);
+    for (size_t i = 1; i <= count; i++)
+    {
+        RexxObjectPtr line = context->ArrayAt(held, i);
+        context->ArrayPut(result, line, i);
+        context->ReleaseLocalReference(line);
+    }
+    return result;
+}
+
+
+/*************************************************************/
+/* parseDocuments                                            */
+/*                                                           */
+/* parse the input a piece at a time (see YamlReader), for   */
+/* just the first document or for an .Array of all of them. */
+/*                                                           */
+/* if the native parser gives up on a piece, the Rexx        */
+/* methods parse it again, and fallbacks counts how often    */
+/* that happened. if a piece turns out to be incomplete, or  */
+/* the Rexx code raised an error at or past its lookahead    */
+/* line (which may be due to the lines missing after that),  */
+/* it is parsed again together with the next piece. before   */
+/* parsing a piece again, its documents are dropped and the  */
+/* anchors, anchorMap, mergeSourceMap and directivesMap are  */
+/* put back as they were.                                    */
+/*************************************************************/
+static RexxObjectPtr parseDocuments(RexxMethodContext *context, RexxObjectPtr stream, bool all)
+{
+    YamlParser parser(context);
+    RexxArrayObject input = NULLOBJECT;
+    if (stream == NULLOBJECT)
+    {
+        RexxObjectPtr lines = context->GetObjectVariable("LINES");
+        if (lines == NULLOBJECT || !context->IsArray(lines))
+        {
+            return context->Nil();
+        }
+        input = (RexxArrayObject)lines;
+    }
+    YamlReader reader(context, input, stream);
+    RexxArrayObject docs = context->NewArray(0);
+    RexxObjectPtr doc = context->Nil();
+    bool hadDocEnd = false;
+    size_t fallbacks = 0;
+
+    while (reader.nextPiece())
+    {
+        size_t count = context->ArrayItems(docs);
+        RexxArrayObject saved = NULLOBJECT;
+        bool native = true;
+        RexxObjectPtr result;
+
+        for (;;)
+        {
+            // the state is only saved if the piece can change it
+            if (saved == NULLOBJECT && reader.marked)
+            {
+                saved = parser.saveState();
+            }
+            parser.setInput(reader.piece(), reader.offset);
+            size_t limit = reader.size;
+
+            if (native)
+            {
+                result = NULLOBJECT;
+                if (parser.load())
+                {
+                    result = all ? parser.parseDocs(docs, hadDocEnd, limit) : parser.parseOneDoc();
+                }
+            }
+            else if (all)
+            {
+                result = parser.delegate("PARSEMOREDOCS", context->ArrayOfThree(docs,
+                    hadDocEnd ? context->True() : context->False(), context->StringSizeToObject(limit)));
+            }
+            else
+            {
+                result = parser.delegate("PARSEONEDOC", context->NewArray(0));
+            }
+
+            size_t reached = parser.position();
+            if (context->CheckCondition())
+            {
+                // where the Rexx code was when it raised the error
+                size_t at;
+                if (context->ObjectToStringSize(context->GetObjectVariable("POS"), &at) && at > reached)
+                {
+                    reached = at;
+                }
+                if (!reader.lookahead || reached <= limit)
+                {
+                    return NULLOBJECT;
+                }
+                context->ClearCondition();
+                reader.extend();
+                native = true;
+            }
+            else if (result == NULLOBJECT && native)
+            {
+                native = false;
+                fallbacks++;
+                context->SetObjectVariable("FALLBACKS", context->StringSizeToObject(fallbacks));
+            }
+            else if (result == NULLOBJECT || !reader.lookahead || reached <= limit + 1)
+            {
+                break;
+            }
+            else
+            {
+                reader.extend();
+                native = true;
+            }
+
+            // drop what the piece added before parsing it again
+            while (context->ArrayItems(docs) > count)
+            {
+                context->SendMessage1(docs, "DELETE", context->StringSizeToObject(context->ArrayItems(docs)));
+            }
+            if (saved != NULLOBJECT)
+            {
+                parser.restoreState(saved);
+            }
+        }
+
+        if (saved != NULLOBJECT)
+        {
+            context->ReleaseLocalReference(saved);
+        }
+        if (!all)
+        {
+            doc = result == NULLOBJECT ? context->Nil() : result;
+            break;
+        }
+        if (result == NULLOBJECT || result == context->Nil())
+        {
+            break;
+        }
+        hadDocEnd = result == context->True();
+    }
+
+    if (!all)
+    {
+        return doc;
+    }
+    if (context->ArrayItems(docs) == 0)
+    {
+        context->ArrayAppend(docs, context->SendMessage0(context->FindContextClass("TABLE"), "NEW"));
+    }
+    return docs;
+}
+
+
+/*************************************************************/
+/* YAML_ParseDoc                                             */
+/*                                                           */
+/* parse the first document of the input loadInput has set   */
+/* up, or of the given stream.                               */
+/*************************************************************/
+RexxMethod1(RexxObjectPtr,                // Return type
+            YAML_ParseDoc,                // Object_method name
+            OPTIONAL_RexxObjectPtr, stream) // stream to read
+{
+    return parseDocuments(context, stream, false);
+}
+
+
+/*************************************************************/
+/* YAML_ParseAllDocs                                         */
+/*                                                           */
+/* parse all documents of the input loadInput has set up, or */
+/* of the given stream, into an .Array.                      */
+/*************************************************************/
+RexxMethod1(RexxObjectPtr,                // Return type
+            YAML_ParseAllDocs,            // Object_method name
+            OPTIONAL_RexxObjectPtr, stream) // stream to read
+{
+    return parseDocuments(context, stream, true);
+}
+
+
+// now build the actual entry list
+RexxMethodEntry rxyaml_methods[] =
+{
+    REXX_METHOD(YAML_ParseDoc,     YAML_ParseDoc),
+    REXX_METHOD(YAML_ParseAllDocs, YAML_ParseAllDocs),
+    REXX_LAST_METHOD()
+};
+
+
+RexxPackageEntry rxyaml_package_entry =
+{
+    STANDARD_PACKAGE_HEADER
+    REXX_INTERPRETER_4_0_0,              // anything after 4.0.0 will work
+    "RXYAML",                            // name of the package
+    "5.0",                               // package information
+    NULL,                                // no load/unload functions
+    NULL,
+    NULL,                                // the exported functions
+    rxyaml_methods                       // the exported methods
+};
+
+// package loading stub.
+OOREXX_GET_PACKAGE(rxyaml);
@@ -238,44 +238,45 @@ typedef enum
     T_CommandIOConfiguration = 176,
     T_AddressWithInstruction = 177,
     T_ConstantDirective = 178,
+    T_AppendAssignmentInstruction = 179,
 
-    T_Last_Internal_Class = 178,
+    T_Last_Internal_Class = 179,
     
-    T_First_Transient_Class = 179,
+    T_First_Transient_Class = 180,
 
-    T_Memory = 179,
-    T_InternalStack = 180,
-    T_PushThroughStack = 181,
-    T_Activity = 182,
-    T_Activation = 183,
-    T_NativeActivation = 184,
-    T_ActivationFrameBuffer = 185,
-    T_Envelope = 186,
-    T_LanguageParser = 187,
-    T_Clause = 188,
-    T_Token = 189,
-    T_DoBlock = 190,
-    T_InterpreterInstance = 191,
-    T_SecurityManager = 192,
-    T_CommandHandler = 193,
-    T_MapBucket = 194,
-    T_MapTable = 195,
-    T_TrapHandler = 196,
-    T_CommandIOContext = 197,
-    T_StemOutputTarget = 198,
-    T_StreamObjectOutputTarget = 199,
-    T_StreamOutputTarget = 200,
-    T_CollectionOutputTarget = 201,
-    T_BufferingOutputTarget = 202,
-    T_StemInputSource = 203,
-    T_StreamObjectInputSource = 204,
-    T_StreamInputSource = 205,
-    T_ArrayInputSource = 206,
-    T_RexxQueueOutputTarget = 207,
+    T_Memory = 180,
+    T_InternalStack = 181,
+    T_PushThroughStack = 182,
+    T_Activity = 183,
+    T_Activation = 184,
+    T_NativeActivation = 185,
+    T_ActivationFrameBuffer = 186,
+    T_Envelope = 187,
+    T_LanguageParser = 188,
+    T_Clause = 189,
+    T_Token = 190,
+    T_DoBlock = 191,
+    T_InterpreterInstance = 192,
+    T_SecurityManager = 193,
+    T_CommandHandler = 194,
+    T_MapBucket = 195,
+    T_MapTable = 196,
+    T_TrapHandler = 197,
+    T_CommandIOContext = 198,
+    T_StemOutputTarget = 199,
+    T_StreamObjectOutputTarget = 200,
+    T_StreamOutputTarget = 201,
+    T_CollectionOutputTarget = 202,
+    T_BufferingOutputTarget = 203,
+    T_StemInputSource = 204,
+    T_StreamObjectInputSource = 205,
+    T_StreamInputSource = 206,
+    T_ArrayInputSource = 207,
+    T_RexxQueueOutputTarget = 208,
 
-    T_Last_Transient_Class = 207,
-    T_Last_Primitive_Class = 207,
-    T_Last_Class_Type = 207,
+    T_Last_Transient_Class = 208,
+    T_Last_Primitive_Class = 208,
+    T_Last_Class_Type = 208,
     
 } ClassTypeCode;
 
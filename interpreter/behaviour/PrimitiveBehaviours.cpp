@@ -238,6 +238,7 @@ RexxBehaviour RexxBehaviour::primitiveBehaviours[T_Last_Primitive_Class + 1] =
     RexxBehaviour(T_CommandIOConfiguration, (PCPPM *)RexxObject::operatorMethods),
     RexxBehaviour(T_AddressWithInstruction, (PCPPM *)RexxObject::operatorMethods),
     RexxBehaviour(T_ConstantDirective, (PCPPM *)RexxObject::operatorMethods),
+    RexxBehaviour(T_AppendAssignmentInstruction, (PCPPM *)RexxObject::operatorMethods),
     RexxBehaviour(T_Memory, (PCPPM *)RexxObject::operatorMethods),
     RexxBehaviour(T_InternalStack, (PCPPM *)RexxObject::operatorMethods),
     RexxBehaviour(T_PushThroughStack, (PCPPM *)RexxObject::operatorMethods),
@@ -746,6 +746,9 @@ void MemoryObject::buildVirtualFunctionTable()
    objectPtr = ::new (objectLoc) ConstantDirective(RESTOREIMAGE);
    virtualFunctionTable[T_ConstantDirective] = getVftPointer(objectLoc);
    
+   objectPtr = ::new (objectLoc) RexxInstructionAppendAssignment(RESTOREIMAGE);
+   virtualFunctionTable[T_AppendAssignmentInstruction] = getVftPointer(objectLoc);
+   
    objectPtr = ::new (objectLoc) RexxObject(RESTOREIMAGE);
    virtualFunctionTable[T_Memory] = getVftPointer(objectLoc);
    
@@ -86,7 +86,7 @@ BagClass::BagClass(size_t capacity)
     // called.  We don't have access to our allocateContents() override
     // until the final constructor is run.
     size_t bucketSize = calculateBucketSize(capacity);
-    contents = allocateContents(bucketSize, bucketSize *2);
+    contents = allocateContents(bucketSize);
 }
 
 
@@ -95,14 +95,13 @@ BagClass::BagClass(size_t capacity)
  * collection.  Collections with special requirements should
  * override this and return the appropriate subclass.
  *
- * @param bucketSize The bucket size of the collection.
- * @param totalSize  The total capacity of the collection.
+ * @param bucketSize The number of slots in the collection.
  *
  * @return A new HashContents object appropriate for this collection type.
  */
-HashContents *BagClass::allocateContents(size_t bucketSize, size_t totalSize)
+HashContents *BagClass::allocateContents(size_t bucketSize)
 {
-    return new (totalSize) MultiValueContents(bucketSize, totalSize);
+    return new (bucketSize) MultiValueContents(bucketSize);
 }
 
 
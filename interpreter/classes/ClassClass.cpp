@@ -1791,6 +1791,8 @@ RexxClass  *RexxClass::newRexx(RexxObject **args, size_t argCount)
     new_class->id = class_id;
     // the new class does not inherit annotations
     new_class->annotations = OREF_NULL;
+    // or the contention count of the class it was cloned from
+    new_class->guardContentions = 0;
 
     // no new class objects start out as abstract.
     new_class->clearAbstract();
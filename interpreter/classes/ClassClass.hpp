@@ -163,6 +163,8 @@ class RexxClass : public RexxObject
     inline void         setMetaClass() { classFlags.set(META_CLASS); }
     inline void         setAbstract() { classFlags.set(ABSTRACT); }
     inline void         clearAbstract() { classFlags.reset(ABSTRACT); }
+    inline void         noteGuardContention() { guardContentions++; }
+    inline size_t       getGuardContentions() { return guardContentions; }
            void         addSubClass(RexxClass *);
            void         removeSubclass(RexxClass *c);
            void         checkUninit();
@@ -208,5 +210,6 @@ class RexxClass : public RexxObject
     ListClass     *subClasses;         // our list of weak referenced subclasses
     PackageClass  *package;            // source we're defined in (if any)
     StringTable   *annotations;        // annotations attached to the class (if any)
+    size_t         guardContentions;   // times a guarded method of this scope had to wait for the lock
 };
 #endif
@@ -1,12 +1,11 @@
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
-/* Copyright (c) 1995, 2004 IBM Corporation. All rights reserved.             */
-/* Copyright (c) 2005-2014 Rexx Language Association. All rights reserved.    */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
 /*                                                                            */
 /* This program and the accompanying materials are made available under       */
 /* the terms of the Common Public License v1.0 which accompanies this         */
 /* distribution. A copy is also available at the following address:           */
-/* https://www.oorexx.org/license.html                         */
+/* https://www.oorexx.org/license.html                                        */
 /*                                                                            */
 /* Redistribution and use in source and binary forms, with or                 */
 /* without modification, are permitted provided that the following            */
@@ -35,44 +34,37 @@
 /* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
-#ifndef DBLQUEUE
-#define DBLQUEUE
-//#define MYDEBUG
-#include <stdio.h>
-#include "regexp.hpp"
+/*********************************************************************/
+/*                                                                   */
+/*  Function:  Executor native methods                               */
+/*                                                                   */
+/*********************************************************************/
+#include "RexxCore.h"                  /* global REXX declarations          */
+#include "Activity.hpp"
+#include "ActivationApiContexts.hpp"
 
-class doubleQueue {
-  public:
-    doubleQueue(int n);                    // create queue with size n
-    ~doubleQueue();
-    void push(int value);                  // push on top
-    void put(int value);                   // insert at bottom
-    int pop();                             // pop from top
-    // queue is empty when only one SCAN element is in it
-    bool isEmpty() {
-      if (head+1 == tail-1 && (memory[tail-1] == SCAN)) return true;
-      else return false;
-    }
-#ifdef MYDEBUG
-    // show contents of queue
-    void dump() {
-      printf("double queue: {");
-      for (int i=head+1;i<tail;i++) {
-        if (memory[i] == SCAN) printf("SCAN");
-        else printf("%d",memory[i]);
-        if (i < tail-1) printf(", ");
-      }
-      printf("}\n");
-    }
-#endif
 
-  private:
-    void enlarge();                        // make int array bigger if needed
+/**
+ * Record that the current thread is running a task for one of
+ * the receiver's workers.  A task that submits more work reads
+ * this back to find the deque of the worker it's running on.
+ *
+ * @param slot   The worker's deque number, or 0 once the task is done.
+ */
+RexxMethod2(RexxObjectPtr, executor_set_worker, size_t, slot, OSELF, self)
+{
+    contextToActivity(context)->setExecutorWorker(slot == 0 ? OREF_NULL : (RexxObject *)self, slot);
+    return NULLOBJECT;
+}
 
-    int *memory;                           // array holding elements of queue
-    int size;                              // size of array
-    int head;                              // position of head of queue
-    int tail;                              // position of tail of queue
-};
 
-#endif
+/**
+ * Return the deque number of the receiver's worker the current
+ * thread is running a task for.
+ *
+ * @return The deque number, or 0 if this thread isn't one of our workers.
+ */
+RexxMethod1(size_t, executor_worker_slot, OSELF, self)
+{
+    return contextToActivity(context)->getExecutorSlot((RexxObject *)self);
+}
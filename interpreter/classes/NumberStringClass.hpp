@@ -389,6 +389,8 @@ class NumberString : public NumberStringBase
                                   NumberString *result, char *&resultPtr);
     static char *addMultiplier(const char *, wholenumber_t, char *, int);
     static char *subtractDivisor(const char *data1, wholenumber_t length1, const char *data2, wholenumber_t length2, char *result, int Mult);
+    static wholenumber_t multiplyLimbs(NumberString *large, NumberString *small, char *output);
+    static wholenumber_t divideLimbs(NumberString *left, NumberString *right, wholenumber_t digits, char *output);
     static char *multiplyPower(const char *leftPtr, NumberStringBase *left, const char *rightPtr, NumberStringBase *right, char *OutPtr, wholenumber_t OutLen, wholenumber_t NumberDigits);
     static char *dividePower(const char *AccumPtr, NumberStringBase *Accum, char *Output, wholenumber_t NumberDigits);
     static char *addToBaseSixteen(int, char *, char *);
@@ -413,6 +415,13 @@ class NumberString : public NumberStringBase
     // plus an extra.  For alignment purposes, makea multiple of 8 also.
     static const size_t FAST_BUFFER = 48;
 
+    // operand sizes where multiplication and division switch from working
+    // a digit at a time to working on base 10**9 limbs.
+    static const wholenumber_t LIMB_MULTIPLY_DIGITS = 6;
+    static const wholenumber_t LIMB_DIVIDE_DIGITS = 6;
+    // limb work space that can be handled without allocating a buffer object
+    static const size_t LIMB_FAST_BUFFER = 256;
+
     char  numberDigits[4];                   // the digits for the number
 };
 
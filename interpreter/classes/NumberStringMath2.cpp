@@ -50,6 +50,7 @@
 #include "ActivityManager.hpp"
 #include "MethodArguments.hpp"
 #include "ProtectedObject.hpp"
+#include "DecimalLimbs.hpp"
 
 
 /**
@@ -96,6 +97,55 @@ char *NumberString::addMultiplier(const char *top, wholenumber_t topLen, char *a
 }
 
 
+/**
+ * Multiply the digits of two long numbers using limb
+ * arithmetic.
+ *
+ * @param large  The first operand.
+ * @param small  The second operand.
+ * @param output The buffer for the product digits.  This must be large
+ *               enough for the digits of both operands.
+ *
+ * @return The number of digits in the product, which is written
+ *         starting at output with no leading zeros.
+ */
+wholenumber_t NumberString::multiplyLimbs(NumberString *large, NumberString *small, char *output)
+{
+    Protected<BufferClass> limbBuffer;
+    uint32_t limbsFast[LIMB_FAST_BUFFER];
+
+    size_t largeLimbs = DecimalLimbs::limbCount(large->digitsCount);
+    size_t smallLimbs = DecimalLimbs::limbCount(small->digitsCount);
+    size_t productLimbs = largeLimbs + smallLimbs;
+    size_t totalLimbs = productLimbs * 2 + DecimalLimbs::multiplyScratch(largeLimbs, smallLimbs);
+
+    uint32_t *limbs = limbsFast;
+    if (totalLimbs > LIMB_FAST_BUFFER)
+    {
+        limbBuffer = new_buffer(totalLimbs * sizeof(uint32_t));
+        limbs = (uint32_t *)limbBuffer->getData();
+    }
+
+    uint32_t *largeData = limbs;
+    uint32_t *smallData = largeData + largeLimbs;
+    uint32_t *product = smallData + smallLimbs;
+
+    DecimalLimbs::fromDigits(large->numberDigits, large->digitsCount, 0, largeData);
+    DecimalLimbs::fromDigits(small->numberDigits, small->digitsCount, 0, smallData);
+    DecimalLimbs::multiply(largeData, largeLimbs, smallData, smallLimbs, product, product + productLimbs);
+
+    // the product has either the combined length of the operands or one digit less
+    wholenumber_t length = large->digitsCount + small->digitsCount;
+    DecimalLimbs::toDigits(product, productLimbs, output, length);
+    if (*output == 0)
+    {
+        length--;
+        memmove(output, output + 1, length);
+    }
+    return length;
+}
+
+
 /**
  * Multiply two NumberString objects
  *
@@ -153,32 +203,40 @@ NumberString *NumberString::Multiply(NumberString *other)
     char *accumPtr = outPtr;
     wholenumber_t accumLen = 0;
 
-    // this is where we start laying out the data...starting from the
-    // far end of the buffer.
-    char *resultPtr = accumPtr + totalDigits - 1;
-    // we iterate through the small number multiplying with each of the
-    // digits in the smaller number
-    const char *current = smallNum->numberDigits + smallNum->digitsCount;
-
-    // now process all of the digits
-    for (size_t i = smallNum->digitsCount ; i > 0 ; i-- )
+    // long operands are much faster to multiply nine digits at a time
+    if (smallNum->digitsCount >= LIMB_MULTIPLY_DIGITS)
     {
-        current--;
-        // get the current multiplier character
-        int multChar = *current;
-        // we don't need to do anything with zero digits.  Other digits
-        // we multiply and add
-        if (multChar != 0)
+        accumLen = multiplyLimbs(largeNum, smallNum, accumPtr);
+    }
+    else
+    {
+        // this is where we start laying out the data...starting from the
+        // far end of the buffer.
+        char *resultPtr = accumPtr + totalDigits - 1;
+        // we iterate through the small number multiplying with each of the
+        // digits in the smaller number
+        const char *current = smallNum->numberDigits + smallNum->digitsCount;
+
+        // now process all of the digits
+        for (size_t i = smallNum->digitsCount ; i > 0 ; i-- )
         {
-            // multiply the larger number by the current digit and add to the accumulator
-            accumPtr = addMultiplier(largeNum->numberDigits, largeNum->digitsCount, resultPtr,  multChar);
-        }
+            current--;
+            // get the current multiplier character
+            int multChar = *current;
+            // we don't need to do anything with zero digits.  Other digits
+            // we multiply and add
+            if (multChar != 0)
+            {
+                // multiply the larger number by the current digit and add to the accumulator
+                accumPtr = addMultiplier(largeNum->numberDigits, largeNum->digitsCount, resultPtr,  multChar);
+            }
 
-        // back up the result pointer for the next add position and handle the next digit.
-        resultPtr--;
+            // back up the result pointer for the next add position and handle the next digit.
+            resultPtr--;
+        }
+        // update the accumulator length for the final result.
+        accumLen = (++resultPtr - accumPtr) + smallNum->digitsCount;
     }
-    // update the accumulator length for the final result.
-    accumLen = (++resultPtr - accumPtr) + smallNum->digitsCount;
 
     // accumPtr now points to result,
     //  the len of result is in accumLen
@@ -320,6 +378,63 @@ char *NumberString::subtractDivisor(const char *divisor, wholenumber_t divisorLe
 }
 
 
+/**
+ * Generate the leading digits of a quotient using limb
+ * arithmetic.  The quotient is truncated to digits + 1
+ * significant digits, which are exactly the digits the long
+ * division loop would produce before rounding.
+ *
+ * @param left   The dividend.
+ * @param right  The divisor.
+ * @param digits The current digits setting.
+ * @param output The buffer for the quotient digits (at least digits + 2 long).
+ *
+ * @return The power of ten the dividend was scaled by.  The quotient
+ *         value is output * 10**(left exponent - right exponent - scale).
+ */
+wholenumber_t NumberString::divideLimbs(NumberString *left, NumberString *right, wholenumber_t digits, char *output)
+{
+    Protected<BufferClass> limbBuffer;
+    uint32_t limbsFast[LIMB_FAST_BUFFER];
+
+    // scale the dividend so the quotient has at least digits + 1 digits
+    wholenumber_t scale = digits + right->digitsCount - left->digitsCount + 1;
+
+    size_t dividendLimbs = DecimalLimbs::limbCount(left->digitsCount + scale);
+    size_t divisorLimbs = DecimalLimbs::limbCount(right->digitsCount);
+    size_t quotientLimbs = dividendLimbs - divisorLimbs + 1;
+    size_t totalLimbs = dividendLimbs + divisorLimbs + quotientLimbs + DecimalLimbs::divideScratch(dividendLimbs, divisorLimbs);
+
+    uint32_t *limbs = limbsFast;
+    if (totalLimbs > LIMB_FAST_BUFFER)
+    {
+        limbBuffer = new_buffer(totalLimbs * sizeof(uint32_t));
+        limbs = (uint32_t *)limbBuffer->getData();
+    }
+
+    uint32_t *dividend = limbs;
+    uint32_t *divisor = dividend + dividendLimbs;
+    uint32_t *quotient = divisor + divisorLimbs;
+
+    DecimalLimbs::fromDigits(left->numberDigits, left->digitsCount, scale, dividend);
+    DecimalLimbs::fromDigits(right->numberDigits, right->digitsCount, 0, divisor);
+    DecimalLimbs::divide(dividend, dividendLimbs, divisor, divisorLimbs, quotient, quotient + quotientLimbs);
+
+    // the quotient is at least 10**digits, but may have one extra digit.
+    // dropping that digit is the same as scaling the dividend one less.
+    DecimalLimbs::toDigits(quotient, quotientLimbs, output, digits + 2);
+    if (*output == 0)
+    {
+        memmove(output, output + 1, digits + 1);
+    }
+    else
+    {
+        scale--;
+    }
+    return scale;
+}
+
+
 /**
  * Divide two numbers
  *
@@ -496,6 +611,16 @@ NumberString *NumberString::Division(NumberString *other, ArithmeticOperator div
     wholenumber_t resultDigits = 0;
     int thisDigit = 0;
 
+    // a long division is much faster done nine digits at a time.  This
+    // produces the same digits + 1 leading digits as the loop below.
+    if (divOP == OT_DIVIDE && digits >= LIMB_DIVIDE_DIGITS && right->digitsCount >= LIMB_DIVIDE_DIGITS)
+    {
+        wholenumber_t scale = divideLimbs(left, right, digits, output);
+        resultDigits = digits + 1;
+        calcExp = left->numberExponent - right->numberExponent - scale;
+        goto PowerDivideDone;
+    }
+
     // We are now to enter 2 do forever loops, inside the loops
     //  we test for ending conditions. and will exit the loops
     //  when needed. This inner loop may need to break out of
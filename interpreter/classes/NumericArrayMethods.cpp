@@ -0,0 +1,688 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/*********************************************************************/
+/*                                                                   */
+/*  Function:  NumericArray native methods                           */
+/*                                                                   */
+/*********************************************************************/
+#include "RexxCore.h"                  /* global REXX declarations          */
+#include "NumberStringClass.hpp"
+#include <algorithm>
+#include <cmath>
+#include <locale.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/**
+ * The CSELF data for a NumericArray.  The values are stored as
+ * unboxed doubles immediately following this header in a single
+ * buffer object, so the garbage collector sees one object with
+ * nothing to trace rather than one number object per item.
+ */
+class NumericArrayData
+{
+ public:
+    enum
+    {
+        MinimumCapacity = 16,          // smallest allocation we'll make
+        OutputDigits = 16              // precision used for returned values
+    };
+
+    static inline size_t bufferSize(size_t capacity) { return sizeof(NumericArrayData) + capacity * sizeof(double); }
+
+    inline double *values() { return (double *)(this + 1); }
+
+    size_t size;                       // the number of items in use
+    size_t capacity;                   // the number of items the buffer can hold
+};
+
+
+/**
+ * Validate that the CSELF data for the object exists.  This could
+ * be a subclass that never forwarded the INIT message.
+ *
+ * @param context The current method context.
+ * @param data    The CSELF data pointer.
+ *
+ * @return true if the data is usable, false if an exception was raised.
+ */
+static bool checkData(RexxMethodContext *context, NumericArrayData *data)
+{
+    if (data == NULL)
+    {
+        context->RaiseException1(Rexx_Error_Execution_noinit, context->GetSelf());
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * Allocate a new data buffer and make it the CSELF value of the
+ * receiver object.  Any items held by the old data are copied into
+ * the new buffer.
+ *
+ * @param context  The current method context.
+ * @param data     The current data (NULL if this is the first allocation).
+ * @param capacity The capacity of the new buffer.
+ *
+ * @return A pointer to the new data.
+ */
+static NumericArrayData *allocateData(RexxMethodContext *context, NumericArrayData *data, size_t capacity)
+{
+    capacity = std::max(capacity, (size_t)NumericArrayData::MinimumCapacity);
+    // the old buffer is still anchored by the object variable while we allocate
+    RexxBufferObject buffer = context->NewBuffer(NumericArrayData::bufferSize(capacity));
+    if (buffer == NULLOBJECT)
+    {
+        return NULL;
+    }
+    NumericArrayData *newData = (NumericArrayData *)context->BufferData(buffer);
+    newData->capacity = capacity;
+    newData->size = 0;
+    if (data != NULL)
+    {
+        newData->size = data->size;
+        memcpy(newData->values(), data->values(), data->size * sizeof(double));
+    }
+    context->SetObjectVariable("CSELF", buffer);
+    return newData;
+}
+
+
+/**
+ * Make sure there is room for at least the indicated number of
+ * items, growing the buffer if necessary.
+ *
+ * @param context The current method context.
+ * @param data    The current data.
+ * @param needed  The number of items required.
+ *
+ * @return The data pointer, which will be different if the buffer was reallocated.
+ */
+static NumericArrayData *reserve(RexxMethodContext *context, NumericArrayData *data, size_t needed)
+{
+    if (needed <= data->capacity)
+    {
+        return data;
+    }
+    // grow geometrically so that a series of appends is linear overall
+    return allocateData(context, data, std::max(needed, data->capacity * 2));
+}
+
+
+/**
+ * Convert an item to a double value, raising an error that
+ * identifies the failing item if it is not a valid number.  The
+ * infinities and NaN are rejected too, which keeps every stored
+ * item finite and so totally ordered for sort, min and max.
+ *
+ * @param context The current method context.
+ * @param item    The item to convert.
+ * @param name    The name of the source object, used for the error message.
+ * @param index   The index of the item.
+ * @param value   The returned value.
+ *
+ * @return true if the item converted, false if an exception was raised.
+ */
+static bool itemToDouble(RexxMethodContext *context, RexxObjectPtr item, const char *name, size_t index, double &value)
+{
+    if (item != NULLOBJECT && context->ObjectToDouble(item, &value) && std::isfinite(value))
+    {
+        return true;
+    }
+    char itemName[64];
+    snprintf(itemName, sizeof(itemName), name, index);
+    context->RaiseException2(Rexx_Error_Invalid_argument_number, context->String(itemName),
+        item == NULLOBJECT ? context->NullString() : item);
+    return false;
+}
+
+
+/**
+ * Return an item value as a Rexx number.  The value is formatted
+ * to 16 significant digits and that string is then parsed as a
+ * NumberString.  The result gets the usual Rexx number formatting,
+ * so 1E-5 comes back as 0.00001.  It also has none of the trailing
+ * zeros a rounded DoubleToObjectWithPrecision() value carries, so
+ * 0.1 comes back as 0.1.
+ *
+ * @param context The current method context.
+ * @param value   The value to convert.
+ *
+ * @return The number object.
+ */
+static RexxObjectPtr itemObject(RexxMethodContext *context, double value)
+{
+    // the infinities and NaN have their own special strings
+    if (!std::isfinite(value))
+    {
+        return context->DoubleToObjectWithPrecision(value, NumericArrayData::OutputDigits);
+    }
+    // don't give back a negative zero
+    if (value == 0)
+    {
+        value = 0;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*g", (int)NumericArrayData::OutputDigits, value);
+    // snprintf() is locale dependent, so make sure the radix is a dot
+    char radixChar = *localeconv()->decimal_point;
+    char *radixPos = strchr(buffer, radixChar);
+    if (radixPos != NULL)
+    {
+        *radixPos = '.';
+    }
+
+    size_t length = strlen(buffer);
+    NumberString *result = new (length) NumberString(length, NumericArrayData::OutputDigits);
+    result->parseNumber(buffer, length);
+    return (RexxObjectPtr)result;
+}
+
+
+/**
+ * Initialize a NumericArray.  The source can be omitted (an empty
+ * array), a size (that many zero items), an Array, or a stem
+ * holding items stem.1 to stem.n, where stem.0 is n.
+ *
+ * @param source The optional source of the initial items.
+ */
+RexxMethod1(RexxObjectPtr, numarray_init, OPTIONAL_RexxObjectPtr, source)
+{
+    if (source == NULLOBJECT)
+    {
+        allocateData(context, NULL, NumericArrayData::MinimumCapacity);
+        return NULLOBJECT;
+    }
+
+    if (context->IsArray(source))
+    {
+        RexxArrayObject array = (RexxArrayObject)source;
+        size_t size = context->ArraySize(array);
+        NumericArrayData *data = allocateData(context, NULL, context->ArrayItems(array));
+        if (data == NULL)
+        {
+            return NULLOBJECT;
+        }
+        double *values = data->values();
+        for (size_t i = 1; i <= size; i++)
+        {
+            RexxObjectPtr item = context->ArrayAt(array, i);
+            // empty slots are skipped, as MAKEARRAY would do
+            if (item == NULLOBJECT)
+            {
+                continue;
+            }
+            if (!itemToDouble(context, item, "source[%zu]", i, values[data->size]))
+            {
+                return NULLOBJECT;
+            }
+            data->size++;
+            context->ReleaseLocalReference(item);
+        }
+        return NULLOBJECT;
+    }
+
+    if (context->IsStem(source))
+    {
+        RexxStemObject stem = (RexxStemObject)source;
+        RexxObjectPtr count = context->GetStemElement(stem, "0");
+        size_t size;
+        if (count == NULLOBJECT || !context->ObjectToStringSize(count, &size))
+        {
+            context->RaiseException2(Rexx_Error_Invalid_argument_nonnegative, context->String("source.0"),
+                count == NULLOBJECT ? context->NullString() : count);
+            return NULLOBJECT;
+        }
+        NumericArrayData *data = allocateData(context, NULL, size);
+        if (data == NULL)
+        {
+            return NULLOBJECT;
+        }
+        double *values = data->values();
+        for (size_t i = 1; i <= size; i++)
+        {
+            RexxObjectPtr item = context->GetStemArrayElement(stem, i);
+            if (!itemToDouble(context, item, "source.%zu", i, values[i - 1]))
+            {
+                return NULLOBJECT;
+            }
+            context->ReleaseLocalReference(item);
+        }
+        data->size = size;
+        return NULLOBJECT;
+    }
+
+    // not a collection, so this must be a size
+    size_t size;
+    if (!context->ObjectToStringSize(source, &size))
+    {
+        context->RaiseException2(Rexx_Error_Incorrect_method_nonnegative, context->WholeNumber(1), source);
+        return NULLOBJECT;
+    }
+    NumericArrayData *data = allocateData(context, NULL, size);
+    if (data != NULL)
+    {
+        memset(data->values(), 0, size * sizeof(double));
+        data->size = size;
+    }
+    return NULLOBJECT;
+}
+
+
+/**
+ * Give a copied NumericArray its own data buffer.  The object
+ * copy shares the original CSELF buffer, which we replace with a
+ * duplicate.
+ */
+RexxMethod1(RexxObjectPtr, numarray_detach, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (checkData(context, data))
+    {
+        allocateData(context, data, data->size);
+    }
+    return NULLOBJECT;
+}
+
+
+/**
+ * Return the number of items in the array.
+ */
+RexxMethod1(size_t, numarray_items, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return 0;
+    }
+    return data->size;
+}
+
+
+/**
+ * Retrieve an item.  As with an Array, an index beyond the end
+ * returns .nil.
+ *
+ * @param index  The item index.
+ */
+RexxMethod2(RexxObjectPtr, numarray_at, CSELF, cself, positive_wholenumber_t, index)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    if ((size_t)index > data->size)
+    {
+        return context->Nil();
+    }
+    return itemObject(context, data->values()[index - 1]);
+}
+
+
+/**
+ * Replace an item.  An index beyond the end extends the array,
+ * with any intervening items set to zero.
+ *
+ * @param item   The new item value.
+ * @param index  The item index.
+ */
+RexxMethod3(RexxObjectPtr, numarray_put, CSELF, cself, RexxObjectPtr, item, positive_wholenumber_t, index)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    double value;
+    if (!itemToDouble(context, item, "value", 0, value))
+    {
+        return NULLOBJECT;
+    }
+    if ((size_t)index > data->size)
+    {
+        data = reserve(context, data, index);
+        if (data == NULL)
+        {
+            return NULLOBJECT;
+        }
+        double *values = data->values();
+        std::fill(values + data->size, values + index, 0.0);
+        data->size = index;
+    }
+    data->values()[index - 1] = value;
+    return NULLOBJECT;
+}
+
+
+/**
+ * Add an item to the end of the array.
+ *
+ * @param item   The new item value.
+ *
+ * @return The index of the added item.
+ */
+RexxMethod2(size_t, numarray_append, CSELF, cself, RexxObjectPtr, item)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return 0;
+    }
+    double value;
+    if (!itemToDouble(context, item, "value", 0, value))
+    {
+        return 0;
+    }
+    data = reserve(context, data, data->size + 1);
+    if (data == NULL)
+    {
+        return 0;
+    }
+    data->values()[data->size++] = value;
+    return data->size;
+}
+
+
+/**
+ * Append a range of items from another NumericArray.
+ *
+ * @param source The CSELF buffer of the source NumericArray.
+ * @param start  The first source item to copy.
+ * @param count  The number of items to copy (truncated at the source end).
+ */
+RexxMethod4(RexxObjectPtr, numarray_appendrange, CSELF, cself, RexxObjectPtr, source, positive_wholenumber_t, start, size_t, count)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    NumericArrayData *sourceData = (NumericArrayData *)context->BufferData((RexxBufferObject)source);
+    size_t first = (size_t)start - 1;
+    if (first >= sourceData->size)
+    {
+        return NULLOBJECT;
+    }
+    count = std::min(count, sourceData->size - first);
+    // the source might be the receiver, so don't hold its pointer across the reallocation
+    data = reserve(context, data, data->size + count);
+    if (data == NULL)
+    {
+        return NULLOBJECT;
+    }
+    sourceData = (NumericArrayData *)context->BufferData((RexxBufferObject)source);
+    memmove(data->values() + data->size, sourceData->values() + first, count * sizeof(double));
+    data->size += count;
+    return NULLOBJECT;
+}
+
+
+/**
+ * Apply an arithmetic operator to a pair of values.  A result
+ * that overflows the double range raises an overflow error, as
+ * division by zero does, so no infinity or NaN is ever stored.
+ *
+ * @param context  The method context, used to raise errors.
+ * @param operation The operator character.
+ * @param left     The left operand (updated in place).
+ * @param right    The right operand.
+ *
+ * @return false if an error was raised.
+ */
+static inline bool applyOperator(RexxMethodContext *context, char operation, double &left, double right)
+{
+    double result = left;
+    switch (operation)
+    {
+        case '+':
+            result += right;
+            break;
+        case '-':
+            result -= right;
+            break;
+        case '*':
+            result *= right;
+            break;
+        case '/':
+            if (right == 0)
+            {
+                context->RaiseException0(Rexx_Error_Overflow_zero);
+                return false;
+            }
+            result /= right;
+            break;
+    }
+    // the operands are always finite, so anything else is an overflow
+    if (!std::isfinite(result))
+    {
+        char operatorName[2] = { operation, '\0' };
+        context->RaiseException(Rexx_Error_Overflow_overflow, context->ArrayOfThree(itemObject(context, left),
+            context->String(operatorName), itemObject(context, right)));
+        return false;
+    }
+    left = result;
+    return true;
+}
+
+
+/**
+ * Apply an arithmetic operator between each item and a single
+ * number, updating the items in place.
+ *
+ * @param operation The operator ("+", "-", "*" or "/").
+ * @param operand   The right-hand operand.
+ */
+RexxMethod3(RexxObjectPtr, numarray_scale, CSELF, cself, CSTRING, operation, RexxObjectPtr, operand)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    double right;
+    if (!itemToDouble(context, operand, "operand", 0, right))
+    {
+        return NULLOBJECT;
+    }
+    double *values = data->values();
+    for (size_t i = 0; i < data->size; i++)
+    {
+        if (!applyOperator(context, operation[0], values[i], right))
+        {
+            return NULLOBJECT;
+        }
+    }
+    return NULLOBJECT;
+}
+
+
+/**
+ * Apply an arithmetic operator between each item and the
+ * corresponding item of another NumericArray of the same size,
+ * updating the items in place.
+ *
+ * @param operation The operator ("+", "-", "*" or "/").
+ * @param source    The CSELF buffer of the other NumericArray.
+ */
+RexxMethod3(RexxObjectPtr, numarray_combine, CSELF, cself, CSTRING, operation, RexxObjectPtr, source)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    NumericArrayData *sourceData = (NumericArrayData *)context->BufferData((RexxBufferObject)source);
+    double *values = data->values();
+    double *operands = sourceData->values();
+    size_t size = std::min(data->size, sourceData->size);
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!applyOperator(context, operation[0], values[i], operands[i]))
+        {
+            return NULLOBJECT;
+        }
+    }
+    return NULLOBJECT;
+}
+
+
+/**
+ * Sort the items into ascending order.
+ *
+ * @return The receiver object.
+ */
+RexxMethod2(RexxObjectPtr, numarray_sort, CSELF, cself, OSELF, self)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    // every stored item is finite, so there is no NaN to break the ordering
+    std::sort(data->values(), data->values() + data->size);
+    return self;
+}
+
+
+/**
+ * Return the sum of the items.
+ */
+RexxMethod1(RexxObjectPtr, numarray_sum, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    double *values = data->values();
+    double sum = 0;
+    for (size_t i = 0; i < data->size; i++)
+    {
+        if (!applyOperator(context, '+', sum, values[i]))
+        {
+            return NULLOBJECT;
+        }
+    }
+    return itemObject(context, sum);
+}
+
+
+/**
+ * Return the smallest item, or .nil if the array is empty.
+ */
+RexxMethod1(RexxObjectPtr, numarray_min, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    if (data->size == 0)
+    {
+        return context->Nil();
+    }
+    return itemObject(context, *std::min_element(data->values(), data->values() + data->size));
+}
+
+
+/**
+ * Return the largest item, or .nil if the array is empty.
+ */
+RexxMethod1(RexxObjectPtr, numarray_max, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    if (data->size == 0)
+    {
+        return context->Nil();
+    }
+    return itemObject(context, *std::max_element(data->values(), data->values() + data->size));
+}
+
+
+/**
+ * Convert the items to an Array of numbers.
+ */
+RexxMethod1(RexxObjectPtr, numarray_makearray, CSELF, cself)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    RexxArrayObject array = context->NewArray(data->size);
+    for (size_t i = 0; i < data->size; i++)
+    {
+        // the data pointer stays valid, nothing here can touch our buffer
+        RexxObjectPtr item = itemObject(context, data->values()[i]);
+        context->ArrayPut(array, item, i + 1);
+        // now anchored by the array, so drop the local reference
+        context->ReleaseLocalReference(item);
+    }
+    return array;
+}
+
+
+/**
+ * Copy the items into a stem, as stem.1 to stem.n with stem.0
+ * set to n.
+ *
+ * @param stem   The target stem object.
+ */
+RexxMethod2(RexxObjectPtr, numarray_tostem, CSELF, cself, RexxStemObject, stem)
+{
+    NumericArrayData *data = (NumericArrayData *)cself;
+    if (!checkData(context, data))
+    {
+        return NULLOBJECT;
+    }
+    for (size_t i = 0; i < data->size; i++)
+    {
+        RexxObjectPtr item = itemObject(context, data->values()[i]);
+        context->SetStemArrayElement(stem, i + 1, item);
+        context->ReleaseLocalReference(item);
+    }
+    context->SetStemArrayElement(stem, 0, context->StringSize(data->size));
+    return NULLOBJECT;
+}
@@ -115,8 +115,8 @@ class ObjectHeader
      inline void makeProxyObject() { flags |= ProxyObject; }
      inline bool isProxyObject() { return (flags & ProxyObject) != 0; }
      inline void clearObjectMark() { flags &= LiveMask; }
-     inline void setObjectMark(size_t mark) { clearObjectMark();
-         flags |= mark; }
+     // a single store, so a parallel marker never sees the mark bits cleared
+     inline void setObjectMark(size_t mark) { flags = (uint16_t)((flags & LiveMask) | mark); }
      inline bool isObjectMarked(size_t mark) { return (flags & mark) != 0; }
      inline bool isObjectLive(size_t mark) { return ((size_t)(flags & MarkMask)) == mark; }
      inline bool isObjectDead(size_t mark) { return ((size_t)(flags & MarkMask)) != mark; }
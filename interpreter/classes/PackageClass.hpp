@@ -263,6 +263,7 @@ public:
            RexxString    *getTrace();
            ProgramSource *detachSource();
            void           attachSource(ProgramSource *s);
+    inline ProgramSource *getProgramSource() { return source; }
            PackageClass  *newRexx(RexxObject **init_args, size_t argCount);
            RexxString    *getSourceLineRexx(RexxObject *position);
            RexxInteger   *getSourceSizeRexx();
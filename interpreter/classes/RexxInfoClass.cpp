@@ -51,6 +51,9 @@
 #include "SysProcess.hpp"
 #include "ArrayClass.hpp"
 #include "PackageClass.hpp"
+#include "ActivityManager.hpp"
+#include "Activity.hpp"
+#include "InterpreterInstance.hpp"
 
 RexxClass *RexxInfo::classInstance = OREF_NULL;   // singleton class instance
 
@@ -539,3 +542,27 @@ RexxObject *RexxInfo::getDebug()
    return TheFalseObject;
 #endif
 }
+
+
+/**
+ * Return the number of INTERPRET instructions in this interpreter
+ * instance that could reuse previously translated code.
+ *
+ * @return The hit count, as an Integer object.
+ */
+RexxObject *RexxInfo::getInterpretCacheHits()
+{
+    return new_integer(ActivityManager::currentActivity.load()->getInstance()->getInterpretCache().getHits());
+}
+
+
+/**
+ * Return the number of INTERPRET instructions in this interpreter
+ * instance that needed to translate their string.
+ *
+ * @return The miss count, as an Integer object.
+ */
+RexxObject *RexxInfo::getInterpretCacheMisses()
+{
+    return new_integer(ActivityManager::currentActivity.load()->getInstance()->getInterpretCache().getMisses());
+}
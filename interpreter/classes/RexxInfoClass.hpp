@@ -96,6 +96,8 @@ public:
     RexxObject *getRexxExecutable();
     RexxObject *getRexxLibrary();
     RexxObject *getDebug();
+    RexxObject *getInterpretCacheHits();
+    RexxObject *getInterpretCacheMisses();
 
     RexxObject *copyRexx();
     RexxObject *newRexx(RexxObject **args, size_t argc);
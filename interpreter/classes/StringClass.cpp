@@ -212,6 +212,25 @@ HashCode RexxString::getHashValue()
 }
 
 
+/**
+ * Get the hash value used by the equality-based collections.
+ * A subclass of String that has not overridden HASHCODE would
+ * only send a message to arrive at the same string hash, so
+ * we use the cached value directly in that case too.
+ *
+ * @return The hash code for this string.
+ */
+HashCode RexxString::hash()
+{
+    if (isBaseClass() || behaviour->methodLookup(GlobalNames::HASHCODE) == TheStringBehaviour->methodLookup(GlobalNames::HASHCODE))
+    {
+        return getStringHash();
+    }
+    // somebody has supplied their own HASHCODE method, so we need to ask
+    return RexxObject::hash();
+}
+
+
 /**
  * Convert a string returned from an object HashCode() method into
  * a binary hashcode suitable for the hash collections.
@@ -2245,6 +2264,51 @@ RexxString *RexxString::rawString(size_t length)
 }
 
 
+/**
+ * Allocate a string object with room to grow.  This is used
+ * by in-place appends to a variable that holds the only
+ * reference to the string.
+ *
+ * @param length   The initial string length.
+ * @param capacity The length the object has room for.
+ *
+ * @return A raw string object (no data initialization)
+ */
+RexxString *RexxString::rawString(size_t length, size_t capacity)
+{
+    size_t size2 = sizeof(RexxString) - (sizeof(char) * 3) + capacity;
+    RexxString *newObj = (RexxString *)new_object(size2, T_String);
+
+    newObj->setLength(length);
+    newObj->hashValue = 0;
+    newObj->putChar(length, '\0');
+    newObj->setHasNoReferences();
+    return newObj;
+}
+
+
+/**
+ * Make data appended in the unused space of the string
+ * part of its value.  This is only valid while nothing but
+ * the appending variable references this string.
+ *
+ * @param newLength The new string length.  This must not exceed
+ *                  the capacity.
+ */
+void RexxString::extendLength(size_t newLength)
+{
+    length = newLength;
+    putChar(newLength, '\0');
+    // everything cached about the old value is stale now
+    hashValue = 0;
+    attributes.reset();
+    if (numberStringValue != OREF_NULL)
+    {
+        setNumberString(OREF_NULL);
+    }
+}
+
+
 /**
  * Allocate an initialize a string object that will also
  * contain only uppercase characters.  This allows a creation
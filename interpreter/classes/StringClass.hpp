@@ -325,22 +325,16 @@ class RexxString : public RexxObject
 
     HashCode getHashValue() override;
 
+    HashCode hash() override;
+
     inline HashCode getStringHash()
     {
         if (hashValue == 0)                // if we've never generated this, the code is zero
         {
-            size_t len = getLength();
-
-            HashCode h = 0;
             // the hash code is generated from all of the string characters.
             // we do this in a lazy fashion, since most string objects never need to
             // calculate a hash code, particularly the long ones.
-            // This hashing algorithm is very similar to that used for Java strings.
-            for (size_t i = 0; i < len; i++)
-            {
-                h = 31 * h + stringData[i];
-            }
-            hashValue = h;
+            hashValue = StringUtil::hash(stringData, getLength());
         }
         return hashValue;
     }
@@ -538,6 +532,10 @@ class RexxString : public RexxObject
     inline size_t  getLength() const { return length; }
     inline bool isNullString() const { return length == 0; }
     inline void  setLength(size_t l) { length = l; }
+    // the longest value this object can hold, which is larger than the
+    // length for strings allocated with spare room for appends
+    inline size_t getCapacity() { return getObjectSize() - (sizeof(RexxString) - (sizeof(char) * 3)); }
+           void  extendLength(size_t);
     inline void  finish(size_t l) { length = l; }
     inline const char *getStringData() const { return stringData; }
     inline char *getWritableData() { return &stringData[0]; }
@@ -725,6 +723,7 @@ class RexxString : public RexxObject
     static RexxString *newString(const char *, size_t);
     static RexxString *newString(const char *, size_t, const char *, size_t);
     static RexxString *rawString(size_t);
+    static RexxString *rawString(size_t, size_t);
     static RexxString *newUpperString(const char *, size_t);
     static RexxString *newString(double d);
     static RexxString *newString(double d, size_t precision);
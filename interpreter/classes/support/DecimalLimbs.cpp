@@ -0,0 +1,449 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                             DecimalLimbs.cpp   */
+/*                                                                            */
+/* Base 10**9 limb arithmetic for long NumberString operands                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "DecimalLimbs.hpp"
+#include <string.h>
+
+
+/**
+ * Convert a string of decimal digits (one digit value per byte,
+ * most significant first) into limbs.
+ *
+ * @param digits  The digit data.
+ * @param length  The number of digits.
+ * @param trailingZeros
+ *                A count of zero digits to append to the number
+ *                (i.e., the number is multiplied by 10**trailingZeros).
+ * @param limbs   The target limbs.  This must hold
+ *                limbCount(length + trailingZeros) limbs.
+ */
+void DecimalLimbs::fromDigits(const char *digits, size_t length, size_t trailingZeros, uint32_t *limbs)
+{
+    size_t total = length + trailingZeros;
+    size_t count = limbCount(total);
+
+    // each limb holds the digits at positions 9*i to 9*i + 8, counting
+    // from the least significant digit.
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value = 0;
+        size_t high = (i + 1) * LIMB_DIGITS;
+        if (high > total)
+        {
+            high = total;
+        }
+        for (size_t position = high; position > i * LIMB_DIGITS; position--)
+        {
+            size_t p = position - 1;
+            value = value * 10 + (p < trailingZeros ? 0 : digits[length - 1 - (p - trailingZeros)]);
+        }
+        limbs[i] = value;
+    }
+}
+
+
+/**
+ * Convert limbs back into decimal digits.  Exactly length digits
+ * are written, with leading zeros if the value is shorter.
+ *
+ * @param limbs  The source limbs.
+ * @param count  The number of limbs.
+ * @param digits The target digit buffer.
+ * @param length The number of digits to write.
+ */
+void DecimalLimbs::toDigits(const uint32_t *limbs, size_t count, char *digits, size_t length)
+{
+    char *current = digits + length;
+    for (size_t i = 0; i < count && current > digits; i++)
+    {
+        uint32_t value = limbs[i];
+        for (size_t d = 0; d < LIMB_DIGITS && current > digits; d++)
+        {
+            *--current = (char)(value % 10);
+            value /= 10;
+        }
+    }
+    // anything left over is a leading zero
+    memset(digits, 0, current - digits);
+}
+
+
+/**
+ * Add a limb array into a target, propagating the carry through
+ * the target.
+ *
+ * @param target The target limbs.
+ * @param targetLength
+ *               The target length.
+ * @param source The limbs to add.
+ * @param sourceLength
+ *               The source length.  Source limbs beyond the target
+ *               length must be zero.
+ *
+ * @return The carry out of the target.
+ */
+uint32_t DecimalLimbs::add(uint32_t *target, size_t targetLength, const uint32_t *source, size_t sourceLength)
+{
+    uint32_t carry = 0;
+    size_t i = 0;
+    for (; i < sourceLength && i < targetLength; i++)
+    {
+        uint32_t sum = target[i] + source[i] + carry;
+        carry = sum >= BASE;
+        target[i] = carry ? sum - BASE : sum;
+    }
+    for (; carry != 0 && i < targetLength; i++)
+    {
+        uint32_t sum = target[i] + 1;
+        carry = sum >= BASE;
+        target[i] = carry ? 0 : sum;
+    }
+    return carry;
+}
+
+
+/**
+ * Subtract a limb array from a target.  The source must not be
+ * larger than the target.
+ *
+ * @param target The target limbs.
+ * @param targetLength
+ *               The target length.
+ * @param source The limbs to subtract.
+ * @param sourceLength
+ *               The source length.
+ */
+void DecimalLimbs::subtract(uint32_t *target, size_t targetLength, const uint32_t *source, size_t sourceLength)
+{
+    uint32_t borrow = 0;
+    size_t i = 0;
+    for (; i < sourceLength; i++)
+    {
+        uint32_t subtrahend = source[i] + borrow;
+        borrow = target[i] < subtrahend;
+        target[i] = borrow ? target[i] + BASE - subtrahend : target[i] - subtrahend;
+    }
+    for (; borrow != 0 && i < targetLength; i++)
+    {
+        borrow = target[i] == 0;
+        target[i] = borrow ? BASE - 1 : target[i] - 1;
+    }
+}
+
+
+/**
+ * Classic long multiplication of two limb arrays.
+ *
+ * @param a       The first operand.
+ * @param lengthA The first operand length.
+ * @param b       The second operand.
+ * @param lengthB The second operand length.
+ * @param result  The product, lengthA + lengthB limbs.
+ */
+void DecimalLimbs::schoolbookMultiply(const uint32_t *a, size_t lengthA, const uint32_t *b, size_t lengthB, uint32_t *result)
+{
+    memset(result, 0, (lengthA + lengthB) * sizeof(uint32_t));
+    for (size_t i = 0; i < lengthA; i++)
+    {
+        uint64_t multiplier = a[i];
+        if (multiplier == 0)
+        {
+            continue;
+        }
+        uint64_t carry = 0;
+        uint32_t *target = result + i;
+        for (size_t j = 0; j < lengthB; j++)
+        {
+            uint64_t product = multiplier * b[j] + target[j] + carry;
+            carry = product / BASE;
+            target[j] = (uint32_t)(product - carry * BASE);
+        }
+        target[lengthB] = (uint32_t)carry;
+    }
+}
+
+
+/**
+ * Calculate the scratch space required by karatsuba() for
+ * operands of a given length.
+ *
+ * @param length The operand length.
+ *
+ * @return The number of scratch limbs.
+ */
+size_t DecimalLimbs::karatsubaScratch(size_t length)
+{
+    if (length < KARATSUBA_THRESHOLD)
+    {
+        return 0;
+    }
+    size_t high = length - length / 2;
+    return 4 * (high + 1) + karatsubaScratch(high + 1);
+}
+
+
+/**
+ * Karatsuba multiplication of two operands of the same length.
+ * Each operand is split into a low and a high half and the product
+ * is assembled from three half sized products:
+ *
+ *   a*b = z2*B**2m + (z1 - z2 - z0)*B**m + z0
+ *
+ * where z0 = a0*b0, z2 = a1*b1, z1 = (a0 + a1) * (b0 + b1).
+ *
+ * @param a       The first operand.
+ * @param b       The second operand.
+ * @param length  The length of both operands.
+ * @param result  The product, 2 * length limbs.
+ * @param scratch Work space of karatsubaScratch(length) limbs.
+ */
+void DecimalLimbs::karatsuba(const uint32_t *a, const uint32_t *b, size_t length, uint32_t *result, uint32_t *scratch)
+{
+    if (length < KARATSUBA_THRESHOLD)
+    {
+        schoolbookMultiply(a, length, b, length, result);
+        return;
+    }
+
+    size_t low = length / 2;
+    size_t high = length - low;
+
+    // z0 and z2 go directly into their final positions
+    karatsuba(a, b, low, result, scratch);
+    karatsuba(a + low, b + low, high, result + 2 * low, scratch);
+
+    // form the two half sums, which might need an extra limb
+    uint32_t *sumA = scratch;
+    uint32_t *sumB = sumA + high + 1;
+    uint32_t *middle = sumB + high + 1;
+
+    memcpy(sumA, a + low, high * sizeof(uint32_t));
+    sumA[high] = add(sumA, high, a, low);
+    memcpy(sumB, b + low, high * sizeof(uint32_t));
+    sumB[high] = add(sumB, high, b, low);
+
+    karatsuba(sumA, sumB, high + 1, middle, middle + 2 * (high + 1));
+
+    // z1 - z0 - z2, then add into the middle of the result
+    subtract(middle, 2 * (high + 1), result, 2 * low);
+    subtract(middle, 2 * (high + 1), result + 2 * low, 2 * high);
+    add(result + low, length * 2 - low, middle, 2 * (high + 1));
+}
+
+
+/**
+ * Calculate the scratch space required by multiply().
+ *
+ * @param lengthA The first operand length.
+ * @param lengthB The second operand length.
+ *
+ * @return The number of scratch limbs.
+ */
+size_t DecimalLimbs::multiplyScratch(size_t lengthA, size_t lengthB)
+{
+    if (lengthA < lengthB)
+    {
+        size_t temp = lengthA;
+        lengthA = lengthB;
+        lengthB = temp;
+    }
+    if (lengthB < KARATSUBA_THRESHOLD)
+    {
+        return 0;
+    }
+    if (lengthA == lengthB)
+    {
+        return karatsubaScratch(lengthA);
+    }
+    // the long operand is processed in chunks the size of the short one
+    size_t scratch = karatsubaScratch(lengthB);
+    size_t partial = lengthA % lengthB;
+    if (partial != 0)
+    {
+        size_t partialScratch = multiplyScratch(partial, lengthB);
+        scratch = partialScratch > scratch ? partialScratch : scratch;
+    }
+    return 2 * lengthB + scratch;
+}
+
+
+/**
+ * Multiply two limb arrays.
+ *
+ * @param a       The first operand.
+ * @param lengthA The first operand length.
+ * @param b       The second operand.
+ * @param lengthB The second operand length.
+ * @param result  The product, lengthA + lengthB limbs.
+ * @param scratch Work space of multiplyScratch(lengthA, lengthB) limbs.
+ */
+void DecimalLimbs::multiply(const uint32_t *a, size_t lengthA, const uint32_t *b, size_t lengthB, uint32_t *result, uint32_t *scratch)
+{
+    if (lengthA < lengthB)
+    {
+        const uint32_t *temp = a;
+        a = b;
+        b = temp;
+        size_t tempLength = lengthA;
+        lengthA = lengthB;
+        lengthB = tempLength;
+    }
+
+    if (lengthB < KARATSUBA_THRESHOLD)
+    {
+        schoolbookMultiply(a, lengthA, b, lengthB, result);
+        return;
+    }
+    if (lengthA == lengthB)
+    {
+        karatsuba(a, b, lengthA, result, scratch);
+        return;
+    }
+
+    // unbalanced operands.  Multiply the short operand through the long
+    // one in equal sized chunks and add up the partial products.
+    memset(result, 0, (lengthA + lengthB) * sizeof(uint32_t));
+    uint32_t *partial = scratch;
+    for (size_t offset = 0; offset < lengthA; offset += lengthB)
+    {
+        size_t chunk = lengthA - offset < lengthB ? lengthA - offset : lengthB;
+        multiply(a + offset, chunk, b, lengthB, partial, partial + 2 * lengthB);
+        add(result + offset, lengthA + lengthB - offset, partial, chunk + lengthB);
+    }
+}
+
+
+/**
+ * Divide one limb array by another, producing the integer
+ * quotient (Knuth's algorithm D, using base 10**9).
+ *
+ * @param u        The dividend.
+ * @param lengthU  The dividend length.
+ * @param v        The divisor.  The most significant limb must be non-zero.
+ * @param lengthV  The divisor length.  This must not be larger than lengthU.
+ * @param quotient The quotient, lengthU - lengthV + 1 limbs.
+ * @param scratch  Work space of divideScratch(lengthU, lengthV) limbs.
+ */
+void DecimalLimbs::divide(const uint32_t *u, size_t lengthU, const uint32_t *v, size_t lengthV, uint32_t *quotient, uint32_t *scratch)
+{
+    // a single limb divisor is a simple short division
+    if (lengthV == 1)
+    {
+        uint64_t divisor = v[0];
+        uint64_t remainder = 0;
+        for (size_t i = lengthU; i > 0; i--)
+        {
+            uint64_t current = remainder * BASE + u[i - 1];
+            quotient[i - 1] = (uint32_t)(current / divisor);
+            remainder = current % divisor;
+        }
+        return;
+    }
+
+    // normalize so the top divisor limb is at least BASE / 2, which
+    // keeps the quotient estimates within two of the real value.
+    uint32_t *un = scratch;
+    uint32_t *vn = scratch + lengthU + 1;
+    uint64_t scale = BASE / ((uint64_t)v[lengthV - 1] + 1);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < lengthV; i++)
+    {
+        uint64_t product = v[i] * scale + carry;
+        carry = product / BASE;
+        vn[i] = (uint32_t)(product - carry * BASE);
+    }
+    carry = 0;
+    for (size_t i = 0; i < lengthU; i++)
+    {
+        uint64_t product = u[i] * scale + carry;
+        carry = product / BASE;
+        un[i] = (uint32_t)(product - carry * BASE);
+    }
+    un[lengthU] = (uint32_t)carry;
+
+    uint64_t topDivisor = vn[lengthV - 1];
+    uint64_t nextDivisor = vn[lengthV - 2];
+
+    for (size_t j = lengthU - lengthV + 1; j > 0; )
+    {
+        j--;
+        // estimate the quotient limb from the top two dividend limbs
+        uint64_t numerator = (uint64_t)un[j + lengthV] * BASE + un[j + lengthV - 1];
+        uint64_t guess = numerator / topDivisor;
+        uint64_t remainder = numerator % topDivisor;
+
+        while (guess >= BASE || guess * nextDivisor > remainder * BASE + un[j + lengthV - 2])
+        {
+            guess--;
+            remainder += topDivisor;
+            if (remainder >= BASE)
+            {
+                break;
+            }
+        }
+
+        // multiply and subtract the divisor from the current dividend window
+        int64_t borrow = 0;
+        carry = 0;
+        for (size_t i = 0; i < lengthV; i++)
+        {
+            uint64_t product = guess * vn[i] + carry;
+            carry = product / BASE;
+            int64_t difference = (int64_t)un[i + j] - (int64_t)(product - carry * BASE) + borrow;
+            borrow = difference < 0 ? -1 : 0;
+            un[i + j] = (uint32_t)(difference < 0 ? difference + BASE : difference);
+        }
+        int64_t top = (int64_t)un[j + lengthV] - (int64_t)carry + borrow;
+
+        // the guess was one too big (this is rare), so add the divisor back
+        if (top < 0)
+        {
+            guess--;
+            uint32_t addCarry = add(un + j, lengthV, vn, lengthV);
+            top += addCarry;
+        }
+        un[j + lengthV] = (uint32_t)top;
+        quotient[j] = (uint32_t)guess;
+    }
+}
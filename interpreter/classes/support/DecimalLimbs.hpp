@@ -1,12 +1,11 @@
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
-/* Copyright (c) 1995, 2004 IBM Corporation. All rights reserved.             */
-/* Copyright (c) 2005-2014 Rexx Language Association. All rights reserved.    */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
 /*                                                                            */
 /* This program and the accompanying materials are made available under       */
 /* the terms of the Common Public License v1.0 which accompanies this         */
 /* distribution. A copy is also available at the following address:           */
-/* https://www.oorexx.org/license.html                         */
+/* https://www.oorexx.org/license.html                                        */
 /*                                                                            */
 /* Redistribution and use in source and binary forms, with or                 */
 /* without modification, are permitted provided that the following            */
@@ -35,87 +34,52 @@
 /* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include "dblqueue.hpp"
-#include "regexp.hpp"
-
-// constructor: initialize the double queue
-doubleQueue::doubleQueue(int n) : memory(NULL), size(n), head(n/2), tail((n/2)+1)
-{
-  memory = (int*) malloc(sizeof(int)*size);
-  put(SCAN);  // insert delimiter
-}
+/******************************************************************************/
+/* REXX Kernel                                             DecimalLimbs.hpp   */
+/*                                                                            */
+/* Base 10**9 limb arithmetic for long NumberString operands                  */
+/*                                                                            */
+/******************************************************************************/
+#ifndef Included_DecimalLimbs
+#define Included_DecimalLimbs
 
-// destructor: free memory
-doubleQueue::~doubleQueue()
-{
-  if (memory) free(memory);
-}
+#include <stdint.h>
+#include <stddef.h>
 
-/**************************************************/
-/* doubleQueue::push                              */
-/*                                                */
-/* push an element at the beginning of the queue. */
-/**************************************************/
-void doubleQueue::push(int value)
+/**
+ * Arithmetic on unsigned integers held as arrays of base 10**9
+ * limbs, least significant limb first.  NumberString keeps one
+ * decimal digit per byte, which makes the digit by digit
+ * multiply and divide loops quadratic in the digit count with a
+ * large constant.  Converting long operands to limbs lets each
+ * step work on nine digits at a time, and the results convert
+ * back to exactly the same decimal digits.
+ */
+class DecimalLimbs
 {
-  memory[head] = value;
-  if (head == 0) enlarge();
-  head--;
-}
+public:
+    static const uint32_t BASE = 1000000000;
+    static const size_t LIMB_DIGITS = 9;
+    // below this many limbs, schoolbook multiplication is faster than Karatsuba
+    static const size_t KARATSUBA_THRESHOLD = 40;
 
-/*******************************************/
-/* doubleQueue::put                        */
-/*                                         */
-/* put an element at the end of the queue. */
-/*******************************************/
-void doubleQueue::put(int value)
-{
-  memory[tail] = value;
-  tail++;
-  if (tail == size) enlarge();
-}
+    static inline size_t limbCount(size_t digits) { return (digits + LIMB_DIGITS - 1) / LIMB_DIGITS; }
 
-/****************************************************/
-/* doubleQueue::pop                                 */
-/*                                                  */
-/* get the first element of the queue and remove it */
-/* from the queue.                                  */
-/****************************************************/
-int doubleQueue::pop()
-{
-  int value = 0;
+    static void fromDigits(const char *digits, size_t length, size_t trailingZeros, uint32_t *limbs);
+    static void toDigits(const uint32_t *limbs, size_t count, char *digits, size_t length);
 
-  if (head < tail) {
-    head++;
-    value = memory[head];
-  }
+    static size_t multiplyScratch(size_t lengthA, size_t lengthB);
+    static void multiply(const uint32_t *a, size_t lengthA, const uint32_t *b, size_t lengthB, uint32_t *result, uint32_t *scratch);
 
-  return value;
-}
+    static inline size_t divideScratch(size_t lengthU, size_t lengthV) { return lengthU + 1 + lengthV; }
+    static void divide(const uint32_t *u, size_t lengthU, const uint32_t *v, size_t lengthV, uint32_t *quotient, uint32_t *scratch);
 
-/*******************************************************/
-/* doubleQueue::enlarge                                */
-/*                                                     */
-/* the queue is an array holding the elements. if the  */
-/* head or tail pointer pass the limits of the array,  */
-/* it needs to be enlarged. reallocation is used here. */
-/*******************************************************/
-void doubleQueue::enlarge()
-{
-  int *newmemory = (int*) malloc(sizeof(int)*2*size);
-  int *oldmemory = memory;
-  int offset = size>>2;
+protected:
+    static void schoolbookMultiply(const uint32_t *a, size_t lengthA, const uint32_t *b, size_t lengthB, uint32_t *result);
+    static void karatsuba(const uint32_t *a, const uint32_t *b, size_t length, uint32_t *result, uint32_t *scratch);
+    static size_t karatsubaScratch(size_t length);
+    static uint32_t add(uint32_t *target, size_t targetLength, const uint32_t *source, size_t sourceLength);
+    static void subtract(uint32_t *target, size_t targetLength, const uint32_t *source, size_t sourceLength);
+};
 
-  if (newmemory) {
-//    memset(newmemory,0x00,sizeof(int)*2*size);
-    memcpy(newmemory+offset,memory,size*sizeof(int));
-    head+=offset;
-    tail+=offset;
-    size<<=1;
-    memory = newmemory;
-    free(oldmemory);
-  }
-}
+#endif
@@ -81,7 +81,7 @@ void HashCollection::initialize(size_t capacity)
     if (contents == OREF_NULL)
     {
         size_t bucketSize = calculateBucketSize(capacity);
-        contents = allocateContents(bucketSize, bucketSize * 2);
+        contents = allocateContents(bucketSize);
     }
 }
 
@@ -104,7 +104,7 @@ void HashCollection::expandContents()
 void HashCollection::expandContents(size_t capacity )
 {
     size_t bucketSize = calculateBucketSize(capacity);
-    Protected<HashContents> newContents = allocateContents(bucketSize, bucketSize * 2);
+    Protected<HashContents> newContents = allocateContents(bucketSize);
     // copy all of the items into the new table
     contents->reMerge(newContents);
     // if this is a contents item in the old space, we need to
@@ -138,10 +138,12 @@ void HashCollection::ensureCapacity(size_t delta)
 
 
 /**
- * Calculate an optimal bucket size for a given capacity.  This
- * is derived from how Java calculates this.  This will generally
- * allocate more entries than asked for, but will generally
- * have a lower collision rate than using it directly.
+ * Calculate an optimal bucket size for a given capacity.  The
+ * result is the number of slots for the hash contents, which is
+ * always a power of two so that the contents can select a slot
+ * with a mask rather than a divide.  The slot count is large
+ * enough that the requested number of items can be added without
+ * exceeding the contents load limit.
  *
  * @param capacity The desired capacity.
  *
@@ -156,19 +158,14 @@ size_t HashCollection::calculateBucketSize(size_t capacity)
         return 1 << 30;
     }
 
-    if (capacity < MinimumBucketSize)
+    // round up to a power of two that leaves enough free slots
+    size_t bucketSize = MinimumBucketSize;
+    while (HashContents::slotCapacity(bucketSize) < capacity)
     {
-        return MinimumBucketSize;
+        bucketSize <<= 1;
     }
 
-    // we prefer to have a odd number for the bucket size, so add
-    // 1 if we end up with an even number.
-    if ((capacity & 1) == 0)
-    {
-        capacity += 1;
-    }
-
-    return capacity;
+    return bucketSize;
 }
 
 
@@ -802,14 +799,13 @@ StringHashCollection::StringHashCollection(size_t capacity)
  * collection.  Collections with special requirements should
  * override this and return the appropriate subclass.
  *
- * @param bucketSize The bucket size of the collection.
- * @param totalSize  The total capacity of the collection.
+ * @param bucketSize The number of slots in the collection.
  *
  * @return A new HashContents object appropriate for this collection type.
  */
-HashContents *StringHashCollection::allocateContents(size_t bucketSize, size_t totalSize)
+HashContents *StringHashCollection::allocateContents(size_t bucketSize)
 {
-    return new (totalSize) StringHashContents(bucketSize, totalSize);
+    return new (bucketSize) StringHashContents(bucketSize);
 }
 
 
@@ -1073,14 +1069,13 @@ EqualityHashCollection::EqualityHashCollection(size_t capacity)
  * collection.  Collections with special requirements should
  * override this and return the appropriate subclass.
  *
- * @param bucketSize The bucket size of the collection.
- * @param totalSize  The total capacity of the collection.
+ * @param bucketSize The number of slots in the collection.
  *
  * @return A new HashContents object appropriate for this collection type.
  */
-HashContents *IdentityHashCollection::allocateContents(size_t bucketSize, size_t totalSize)
+HashContents *IdentityHashCollection::allocateContents(size_t bucketSize)
 {
-    return new (totalSize) IdentityHashContents(bucketSize, totalSize);
+    return new (bucketSize) IdentityHashContents(bucketSize);
 }
 
 
@@ -1089,14 +1084,13 @@ HashContents *IdentityHashCollection::allocateContents(size_t bucketSize, size_t
  * collection.  Collections with special requirements should
  * override this and return the appropriate subclass.
  *
- * @param bucketSize The bucket size of the collection.
- * @param totalSize  The total capacity of the collection.
+ * @param bucketSize The number of slots in the collection.
  *
  * @return A new HashContents object appropriate for this collection type.
  */
-HashContents *EqualityHashCollection::allocateContents(size_t bucketSize, size_t totalSize)
+HashContents *EqualityHashCollection::allocateContents(size_t bucketSize)
 {
-    return new (totalSize) EqualityHashContents(bucketSize, totalSize);
+    return new (bucketSize) EqualityHashContents(bucketSize);
 }
 
 
@@ -65,7 +65,7 @@ class HashCollection : public RexxObject
     RexxInternalObject *copy() override;
     ArrayClass *makeArray() override;
 
-    virtual HashContents *allocateContents(size_t bucketSize, size_t capacity) = 0;
+    virtual HashContents *allocateContents(size_t bucketSize) = 0;
     virtual void validateIndex(RexxObject *&index);
     virtual void validateValueIndex(RexxObject *&value, RexxObject *&index);
     virtual bool requiresRehash() { return true; }
@@ -122,12 +122,13 @@ class HashCollection : public RexxObject
     // do this based off of items(), which can be overridden
     inline bool   isEmpty() { return items() == 0; }
 
-    // minimum bucket size we'll work with
-    static const size_t MinimumBucketSize = 17;
+    // minimum bucket size we'll work with (this must be a power of two, and
+    // at least as large as the contents probe group size)
+    static const size_t MinimumBucketSize = 16;
 
     // Our default bucket size (currently the same as the minimum, but
     // it does not need to be)
-    static const size_t DefaultTableSize = 17;
+    static const size_t DefaultTableSize = 16;
 
     HashContents *contents;           // the backing hash table collection.
 
@@ -150,7 +151,7 @@ public:
             IdentityHashCollection(size_t capacity);
     inline  IdentityHashCollection() { ; }
 
-    HashContents *allocateContents(size_t bucketSize, size_t capacity) override;
+    HashContents *allocateContents(size_t bucketSize) override;
 };
 
 
@@ -164,7 +165,7 @@ public:
             EqualityHashCollection(size_t capacity);
     inline  EqualityHashCollection() { ; }
 
-    HashContents *allocateContents(size_t bucketSize, size_t capacity) override;
+    HashContents *allocateContents(size_t bucketSize) override;
 };
 
 
@@ -179,7 +180,7 @@ public:
             StringHashCollection(size_t capacity);
     inline  StringHashCollection() { ; }
 
-    HashContents *allocateContents(size_t bucketSize, size_t capacity) override;
+    HashContents *allocateContents(size_t bucketSize) override;
     void validateIndex(RexxObject *&index) override;
     // string collections don't require a rehash
     bool requiresRehash() override { return false; }
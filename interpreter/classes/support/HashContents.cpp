@@ -49,20 +49,65 @@
 #include "MethodArguments.hpp"
 
 
+// SSE2 is part of every x86-64 processor, so the group probes need no
+// runtime checks.  Other processors step through the control bytes one at a time.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSE2_PROBE
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+#ifdef SSE2_PROBE
+/**
+ * Return the index of the lowest bit set in a (non-zero) mask.
+ *
+ * @param mask   The bit mask.
+ *
+ * @return The bit index.
+ */
+static inline unsigned int lowestBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+
+/**
+ * Calculate the storage size needed for a contents object.
+ *
+ * @param size     The base size of the object.
+ * @param capacity The number of slots.
+ *
+ * @return The size in bytes, including the entries and the control bytes.
+ */
+static inline size_t contentsSize(size_t size, size_t capacity)
+{
+    return size + (sizeof(HashContents::ContentEntry) * (capacity - 1)) + capacity + HashContents::GroupSize;
+}
+
+
 /**
  * Allocate a new IdentityHashContent item.
  *
  * @param size     The base size of the object.
- * @param capacity The capacity in entries (must be greater than zero)
+ * @param capacity The capacity in slots (must be a power of two)
  *
  * @return The backing storage for a content instance.
  */
 void *IdentityHashContents::operator new(size_t size, size_t capacity)
 {
-    size_t bytes = size + (sizeof(ContentEntry) * (capacity - 1));
-
     // now allocate the suggested bucket size
-    return new_object(bytes, T_IdentityHashContents, capacity * 2);
+    return new_object(contentsSize(size, capacity), T_IdentityHashContents, capacity * 2);
 }
 
 
@@ -70,16 +115,14 @@ void *IdentityHashContents::operator new(size_t size, size_t capacity)
  * Allocate a new EqualityHashContent item.
  *
  * @param size     The base size of the object.
- * @param capacity The capacity in entries (must be greater than zero)
+ * @param capacity The capacity in slots (must be a power of two)
  *
  * @return The backing storage for a content instance.
  */
 void *EqualityHashContents::operator new(size_t size, size_t capacity)
 {
-    size_t bytes = size + (sizeof(ContentEntry) * (capacity - 1));
-
     // now allocate the suggested bucket size
-    return new_object(bytes, T_EqualityHashContents, capacity * 2);
+    return new_object(contentsSize(size, capacity), T_EqualityHashContents, capacity * 2);
 }
 
 
@@ -87,16 +130,14 @@ void *EqualityHashContents::operator new(size_t size, size_t capacity)
  * Allocate a new MultiValueContents item.
  *
  * @param size     The base size of the object.
- * @param capacity The capacity in entries (must be greater than zero)
+ * @param capacity The capacity in slots (must be a power of two)
  *
  * @return The backing storage for a content instance.
  */
 void *MultiValueContents::operator new(size_t size, size_t capacity)
 {
-    size_t bytes = size + (sizeof(ContentEntry) * (capacity - 1));
-
     // now allocate the suggested bucket size
-    return new_object(bytes, T_MultiValueContents, capacity * 2);
+    return new_object(contentsSize(size, capacity), T_MultiValueContents, capacity * 2);
 }
 
 
@@ -104,25 +145,23 @@ void *MultiValueContents::operator new(size_t size, size_t capacity)
  * Allocate a new StringHashContents item.
  *
  * @param size     The base size of the object.
- * @param capacity The capacity in entries (must be greater than zero)
+ * @param capacity The capacity in slots (must be a power of two)
  *
  * @return The backing storage for a content instance.
  */
 void *StringHashContents::operator new(size_t size, size_t capacity)
 {
-    size_t bytes = size + (sizeof(ContentEntry) * (capacity - 1));
-
     // now allocate the suggested bucket size
-    return new_object(bytes, T_StringHashContents, capacity * 2);
+    return new_object(contentsSize(size, capacity), T_StringHashContents, capacity * 2);
 }
 
 
 /**
  * Construct a HashContent item of the given size.
  *
- * @param entries The total number of entries in the object.
+ * @param entries The total number of slots in the object.
  */
-HashContents::HashContents(size_t entries, size_t total)
+HashContents::HashContents(size_t entries)
 {
     // clear the entire object for safety
     clearObject();
@@ -130,39 +169,24 @@ HashContents::HashContents(size_t entries, size_t total)
     // this is the total number of slots in the table.  The
     // optimal bucket size should already have been calculated
     bucketSize = entries;
-    // this is the total size of the bucket
-    totalSize = total;
+    // this is the number of items we allow before expanding
+    totalSize = slotCapacity(entries);
 
-    // initialize the free chains
-    initializeFreeChain();
+    // mark all of the slots as empty
+    initializeControls();
 }
 
 
 /**
- * Initialize the free chains, either at construction time or
+ * Initialize the control bytes, either at construction time or
  * after an empty() operation.
  */
-void HashContents::initializeFreeChain()
+void HashContents::initializeControls()
 {
-    // initialize the next link in all bucket slots to NoMore.
-    for (ItemLink i = 0; i < bucketSize; i++)
-    {
-        entries[i].next = NoMore;
-    }
-
-    // this is an empty bucket
+    // this is an empty table
     itemCount = 0;
-
-    // we keep the available items on a chain, so
-    // chain up the items into a free chain
-    freeChain = bucketSize;
-
-    for (ItemLink i = freeChain; i < totalSize; i++)
-    {
-        entries[i].next = i + 1;
-    }
-    // make sure the last item ends the chain
-    entries[totalSize - 1].next = NoMore;
+    // every slot is available, including the mirrored group at the end
+    memset(controls(), EmptySlot, bucketSize + GroupSize);
 }
 
 
@@ -173,7 +197,7 @@ void HashContents::initializeFreeChain()
  */
 void HashContents::live(size_t liveMark)
 {
-    for (size_t i = 0; i < totalSize; i++)
+    for (size_t i = 0; i < bucketSize; i++)
     {
         memory_mark(entries[i].index);
         memory_mark(entries[i].value);
@@ -188,7 +212,7 @@ void HashContents::live(size_t liveMark)
  */
 void HashContents::liveGeneral(MarkReason reason)
 {
-    for (size_t i = 0; i < totalSize; i++)
+    for (size_t i = 0; i < bucketSize; i++)
     {
         memory_mark_general(entries[i].index);
         memory_mark_general(entries[i].value);
@@ -204,7 +228,7 @@ void HashContents::liveGeneral(MarkReason reason)
 void HashContents::flatten(Envelope *envelope)
 {
     setUpFlatten(HashContents)
-    for (size_t i = 0; i < totalSize; i++)
+    for (size_t i = 0; i < bucketSize; i++)
     {
         flattenRef(entries[i].index);
         flattenRef(entries[i].value);
@@ -213,6 +237,66 @@ void HashContents::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Scan forward along a probe sequence for the next slot that
+ * is either empty or has a control tag matching the target.
+ * The table is never allowed to fill completely, so this will
+ * always find a slot.
+ *
+ * @param position The starting slot.
+ * @param tag      The target tag.  Passing EmptySlot will locate
+ *                 the next empty slot.
+ *
+ * @return The located slot position.
+ */
+HashContents::ItemLink HashContents::nextCandidate(ItemLink position, uint8_t tag)
+{
+    const uint8_t *control = controls();
+
+#ifdef SSE2_PROBE
+    // compare an entire group of control bytes at a time.  Empty slots have
+    // the high bit set, so movemask picks those up directly.
+    __m128i tagBytes = _mm_set1_epi8((char)tag);
+    for (;;)
+    {
+        __m128i group = _mm_loadu_si128((const __m128i *)(control + position));
+        uint32_t hits = (uint32_t)(_mm_movemask_epi8(_mm_cmpeq_epi8(group, tagBytes)) | _mm_movemask_epi8(group));
+        if (hits != 0)
+        {
+            return (position + lowestBit(hits)) & (bucketSize - 1);
+        }
+        position = (position + GroupSize) & (bucketSize - 1);
+    }
+#else
+    for (;;)
+    {
+        uint8_t slotTag = control[position];
+        if (slotTag == tag || slotTag == EmptySlot)
+        {
+            return position;
+        }
+        position = nextSlot(position);
+    }
+#endif
+}
+
+
+/**
+ * Locate a starting point for a full table traversal.  We start
+ * just after an empty slot, so that no run of occupied slots
+ * wraps around the traversal end.  This keeps entries with the
+ * same index in probe order, and allows the entry under the
+ * cursor to be removed without disturbing entries we've already
+ * visited.
+ *
+ * @return The empty slot that bounds the traversal.
+ */
+HashContents::ItemLink HashContents::scanStart()
+{
+    return nextCandidate(0, EmptySlot);
+}
+
+
 /**
  * Put an item into the hashtable.  Default behavior is
  * to replace any existing items.
@@ -228,115 +312,85 @@ void HashContents::put(RexxInternalObject *value, RexxInternalObject *index)
     // NOTE:  This depends on the caller to make sure there is
     // room in the table for this item!
 
-    // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = hashIndex(index);
+    ItemLink position;
 
-    // if the hash slot is empty, we can just fill this in right here
-    if (isAvailable(position))
+    // if we already have this index, just replace the value
+    if (findEntry(index, hash, position))
     {
-        setEntry(position, value, index);
-        // new item, so bump the count
-        itemCount++;
+        setValue(position, value);
         return;
     }
 
-    ItemLink previous = NoLink;
-
-    // this slot is in use.  We either A) have this entry already, in
-    // which case we replace the value, or B) need to add another entry to the end
-    do
-    {
-        // if we got a hit, just change the slot position
-        if (isIndex(position, index))
-        {
-            // everything worked, we have room.  No additional items added to
-            // this table.
-            setValue(position, value);
-            return;
-        }
-
-        // continue running the chain to the end of the list.
-        previous = position;
-        position = entries[position].next;
-    } while (position != NoMore);
-
-    // append a new value.
-    append(value, index, previous);
+    // the search leaves us at the empty slot that ends the probe sequence
+    insertEntry(position, value, index, hash);
 }
 
 
 /**
- * Add a link to a slot position chain.
+ * Fill in an empty slot with a new entry.
  *
+ * @param position The target (empty) slot.
  * @param value    The value to add.
  * @param index    The index value.
- * @param position The position of the last link in the chain.
+ * @param hash     The scrambled hash of the index.
  */
-void HashContents::append(RexxInternalObject *value, RexxInternalObject * index, ItemLink position)
+void HashContents::insertEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash)
 {
-    // we keep all of the free items in a chain, so we can just pull
-    // the first entry off of the chain.  In theory, we've already checked
-    // that we're not full, so we should find one there.
-
-    ItemLink newEntry = freeChain;
-
     // belt-and-braces...this should not occur...but give a logic
     // error if it does occur, since that indicates something bad has
     // occurred.
-    if (newEntry == NoMore)
+    if (itemCount >= bucketSize - 1)
     {
         Interpreter::logicError("Attempt to add an object to a full Hash table");
     }
 
-    // close up the chain
-    freeChain = entries[newEntry].next;
-
-    // set the entry
-    setEntry(newEntry, value, index);
-    // add this to the end of the chain
-    setNext(position, newEntry);
-    setNext(newEntry, NoMore);
-
-    // we have a new item in the list.
+    setEntry(position, value, index, hash);
+    // we have a new item in the table.
     itemCount++;
 }
 
 
 /**
- * Add a link to a slot position chain  This adds it at the
- * FRONT of the chain.
+ * Insert a new entry in front of an existing entry.  All of
+ * the entries between that position and the end of the probe
+ * sequence move up by one slot, which keeps them reachable from
+ * their home slots and keeps their relative order.
  *
+ * @param position The position of the entry that will follow the new one.
  * @param value    The value to add.
  * @param index    The index value.
- * @param position The position of the chain anchor.
+ * @param hash     The scrambled hash of the index.
  */
-void HashContents::insert(RexxInternalObject *value, RexxInternalObject * index, ItemLink position)
+void HashContents::insertBefore(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash)
 {
-    // we keep all of the free items in a chain, so we can just pull
-    // the first entry off of the chain.  In theory, we've already checked
-    // that we're not full, so we should find one there.
-
-    ItemLink newEntry = freeChain;
+    // find the end of the run of occupied slots
+    ItemLink slot = nextCandidate(position, EmptySlot);
 
-    // belt-and-braces...this should not occur
-    if (newEntry == NoMore)
+    // and move everything up by one
+    while (slot != position)
     {
-        Interpreter::logicError("Attempt to add an object to a full Hash table");
+        ItemLink previous = previousSlot(slot);
+        copyEntry(slot, previous);
+        slot = previous;
     }
 
-    // close up the chain
-    freeChain = entries[newEntry].next;
-
-    // copy the anchor position to this new entry
-    copyEntry(newEntry, position);
+    // and fill in the vacated slot
+    insertEntry(position, value, index, hash);
+}
 
-    // set the anchor item to the new values
-    setEntry(position, value, index);
-    // and chain the new entry off of this.
-    setNext(position, newEntry);
 
-    // we have a new item in the list.
-    itemCount++;
+/**
+ * Add an entry to the end of the probe sequence for its hash,
+ * following any other entries with the same index.
+ *
+ * @param value  The value to add.
+ * @param index  The index value.
+ * @param hash   The scrambled hash of the index.
+ */
+void HashContents::appendEntry(RexxInternalObject *value, RexxInternalObject *index, HashCode hash)
+{
+    insertEntry(nextCandidate(homeSlot(hash), EmptySlot), value, index, hash);
 }
 
 
@@ -350,95 +404,120 @@ void HashContents::insert(RexxInternalObject *value, RexxInternalObject * index,
 RexxInternalObject *HashContents::remove(RexxInternalObject *index)
 {
     ItemLink position;
-    ItemLink previous;
 
     // go find the matching entry.  We have nothing to do if not there.
-    if (!locateEntry(index, position, previous))
+    if (!locateEntry(index, position))
     {
         return OREF_NULL;
     }
 
     // save the original value
     RexxInternalObject *removed = entryValue(position);
-    // remove the chain link and return the value
-    removeChainLink(position, previous);
+    // remove the entry and return the value
+    removeEntry(position);
     return removed;
 }
 
 
 /**
- * Remove a link from the chain, taking into consideration
- * where the link occurs.  This will add a new link to
- * the free chain.
+ * Remove the entry at a given position.  Any following entries
+ * that can be moved closer to their home slot are shifted back
+ * into the hole, so no probe sequence is ever broken by an
+ * empty slot.
  *
  * @param position The position we're removing.
- * @param previous The previous chain entry (NoLink value if this is the head of the chain).
  */
-void HashContents::removeChainLink(ItemLink &position, ItemLink previous)
+void HashContents::removeEntry(ItemLink position)
 {
     // reduce the item count for this removal.
     itemCount--;
 
-    // are we removing the first item in the chain?  We can't move this
-    // to the free list because this is the anchor for the hash postion.
-    // we need to either promote the next item to the front of the chain
-    // or clear this item out if this is also the end of the chain
-    if (previous == NoLink)
+    ItemLink hole = position;
+    ItemLink slot = nextSlot(hole);
+
+    while (isInUse(slot))
     {
-        ItemLink next = nextEntry(position);
-        // just the single item on the chain?  reset to empty state and we're done.
-        if (next == NoMore)
+        // this entry can fill the hole if the hole lies between
+        // its home slot and where it currently resides.
+        ItemLink home = homeSlot(entries[slot].hash);
+        if (((slot - home) & (bucketSize - 1)) >= ((slot - hole) & (bucketSize - 1)))
         {
-            clearEntry(position);
-            return;
+            copyEntry(hole, slot);
+            hole = slot;
         }
-        // copy the next item to the head of the list
-        copyEntry(position, next);
-        // return the next entry to the free chain
-        returnToFreeChain(next);
-    }
-    else
-    {
-        // close up the chain, and and also update the
-        // previous position if we still need to run the chain
-        closeChain(position, previous);
-        position = nextEntry(previous);
+        slot = nextSlot(slot);
     }
+
+    // whatever position we ended up with is the one that gets emptied
+    clearEntry(hole);
 }
 
 
 /**
- * Locate an entry in the table.
+ * Search the probe sequence for an index.
  *
  * @param index    The target entry index.
- * @param position The return position if located.
- * @param previous The previous link if located.  Has the value NoLink if
- *                 the located item is the chain anchor.
+ * @param hash     The scrambled hash of the index.
+ * @param position The located position.  If the index is not
+ *                 found, this is the empty slot that ends the probe
+ *                 sequence.
  *
  * @return true if the item is located, false for a failure
  */
-bool HashContents::locateEntry(RexxInternalObject *index, ItemLink &position, ItemLink &previous)
+bool HashContents::findEntry(RexxInternalObject *index, HashCode hash, ItemLink &position)
 {
-    // get the bucket position to start searching
-    position = hashIndex(index);
-    previous = NoLink;
+    position = homeSlot(hash);
+
+    // most entries live in their home slot, so check that entry directly before
+    // going to the control bytes.  This saves touching a second cache line for
+    // the common case.
+    RexxInternalObject *entryIndex = entries[position].index;
+    if (entryIndex == OREF_NULL)
+    {
+        return false;
+    }
+    if (entries[position].hash == hash && isIndexEqual(index, entryIndex))
+    {
+        return true;
+    }
+
+    uint8_t tag = hashTag(hash);
+    position = nextSlot(position);
 
-    // ok, run the chain searching for an index match.
-    while (position != NoMore && isInUse(position))
+    for (;;)
     {
-        // have a match? return to the caller.  All of the position
-        // stuff should be set now
-        if (isIndex(position, index))
+        position = nextCandidate(position, tag);
+        // hit the end of the probe sequence, we don't have this item
+        if (isAvailable(position))
+        {
+            return false;
+        }
+        // have a match? return to the caller.
+        if (isIndex(position, index, hash))
         {
             return true;
         }
-        // remember the previous position (needed for chain updates)
-        previous = position;
-        // step to the next link in the chain
-        position = nextEntry(position);
+        position = nextSlot(position);
+    }
+}
+
+
+/**
+ * Locate an entry in the table.
+ *
+ * @param index    The target entry index.
+ * @param position The return position if located.
+ *
+ * @return true if the item is located, false for a failure
+ */
+bool HashContents::locateEntry(RexxInternalObject *index, ItemLink &position)
+{
+    if (findEntry(index, hashIndex(index), position))
+    {
+        return true;
     }
 
-    // hit the end of the chain, we don't have this item
+    // we don't have this item
     position = NoMore;
     return false;
 }
@@ -459,51 +538,41 @@ void HashContents::nextMatch(RexxInternalObject *index, ItemLink &position)
         return;
     }
 
-    // step to the next position
-    position = nextEntry(position);
+    // any other match will have the same hash as the one we're on
+    HashCode hash = entries[position].hash;
+    uint8_t tag = hashTag(hash);
 
-    // keep looping until the end of this chain
-    while (position != NoMore)
+    for (;;)
     {
+        position = nextCandidate(nextSlot(position), tag);
+        // hit the end of the probe sequence, we're done
+        if (isAvailable(position))
+        {
+            position = NoMore;
+            return;
+        }
         // if this is a match, we're done
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             return;
         }
-        // step to the next position
-        position = nextEntry(position);
     }
-
-    // hit the end of the chain, we don't have this item
-    // (position also marks this as the end)
-    return;
 }
 
 
 /**
- * Iterate to the next occupied entry of the list.
+ * Iterate to the next occupied entry of the table.
  *
  * @param position   The starting position.
- * @param nextBucket The next bucket to step to once this chain is used up.
+ * @param remaining  The number of slots still to be visited.
  */
-void HashContents::iterateNext(ItemLink &position, ItemLink &nextBucket)
+void HashContents::iterateNext(ItemLink &position, size_t &remaining)
 {
-    // have a good current position...step to the next chain item.
-    if (position != NoMore)
-    {
-        // if we still have a chain, then we can just return this position as the next one
-        position = nextEntry(position);
-        if (position != NoMore)
-        {
-            return;
-        }
-    }
-
-    // look for another bucket with an active chain.
-    while (nextBucket < bucketSize)
+    while (remaining > 0)
     {
-        position = nextBucket++;
-        // if this bucket position is active, we've found our match
+        position = nextSlot(position);
+        remaining--;
+        // if this slot is active, we've found our match
         if (isInUse(position))
         {
             return;
@@ -519,171 +588,73 @@ void HashContents::iterateNext(ItemLink &position, ItemLink &nextBucket)
  * iterator position to the next location.
  *
  * @param position   The current position.
- * @param nextBucket The nextBucket we advance to.
+ * @param remaining  The number of slots still to be visited.
  */
-void HashContents::iterateNextAndRemove(ItemLink &position, ItemLink &nextBucket)
+void HashContents::iterateNextAndRemove(ItemLink &position, size_t &remaining)
 {
-    // a remove operation is special if the we're at the head of the chain,
-    // since a remove operation will move another item.  into the slot, if
-    // there is one.
-    if (isBucketPosition(position))
-    {
-        // if this is the only item in this bucket, we can just
-        // advance normally, then remove the item.
-        if (nextEntry(position) == NoMore)
-        {
-            // save this for the deletion
-            ItemLink current = position;
-            iterateNext(position, nextBucket);
-            // perform the removal now that we've moved
-            removeChainLink(current, NoLink);
-        }
-        // we're at the head of the chain and we need to remove this
-        // item.  This will move the next item into the bucket slot, which
-        // means if we just remove the item, our position information will already
-        // be correct.
-        else
-        {
-            removeChainLink(position, NoLink);
-        }
-    }
-    // we're past the bucket position in the chain.  To delete this,
-    // we need to know the previous item.  However, if we advance to the
-    // next position first, that information will still be correct after deletion.
-    else
+    removeEntry(position);
+    // the removal might have shifted a following entry into this slot.  That
+    // entry has not been visited yet, so it becomes our next position.
+    if (isInUse(position))
     {
-        // save the bucket chain anchor and current position for the removal.
-        ItemLink current = position;
-        ItemLink currentBucket = nextBucket - 1;
-        // we need this also
-        ItemLink previous = position;
-        // advance to the next position.
-        iterateNext(position, nextBucket);
-        // now find the previous entry so we can remove the item
-        locatePreviousEntry(previous, currentBucket);
-        // do the removal.
-        removeChainLink(current, previous);
+        return;
     }
+    iterateNext(position, remaining);
 }
 
 
 /**
- * Iterate to the next occupied entry of the list in reverse
- * bucket order.
+ * Iterate to the next occupied entry of the table in reverse
+ * order.
  *
  * @param position   The starting position.
- * @param currentBucket The current bucket we're iterating on.
- *
- */
-void HashContents::iterateNextReverse(ItemLink &position, ItemLink &currentBucket)
-{
-    // The position will always be valid because we're backing up the chain to the
-    // bucket anchor.  If we're at the bucket anchor, we then locate the last position
-    // in the next occupied bucket
-    if (position == currentBucket)
-    {
-        // step to the next bucket and see if we have a next entry
-        currentBucket++;
-        locateNextBucketEnd(position, currentBucket);
-    }
-    // we're traversing
-    else
-    {
-        // we don't maintain back links, so we need to scan.  Not
-        // terribly efficient, but the buckets don't tend to get very long
-        // and we don't do this all that often.
-        locatePreviousEntry(position, currentBucket);
-    }
-}
-
-
-/**
- * Locate the end of the next occupied hash bucket in this
- * collection.
- *
- * @param position The returned position (NoMore indicates we've hit the end)
- * @param currentBucket
- *                 The starting bucket to search.  Updated to the new bucket
- *                 if something is found.
+ * @param remaining  The number of slots still to be visited.
  */
-void HashContents::locateNextBucketEnd(ItemLink &position, ItemLink &currentBucket)
+void HashContents::iterateNextReverse(ItemLink &position, size_t &remaining)
 {
-    // search each of the buckets in turn looking for an occupied one.
-    while (currentBucket < bucketSize)
+    while (remaining > 0)
     {
-        // if we have an entry in the first position, this is the one we want
-        if (isInUse(currentBucket))
+        position = previousSlot(position);
+        remaining--;
+        if (isInUse(position))
         {
-            // set the pointer at the beginning
-            position = currentBucket;
-            // locate the last entry in the bucket
-            while(nextEntry(position) != NoMore)
-            {
-                position = nextEntry(position);
-            }
             return;
         }
-        // try the next bucket
-        currentBucket++;
     }
-
     // indicate we've hit the iteration end
     position = NoMore;
 }
 
 
-/**
- * Locate the entry that precedes the current bucket item.
- *
- * @param position The current position in the chain.  Note:  we've already determined
- *                 that we are not at the anchor position.
- * @param currentBucket
- *                 The bucket anchor item.
- */
-void HashContents::locatePreviousEntry(ItemLink &position, ItemLink currentBucket)
-{
-    // just run the chain until we find the next item
-    while (nextEntry(currentBucket) != position)
-    {
-        currentBucket = nextEntry(currentBucket);
-    }
-    position = currentBucket;
-}
-
-
 /**
  * Locate an entry in the table by index/item pair
  *
  * @param index    The target entry index.
  * @param position The return position if located.
- * @param previous The previous link if located.  Has the value NoLink if
- *                 the located item is the chain anchor.
  *
  * @return true if the item is located, false for a failure
  */
-bool HashContents::locateEntry(RexxInternalObject *index, RexxInternalObject *item, ItemLink &position, ItemLink &previous)
+bool HashContents::locateEntry(RexxInternalObject *index, RexxInternalObject *item, ItemLink &position)
 {
-    // get the bucket position to start searching
-    position = hashIndex(index);
-    previous = NoLink;
+    HashCode hash = hashIndex(index);
+    uint8_t tag = hashTag(hash);
+    position = homeSlot(hash);
 
-    // ok, run the chain searching for an index match.
-    while (position != NoMore && isInUse(position))
+    for (;;)
     {
-        // have a match? return to the caller.  All of the position
-        // stuff should be set now
-        if (isItem(position, index, item))
+        position = nextCandidate(position, tag);
+        // hit the end of the probe sequence, we don't have this item
+        if (isAvailable(position))
+        {
+            position = NoMore;
+            return false;
+        }
+        if (entries[position].hash == hash && isItem(position, index, item))
         {
             return true;
         }
-        // remember the previous position (needed for chain updates)
-        previous = position;
-        // step to the next link in the chain
-        position = nextEntry(position);
+        position = nextSlot(position);
     }
-
-    // hit the end of the chain, we don't have this item
-    return false;
 }
 
 
@@ -692,42 +663,23 @@ bool HashContents::locateEntry(RexxInternalObject *index, RexxInternalObject *it
  *
  * @param item     The target item.
  * @param position The return position if located.
- * @param previous The previous link if located.  Has the value NoLink if
- *                 the located item is the chain anchor.
  *
  * @return true if the item is located, false for a failure
  */
-bool HashContents::locateItem(RexxInternalObject *item, ItemLink &position, ItemLink &previous)
+bool HashContents::locateItem(RexxInternalObject *item, ItemLink &position)
 {
-    // locating an item requires a table search.  Since we also want to locate what
-    // chain this is on, we perform the search by running the chains in each bucket position.
-    // since this does not scan any of the entries on the free chain, this method
-    // could be faster than a brute force table search.
-
-    for (size_t i = 0; i < bucketSize; i++)
+    // locating an item requires a table search.
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        position = i;
-        previous = NoLink;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
+        if (isItem(iterator.position, item))
         {
-            // have a match? return to the caller.  All of the position
-            // stuff should be set now
-            if (isItem(position, item))
-            {
-                return true;
-            }
-            // remember the previous position (needed for chain updates)
-            previous = position;
-            // step to the next link in the chain
-            position = nextEntry(position);
+            position = iterator.position;
+            return true;
         }
     }
 
-    // hit the end of the bucket list, we don't have this item
+    // hit the end of the table, we don't have this item
+    position = NoMore;
     return false;
 }
 
@@ -742,27 +694,35 @@ bool HashContents::locateItem(RexxInternalObject *item, ItemLink &position, Item
  */
 ArrayClass *HashContents::removeAll(RexxInternalObject *index)
 {
-    ItemLink position;
-    ItemLink previous = NoLink;
-
     // get a count of matching items
-    size_t count = countAllIndex(index, position);
+    size_t count = countAllIndex(index);
     // get a result array
     ArrayClass *result = new_array(count);
 
-    // if we have items to copy, run the chain and copy the index matches
-    for (size_t i = 1; i <= count; i++)
+    HashCode hash = hashIndex(index);
+    uint8_t tag = hashTag(hash);
+    ItemLink position = homeSlot(hash);
+    size_t nextIndex = 1;
+
+    // run the probe sequence and remove the index matches
+    while (nextIndex <= count)
     {
-        // find an index match
-        while (!isIndex(position, index))
+        position = nextCandidate(position, tag);
+        if (isAvailable(position))
+        {
+            break;
+        }
+        if (isIndex(position, index, hash))
+        {
+            // add this to the array.  The removal shifts the following
+            // entries back, so we look at this slot again.
+            result->put(entryValue(position), nextIndex++);
+            removeEntry(position);
+        }
+        else
         {
-            previous = position;
-            position = nextEntry(position);
+            position = nextSlot(position);
         }
-        // add this to the array and step again
-        result->put(entryValue(position), i);
-        // remove the link (which will also adjust the position
-        removeChainLink(position, previous);
     }
 
     // return our result array
@@ -787,18 +747,17 @@ RexxInternalObject *HashContents::removeItem(RexxInternalObject *value, RexxInte
     }
 
     ItemLink position;
-    ItemLink previous;
 
     // go find the matching entry.  We have nothing to do if not there.
-    if (!locateEntry(index, value, position, previous))
+    if (!locateEntry(index, value, position))
     {
         return OREF_NULL;
     }
 
     // save the original value
     RexxInternalObject *removed = entryValue(position);
-    // remove the chain link and return the value
-    removeChainLink(position, previous);
+    // remove the entry and return the value
+    removeEntry(position);
     return removed;
 }
 
@@ -820,10 +779,9 @@ bool HashContents::hasItem(RexxInternalObject *value, RexxInternalObject *index
     }
 
     ItemLink position;
-    ItemLink previous;
 
     // just run the locate operation
-    return locateEntry(index, value, position, previous);
+    return locateEntry(index, value, position);
 }
 
 
@@ -837,10 +795,9 @@ bool HashContents::hasItem(RexxInternalObject *value, RexxInternalObject *index
 bool HashContents::hasItem(RexxInternalObject *item)
 {
     ItemLink position;
-    ItemLink previous;
 
     // just run the locate operation
-    return locateItem(item, position, previous);
+    return locateItem(item, position);
 }
 
 
@@ -854,18 +811,17 @@ bool HashContents::hasItem(RexxInternalObject *item)
 RexxInternalObject *HashContents::removeItem(RexxInternalObject *item)
 {
     ItemLink position;
-    ItemLink previous;
 
     // go find the matching entry.  We have nothing to do if not there.
-    if (!locateItem(item, position, previous))
+    if (!locateItem(item, position))
     {
         return OREF_NULL;
     }
 
     // save the original value
     RexxInternalObject *removed = entryValue(position);
-    // remove the chain link and return the value
-    removeChainLink(position, previous);
+    // remove the entry and return the value
+    removeEntry(position);
     return removed;
 }
 
@@ -887,23 +843,23 @@ RexxInternalObject *HashContents::removeItem(RexxInternalObject *item)
  */
 RexxInternalObject *HashContents::nextItem(RexxInternalObject *value, RexxInternalObject *index)
 {
-    ItemLink position = hashIndex(index);
+    HashCode hash = hashIndex(index);
+    uint8_t tag = hashTag(hash);
+    ItemLink position = homeSlot(hash);
 
-    // loop the chain until we
-    while (position != NoMore && isInUse(position))
+    // run the probe sequence until we find the pair
+    for (position = nextCandidate(position, tag); isInUse(position); position = nextCandidate(nextSlot(position), tag))
     {
         // if we've found the pair, search for the next entry with the same index value.
         if (entries[position].matches(index, value))
         {
-            position = nextEntry(position);
-            while (position != NoMore && isInUse(position))
+            for (position = nextCandidate(nextSlot(position), tag); isInUse(position); position = nextCandidate(nextSlot(position), tag))
             {
                 // we're only looking for index matches from this point
                 if (entries[position].matches(index))
                 {
                     return entryValue(position);
                 }
-                position = nextEntry(position);
             }
             // no next item found
             return TheNilObject;
@@ -927,10 +883,9 @@ RexxInternalObject *HashContents::nextItem(RexxInternalObject *value, RexxIntern
 RexxInternalObject *HashContents::get(RexxInternalObject *index)
 {
     ItemLink position;
-    ItemLink previous;
 
     // go find the matching entry.  We have nothing to do if not there.
-    if (!locateEntry(index, position, previous))
+    if (!findEntry(index, hashIndex(index), position))
     {
         return OREF_NULL;
     }
@@ -949,10 +904,9 @@ RexxInternalObject *HashContents::get(RexxInternalObject *index)
 bool HashContents::hasIndex(RexxInternalObject *index)
 {
     ItemLink position;
-    ItemLink previous;
 
     // go find the matching entry... return the success indicator
-    return locateEntry(index, position, previous);
+    return findEntry(index, hashIndex(index), position);
 }
 
 
@@ -972,10 +926,8 @@ size_t HashContents::items(RexxInternalObject *index)
         return items();
     }
 
-    ItemLink position;
-
     // get a count of matching items
-    return countAllIndex(index, position);
+    return countAllIndex(index);
 }
 
 
@@ -988,27 +940,16 @@ size_t HashContents::items(RexxInternalObject *index)
  */
 ArrayClass  *HashContents::getAll(RexxInternalObject *index)
 {
-    ItemLink position;
-    ItemLink previous = NoLink;
-
     // get a count of matching items
-    size_t count = countAllIndex(index, position);
+    size_t count = countAllIndex(index);
     // get a result array
     ArrayClass *result = new_array(count);
 
-    // if we have items to copy, run the chain and copy the index matches
-    for (size_t i = 1; i <= count; i++)
+    // if we have items to copy, run the probe sequence and copy the index matches
+    IndexIterator iterator = this->iterator(index);
+    for (size_t i = 1; i <= count && iterator.isAvailable(); i++, iterator.next())
     {
-        // find an index match
-        while (!isIndex(position, index))
-        {
-            previous = position;
-            position = nextEntry(position);
-        }
-        // add this to the array and step again
-        result->put(entryValue(position), i);
-        // step to the next chain item
-        position = nextEntry(position);
+        result->put(iterator.value(), i);
     }
 
     // return our result array
@@ -1019,28 +960,17 @@ ArrayClass  *HashContents::getAll(RexxInternalObject *index)
 /**
  * Return a count of all entries with a given index.
  *
- * @param index
- * @param anchorPosition The returned hash bucket position for
- *                the head of the chain.
+ * @param index  The target index.
  *
  * @return The count of matching items.
  */
-size_t HashContents::countAllIndex(RexxInternalObject *index, ItemLink &anchorPosition)
+size_t HashContents::countAllIndex(RexxInternalObject *index)
 {
     size_t count = 0;
-    // make sure we pass the anchor position back
-    anchorPosition = hashIndex(index);
-    ItemLink position = anchorPosition;
 
-    while (position != NoMore && isInUse(position))
+    for (IndexIterator iterator = this->iterator(index); iterator.isAvailable(); iterator.next())
     {
-        // compare the index values
-        if (isIndex(position, index))
-        {
-            count++;
-        }
-
-        position = nextEntry(position);
+        count++;
     }
     return count;
 }
@@ -1055,30 +985,14 @@ size_t HashContents::countAllIndex(RexxInternalObject *index, ItemLink &anchorPo
  */
 size_t HashContents::countAllItem(RexxInternalObject *item)
 {
-    // locating an item requires a table search.  Since we also want to locate what
-    // chain this is on, we perform the search by running the chains in each bucket position.
-    // since this does not scan any of the entries on the free chain, this method
-    // could be faster than a brute force table search.
-
+    // locating an item requires a table search.
     size_t count = 0;
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
+        if (isItem(iterator.position, item))
         {
-            // have a match? return to the caller.  All of the position
-            // stuff should be set now
-            if (isItem(position, item))
-            {
-                count++;
-            }
-            // step to the next link in the chain
-            position = nextEntry(position);
+            count++;
         }
     }
 
@@ -1109,29 +1023,17 @@ ArrayClass  *HashContents::allIndex(RexxInternalObject *item)
 
     size_t nextIndex = 1;
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
+        if (isItem(iterator.position, item))
         {
-            // have a match? return to the caller.  All of the position
-            // stuff should be set now
-            if (isItem(position, item))
+            // add to the result array, and if we've found the last match,
+            // time to return.
+            result->put(iterator.index(), nextIndex++);
+            if (nextIndex > count)
             {
-                // add to the result array, and if we've found the last match,
-                // time to return.
-                result->put(entryIndex(position), nextIndex++);
-                if (nextIndex > count)
-                {
-                    return result;
-                }
+                return result;
             }
-            // step to the next link in the chain
-            position = nextEntry(position);
         }
     }
     return result;
@@ -1150,10 +1052,9 @@ ArrayClass  *HashContents::allIndex(RexxInternalObject *item)
 RexxInternalObject *HashContents::getIndex(RexxInternalObject *item)
 {
     ItemLink position;
-    ItemLink previous;
 
     // locate the item and return NULL if not found.
-    if (!locateItem(item, position, previous))
+    if (!locateItem(item, position))
     {
         return OREF_NULL;
     }
@@ -1176,21 +1077,10 @@ void HashContents::merge(HashCollection *target)
     // we're going to add so that the expansion can be handled up front.
     target->ensureCapacity(itemCount);
 
-    // loop through all of the bucket items
-    for (size_t i = 0; i < bucketSize; i++)
+    // poke each item into the other table
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // poke this item into the other table
-            target->mergeItem(entryValue(position), entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        target->mergeItem(iterator.value(), iterator.index());
     }
 }
 
@@ -1210,21 +1100,10 @@ void HashContents::putAll(HashCollection *target)
     // we're going to add so that the expansion can be handled up front.
     target->ensureCapacity(itemCount);
 
-    // loop through all of the bucket items
-    for (size_t i = 0; i < bucketSize; i++)
+    // poke each item into the other table
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // poke this item into the other table
-            target->put(entryValue(position), entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        target->put(iterator.value(), iterator.index());
     }
 }
 
@@ -1240,37 +1119,16 @@ void HashContents::reMerge(HashContents *newHash)
     // one important aspect of a merge operation is keeping
     // values with identical indexes in the same relative order
     // after the merge (very important when merging MethodDirectories,
-    // for example.  We process the merge by running each bucket chain,
-    // and it is important that the target collection's mergeItem
-    // method adds this to the end of the chain rather than to the beginning.
+    // for example.  The table traversal visits entries with the same
+    // index in probe order, and appending each one to the end of the
+    // probe sequence in the new table keeps that order.  The stored hash
+    // values are reused, so no index needs to be hashed again.
 
     // NOTE:  this merger is being doing under the assumption that the
     // hew hash contents is larger than the current.
-
-    // loop through all of the bucket items
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // poke this item into the other table.  We don't know
-            // the characteristics of the target, so we might have
-            // multiple hits on any given index.  We need to perform
-            // this merge A) without losing any items in the collection and
-            // B) keeping the relative order of duplicate indexes (very
-            // important for MethodDictionaries, for example, which are
-            // dependent on ordering of items in the table).  Therefore,
-            // we do the merge by running each bucket chain and
-            // using the add() method to add each additional item to the
-            // end of the chain.
-            newHash->add(entryValue(position), entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        newHash->appendEntry(iterator.value(), iterator.index(), entries[iterator.position].hash);
     }
 }
 
@@ -1304,38 +1162,17 @@ void HashContents::mergePut(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
-    // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = hashIndex(index);
+    ItemLink position;
 
-    // if the hash slot is empty, we can just fill this in right here
-    if (isAvailable(position))
+    // if we got a hit, nothing added, but this "worked"
+    if (findEntry(index, hash, position))
     {
-        setEntry(position, item, index);
-        // new item, so bump the count
-        itemCount++;
         return;
     }
 
-    ItemLink previous = NoLink;
-
-    // this slot is in use.  We either A) have this entry already, in
-    // which case we just return, or B) need to add another entry to the end
-    do
-    {
-        // if we got a hit, just change the slot position
-        if (isIndex(position, index))
-        {
-            // nothing added, but this "worked"
-            return;
-        }
-
-        // continue running the chain to the end of the list.
-        previous = position;
-        position = entries[position].next;
-    } while (position != NoMore);
-
-    // This was not already in the table, so add a new value to the chain
-    append(item, index, previous);
+    // This was not already in the table, so add a new value at the end of the probe sequence
+    insertEntry(position, item, index, hash);
 }
 
 
@@ -1349,33 +1186,11 @@ ArrayClass  *HashContents::allItems()
     // get an array to hold the result
     ArrayClass *result = new_array(itemCount);
 
-    // no need to search again if we don't have any matches
-    if (itemCount == 0)
-    {
-        return result;
-    }
-
     size_t nextIndex = 1;
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // add to the result array, and if we've found the last match,
-            // time to return.
-            result->put(entryValue(position), nextIndex++);
-            if (nextIndex > itemCount)
-            {
-                return result;
-            }
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        result->put(iterator.value(), nextIndex++);
     }
 
     return result;
@@ -1389,23 +1204,15 @@ void HashContents::empty()
 {
     for (size_t i = 0; i < bucketSize; i++)
     {
-        // if the first item of this bucket is in use
+        // clear each item.  Note that because of setField()
+        // considerations, we can't just use a memset.
         if (isInUse(i))
         {
-            // run the chain, clearing each item.  Note that because of
-            // setField() considerations, we can't just use a memset.
-            ItemLink position = i;
-            do
-            {
-                // get the next link before clearing
-                ItemLink next = nextEntry(position);
-                clearEntry(position);
-                position = next;
-            } while (position != NoMore);
+            clearEntry(i);
         }
     }
-    // reset the free chains for the overflow area.
-    initializeFreeChain();
+    // and reset all of the slots
+    initializeControls();
 }
 
 
@@ -1419,33 +1226,11 @@ ArrayClass *HashContents::allIndexes()
     // get an array to hold the result
     ArrayClass *result = new_array(itemCount);
 
-    // no need to search again if we don't have any matches
-    if (itemCount == 0)
-    {
-        return result;
-    }
-
     size_t nextIndex = 1;
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // add to the result array, and if we've found the last match,
-            // time to return.
-            result->put(entryIndex(position), nextIndex++);
-            if (nextIndex > itemCount)
-            {
-                return result;
-            }
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        result->put(iterator.index(), nextIndex++);
     }
 
     return result;
@@ -1465,20 +1250,10 @@ ArrayClass *HashContents::uniqueIndexes()
     // leave the implementation in the base
     Protected<TableClass> indexSet = new_table(items());
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // add to the result table.
-            indexSet->put(TheNilObject, entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        // add to the result table.
+        indexSet->put(TheNilObject, iterator.index());
     }
     // now return the reduced index set
     return indexSet->allIndexes();
@@ -1495,41 +1270,20 @@ SupplierClass *HashContents::supplier()
     // get out target count and get arrays for both the values and indexes
     size_t count = itemCount;
 
-    ArrayClass *values = new_array(count);
-    ArrayClass *indexes = new_array(count);
-
-    // if this is empty, no need to scan the table
-    if (count == 0)
-    {
-        return new_supplier(values, indexes);
-    }
+    Protected<ArrayClass> values = new_array(count);
+    Protected<ArrayClass> indexes = new_array(count);
 
     size_t nextIndex = 1;
 
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // add to the result table.
-            indexes->put(entryIndex(position), nextIndex);
-            values->put(entryValue(position), nextIndex++);
-            if (nextIndex > count)
-            {
-                // return the new supplier
-                return new_supplier(values, indexes);
-            }
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        // add to the result arrays.
+        indexes->put(iterator.index(), nextIndex);
+        values->put(iterator.value(), nextIndex++);
     }
 
-    // should never get here.
-    return OREF_NULL;
+    // return the new supplier
+    return new_supplier(values, indexes);
 }
 
 
@@ -1572,20 +1326,10 @@ SupplierClass *HashContents::supplier(RexxInternalObject *index)
  */
 void HashContents::reHash(HashContents *newHash)
 {
-    for (size_t i = 0; i < bucketSize; i++)
+    // the hash values might have changed, so these need to go through put()
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // poke into the other table
-            newHash->put(entryValue(position), entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+        newHash->put(iterator.value(), iterator.index());
     }
 }
 
@@ -1607,39 +1351,17 @@ void HashContents::add(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
-    // calculate the bucket position
-    ItemLink position = hashIndex(index);
-
-    // if the hash slot is empty, we can just fill this in right here
-    if (isAvailable(position))
-    {
-        setEntry(position, item, index);
-        // new item, so bump the count
-        itemCount++;
-        return;
-    }
-
-    ItemLink previous = NoLink;
-
-    // this slot is in use.  ok, just run to the end of the chain to find the insertion position.
-    do
-    {
-        // continue running the chain to the end of the list.
-        previous = position;
-        position = entries[position].next;
-    } while (position != NoMore);
-
-    // append a new value.
-    append(item, index, previous);
+    // this just goes at the end of the probe sequence
+    appendEntry(item, index, hashIndex(index));
 }
 
 
 /**
  * Add an element to a hash table without accounting
- * for duplicates.  This operation adds the item to the front of
- * the bucket chain so that a search on this index will return
- * this item, essentially overriding any other item already in
- * the collection.
+ * for duplicates.  This operation adds the item in front of
+ * any other entries with the same index so that a search on
+ * this index will return this item, essentially overriding any
+ * other item already in the collection.
  *
  * @param item   The value to add.
  * @param index  The index this will be added under.
@@ -1651,20 +1373,19 @@ void HashContents::addFront(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
-    // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = hashIndex(index);
+    ItemLink position;
 
-    // if the hash slot is empty, we can just fill this in right here
-    if (isAvailable(position))
+    // if we have other entries with this index, this goes in front of the first one.
+    if (findEntry(index, hash, position))
     {
-        setEntry(position, item, index);
-        // new item, so bump the count
-        itemCount++;
-        return;
+        insertBefore(position, item, index, hash);
+    }
+    // otherwise, we can just fill in the empty slot at the end of the probe sequence
+    else
+    {
+        insertEntry(position, item, index, hash);
     }
-
-    // insert at the front of the bucket.
-    insert(item, index, position);
 }
 
 
@@ -1673,19 +1394,10 @@ void HashContents::addFront(RexxInternalObject *item, RexxInternalObject *index)
  */
 void HashContents::copyValues()
 {
-    for (size_t i = 0; i < bucketSize; i++)
+    for (TableIterator iterator = this->iterator(); iterator.isAvailable(); iterator.next())
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
-
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // copy the value at every position
-            setValue(position, entryValue(position)->copy());
-            position = nextEntry(position);
-        }
+        // copy the value at every position
+        iterator.replace(iterator.value()->copy());
     }
 }
 
@@ -1696,16 +1408,19 @@ void HashContents::copyValues()
  * @param position The table position.
  * @param value    The value to set.
  * @param index    The index to set.
+ * @param hash     The scrambled hash of the index.
  */
-void HashContents::setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index)
+void HashContents::setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash)
 {
     setField(entries[position].value, value);
     setField(entries[position].index, index);
+    entries[position].hash = hash;
+    setControl(position, hashTag(hash));
 }
 
 
 /**
- * clear an entry in the chain
+ * clear an entry in the table
  *
  * @param position The entry position.
  */
@@ -1714,8 +1429,9 @@ void HashContents::clearEntry(ItemLink position)
     // clear out the value/index fields
     setField(entries[position].value, OREF_NULL);
     setField(entries[position].index, OREF_NULL);
-    // clear the link also.
-    entries[position].next = NoMore;
+    // and mark the slot as available
+    entries[position].hash = 0;
+    setControl(position, EmptySlot);
 }
 
 
@@ -1742,11 +1458,10 @@ void HashContents::setValue(ItemLink position, RexxInternalObject *value)
 HashContents::IndexIterator HashContents::iterator(RexxInternalObject *index)
 {
     ItemLink position;
-    ItemLink previous;
 
     // try to find the first matching item.  At this point,
     // we don't really care if this succeeds or fails
-    locateEntry(index, position, previous);
+    locateEntry(index, position);
 
     return IndexIterator(this, index, position);
 }
@@ -1760,14 +1475,14 @@ HashContents::IndexIterator HashContents::iterator(RexxInternalObject *index)
  */
 HashContents::TableIterator HashContents::iterator()
 {
-    ItemLink position = NoMore;
-    ItemLink nextBucket = 0;
+    ItemLink position = scanStart();
+    size_t remaining = bucketSize - 1;
 
     // try to find the first real item.
     // we don't really care if this succeeds or fails
-    iterateNext(position, nextBucket);
+    iterateNext(position, remaining);
 
-    return TableIterator(this, position, nextBucket);
+    return TableIterator(this, position, remaining);
 }
 
 
@@ -1779,12 +1494,12 @@ HashContents::TableIterator HashContents::iterator()
  */
 HashContents::ReverseTableIterator HashContents::reverseIterator()
 {
-    ItemLink position = NoMore;
-    ItemLink currentBucket = 0;
+    ItemLink position = scanStart();
+    size_t remaining = bucketSize - 1;
 
-    // Ue use thnd the first real item.
+    // find the last real item.
     // we don't really care if this succeeds or fails
-    locateNextBucketEnd(position, currentBucket);
+    iterateNextReverse(position, remaining);
 
-    return ReverseTableIterator(this, position, currentBucket);
+    return ReverseTableIterator(this, position, remaining);
 }
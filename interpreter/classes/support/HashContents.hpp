@@ -56,6 +56,16 @@ class HashCollection;
  * there is a separate collection class that implements
  * the collection interface and allocates a backing
  * context.
+ *
+ * The entries are kept in a single open-addressed table that
+ * is searched with linear probing.  Each slot has a control
+ * byte holding 7 bits of the index hash (or the empty marker),
+ * and the control bytes are stored together after the entries
+ * so that a probe can filter a group of slots with a single
+ * vector compare before touching any of the entries.  Removals
+ * shift the following entries back into the hole, so there are
+ * no tombstones, and entries with the same index always appear
+ * along the probe sequence in the order they were added.
  */
 class HashContents : public RexxInternalObject
 {
@@ -65,8 +75,12 @@ public:
 
     // link terminator
     static const ItemLink NoMore = SIZE_MAX;
-    // indicates not linked
-    static const ItemLink NoLink = SIZE_MAX;
+
+    // control byte value for an unused slot.  Used slots hold a 7-bit hash tag.
+    static const uint8_t EmptySlot = 0x80;
+    // the number of control bytes examined in a single probe step.  The first
+    // group of control bytes is mirrored after the end so a group load never wraps.
+    static const size_t GroupSize = 16;
 
 
     /**
@@ -104,24 +118,24 @@ public:
 		friend class HashContents;
 
 	public:
-        inline TableIterator() : contents(OREF_NULL), position(0), nextBucket(0) { }
+        inline TableIterator() : contents(OREF_NULL), position(0), remaining(0) { }
 		inline ~TableIterator() {}
 
         inline bool isAvailable()  { return position != NoMore; }
         inline RexxInternalObject *value() { return contents->entryValue(position); }
         inline RexxInternalObject *index() { return contents->entryIndex(position); }
         inline void replace(RexxInternalObject *v) { contents->setValue(position, v); }
-        inline void next() { contents->iterateNext(position, nextBucket); }
-        inline void removeAndAdvance() { contents->iterateNextAndRemove(position, nextBucket); }
+        inline void next() { contents->iterateNext(position, remaining); }
+        inline void removeAndAdvance() { contents->iterateNextAndRemove(position, remaining); }
 
 	private:
         // constructor for an index iterator
-		TableIterator(HashContents *c, ItemLink p, ItemLink n)
-            : contents(c), position(p), nextBucket(n) { }
+		TableIterator(HashContents *c, ItemLink p, size_t r)
+            : contents(c), position(p), remaining(r) { }
 
         HashContents *contents;
         ItemLink position;
-        ItemLink nextBucket;
+        size_t remaining;
 	};
 
 
@@ -135,23 +149,23 @@ public:
 		friend class HashContents;
 
 	public:
-        inline ReverseTableIterator() : contents(OREF_NULL), position(0), currentBucket(0) { }
+        inline ReverseTableIterator() : contents(OREF_NULL), position(0), remaining(0) { }
 		inline ~ReverseTableIterator() {}
 
         inline bool isAvailable()  { return position != NoMore; }
         inline RexxInternalObject *value() { return contents->entryValue(position); }
         inline RexxInternalObject *index() { return contents->entryIndex(position); }
         inline void replace(RexxInternalObject *v) { contents->setValue(position, v); }
-        inline void next() { contents->iterateNextReverse(position, currentBucket); }
+        inline void next() { contents->iterateNextReverse(position, remaining); }
 
 	private:
         // constructor for an index iterator
-		ReverseTableIterator(HashContents *c, ItemLink p, ItemLink n)
-            : contents(c), position(p), currentBucket(n) { }
+		ReverseTableIterator(HashContents *c, ItemLink p, size_t r)
+            : contents(c), position(p), remaining(r) { }
 
         HashContents *contents;
         ItemLink position;
-        ItemLink currentBucket;
+        size_t remaining;
 	};
 
     /**
@@ -168,11 +182,11 @@ public:
 
         RexxInternalObject *index;           // item index object
         RexxInternalObject *value;           // item value object
-        ItemLink next;                       // next item in overflow bucket
+        HashCode hash;                       // the scrambled hash of the index
     };
 
     inline HashContents() { ; };
-           HashContents(size_t entries, size_t total);
+           HashContents(size_t entries);
 
     void live(size_t) override;
     void liveGeneral(MarkReason reason) override;
@@ -194,52 +208,88 @@ public:
     }
 
     // default index hashing method.  bypass the hash() method and directly use the hash value
-    virtual ItemLink hashIndex(RexxInternalObject *index)
+    virtual HashCode hashIndex(RexxInternalObject *index)
     {
         // Note: even though we are using object reference identity to find a match,
         // we use the hash value returned from getHashValue() rather than the identityHash
         // because identityTables stored in the saved image or compiled programs will have
         // a different reference value (and thus a different identifyHash) on restore, meaning
         // that lookups against these tables may fail.
-        return (ItemLink)(index->getHashValue() % bucketSize);
+        return scrambleHash(index->getHashValue());
     }
 
-    void initializeFreeChain();
+    // Identity-based hash values have low-order bits that are always zero, so the
+    // value is scrambled before use so that all of the bits take part in selecting
+    // the home slot (the low bits) and the control tag (the high bits).
+    static inline HashCode scrambleHash(HashCode h)
+    {
+        h *= (HashCode)0x9e3779b97f4a7c15ULL;
+        h ^= h >> (sizeof(HashCode) * 4);
+        return h;
+    }
 
-    // set the entry values for a position
-    void setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index);
+    // the control byte tag for a scrambled hash value
+    static inline uint8_t hashTag(HashCode h)
+    {
+        return (uint8_t)(h >> (sizeof(HashCode) * 8 - 7));
+    }
 
-    // clear and entry in the chain
-    void clearEntry(ItemLink position);
+    // the first slot of the probe sequence for a scrambled hash value.  The slot
+    // count is always a power of two, so this is a mask rather than a divide.
+    inline ItemLink homeSlot(HashCode h)
+    {
+        return (ItemLink)(h & (bucketSize - 1));
+    }
 
-    // update a next entry
-    void setNext(ItemLink position, ItemLink next) { entries[position].next = next; }
+    // step forward or back along the probe sequence
+    inline ItemLink nextSlot(ItemLink position) { return (position + 1) & (bucketSize - 1); }
+    inline ItemLink previousSlot(ItemLink position) { return (position - 1) & (bucketSize - 1); }
 
-    // copy an entry contents into another entry
-    inline void copyEntry(ItemLink target, ItemLink source)
+    /**
+     * Calculate the number of items a table with a given number of
+     * slots can hold before it needs to be expanded.  The control
+     * byte groups keep long probe sequences cheap, so we allow the
+     * table to get seven eighths full.  This also guarantees that
+     * every probe sequence ends at an empty slot.
+     *
+     * @param slots  The number of slots in the table.
+     *
+     * @return The item capacity of the table.
+     */
+    static inline size_t slotCapacity(size_t slots)
     {
-        // copy all of the information
-        setEntry(target, entryValue(source), entryIndex(source));
-        entries[target].next = entries[source].next;
+        return slots - slots / 8;
     }
 
-    // remove a non-anchor entry from a hash chain
-    inline void closeChain(ItemLink position, ItemLink previous)
+    // the control bytes follow the last entry
+    inline uint8_t *controls() { return (uint8_t *)(entries + bucketSize); }
+
+    // set the control byte for a slot, keeping the mirrored group in sync
+    inline void setControl(ItemLink position, uint8_t tag)
     {
-        entries[previous].next = entries[position].next;
-        // move the removed item back to the free chain and
-        // clear it out
-        returnToFreeChain(position);
+        uint8_t *control = controls();
+        control[position] = tag;
+        if (position < GroupSize)
+        {
+            control[bucketSize + position] = tag;
+        }
     }
 
-    // return an entry to the free chain
-    inline void  returnToFreeChain(ItemLink position)
+    void initializeControls();
+    ItemLink nextCandidate(ItemLink position, uint8_t tag);
+    ItemLink scanStart();
+
+    // set the entry values for a position
+    void setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash);
+
+    // clear and entry in the table
+    void clearEntry(ItemLink position);
+
+    // copy an entry contents into another entry
+    inline void copyEntry(ItemLink target, ItemLink source)
     {
-        // clear the entry, then place at the head of the
-        // free chain.
-        clearEntry(position);
-        entries[position].next = freeChain;
-        freeChain = position;
+        // copy all of the information
+        setEntry(target, entryValue(source), entryIndex(source), entries[source].hash);
     }
 
     // set the value in an existing entry
@@ -251,6 +301,12 @@ public:
         return isIndexEqual(index, entries[position].index);
     }
 
+    // perform an index comparison for a position, checking the stored hash first
+    inline bool isIndex(ItemLink position, RexxInternalObject *index, HashCode hash)
+    {
+        return entries[position].hash == hash && isIndexEqual(index, entries[position].index);
+    }
+
     // perform an item comparison for a position
     inline bool isItem(ItemLink position, RexxInternalObject *item)
     {
@@ -264,21 +320,15 @@ public:
     }
 
     // check if an entry is availabe
-    inline bool isAvailable(ItemLink postion)
+    inline bool isAvailable(ItemLink position)
     {
-        return entries[postion].isAvailable();
+        return controls()[position] == EmptySlot;
     }
 
     // check if an entry is availabe
-    inline bool isInUse(ItemLink postion)
+    inline bool isInUse(ItemLink position)
     {
-        return !entries[postion].isAvailable();
-    }
-
-    // step to the next position in the chain
-    inline ItemLink nextEntry(ItemLink position)
-    {
-        return entries[position].next;
+        return controls()[position] != EmptySlot;
     }
 
     // get the value for an entry
@@ -296,7 +346,7 @@ public:
     // test if the table is full
     inline bool isFull()
     {
-        return freeChain == NoMore;
+        return itemCount >= totalSize;
     }
 
     // check if this table can hold an additional number of items (usually used on merge operations)
@@ -305,9 +355,6 @@ public:
         return totalSize - itemCount > count;
     }
 
-    // test if a position is a bucket anchor position.
-    inline bool isBucketPosition(ItemLink position) { return position < bucketSize; }
-
     /**
      * Return the total current capacity.
      *
@@ -318,36 +365,25 @@ public:
         return totalSize;
     }
 
-
-    /**
-     * Return the bucket size of the contents.
-     *
-     * @return The hash bucket size
-     */
-    inline size_t hashBucket()
-    {
-        return bucketSize;
-    }
-
     // NOTE:  put() is virtual so that specialized hash tables can
     // override put() and change the replace vs. add semantics.
     virtual void put(RexxInternalObject *value, RexxInternalObject *index);
 
     inline size_t items() { return itemCount; }
     inline bool isEmpty() { return itemCount == 0; }
-    void append(RexxInternalObject *value, RexxInternalObject * index, ItemLink position);
-    void insert(RexxInternalObject *value, RexxInternalObject * index, ItemLink position);
+    void insertEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash);
+    void insertBefore(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash);
+    void appendEntry(RexxInternalObject *value, RexxInternalObject *index, HashCode hash);
     RexxInternalObject *remove(RexxInternalObject *index);
-    void removeChainLink(ItemLink &position, ItemLink previous);
-    bool locateEntry(RexxInternalObject *index, ItemLink &position, ItemLink &previous);
-    bool locateEntry(RexxInternalObject *index, RexxInternalObject *item, ItemLink &position, ItemLink &previous);
-    bool locateItem(RexxInternalObject *item, ItemLink &position, ItemLink &previous);
+    void removeEntry(ItemLink position);
+    bool findEntry(RexxInternalObject *index, HashCode hash, ItemLink &position);
+    bool locateEntry(RexxInternalObject *index, ItemLink &position);
+    bool locateEntry(RexxInternalObject *index, RexxInternalObject *item, ItemLink &position);
+    bool locateItem(RexxInternalObject *item, ItemLink &position);
     void nextMatch(RexxInternalObject *index, ItemLink &position);
-    void iterateNext(ItemLink &position, ItemLink &nextBucket);
-    void iterateNextAndRemove(ItemLink &position, ItemLink &nextBucket);
-    void iterateNextReverse(ItemLink &position, ItemLink &nextBucket);
-    void locateNextBucketEnd(ItemLink &position, ItemLink &currentBucket);
-    void locatePreviousEntry(ItemLink &position, ItemLink currentBucket);
+    void iterateNext(ItemLink &position, size_t &remaining);
+    void iterateNextAndRemove(ItemLink &position, size_t &remaining);
+    void iterateNextReverse(ItemLink &position, size_t &remaining);
     ArrayClass *removeAll(RexxInternalObject *index);
     RexxInternalObject *removeItem(RexxInternalObject *value, RexxInternalObject *index);
     bool hasItem(RexxInternalObject *value, RexxInternalObject *index );
@@ -357,7 +393,7 @@ public:
     RexxInternalObject *nextItem(RexxInternalObject *value, RexxInternalObject *index);
     RexxInternalObject *get(RexxInternalObject *index);
     ArrayClass  *getAll(RexxInternalObject *index);
-    size_t countAllIndex(RexxInternalObject *index, ItemLink &anchorPosition);
+    size_t countAllIndex(RexxInternalObject *index);
     size_t countAllItem(RexxInternalObject *item);
     ArrayClass  *allIndex(RexxInternalObject *item);
     RexxInternalObject *getIndex(RexxInternalObject *item);
@@ -384,11 +420,10 @@ public:
 
 protected:
 
-    size_t   bucketSize;                // size of the hash table
-    size_t   totalSize;                 // total size of the table, including the overflow area
+    size_t   bucketSize;                // number of slots in the table (a power of two)
+    size_t   totalSize;                 // the number of items we can hold before expanding
     size_t   itemCount;                 // total number of items in the table
-    ItemLink freeChain;                 // first free element
-    ContentEntry entries[1];            // hash table entries
+    ContentEntry entries[1];            // hash table entries, followed by the control bytes
 };
 
 
@@ -405,7 +440,7 @@ public:
 
     inline IdentityHashContents() { ; };
     inline IdentityHashContents(RESTORETYPE restoreType) { ; };
-           IdentityHashContents(size_t entries, size_t total) : HashContents(entries, total) { }
+           IdentityHashContents(size_t entries) : HashContents(entries) { }
 };
 
 
@@ -421,7 +456,7 @@ public:
 
     inline EqualityHashContents() { ; };
     inline EqualityHashContents(RESTORETYPE restoreType) { ; };
-           EqualityHashContents(size_t entries, size_t total) : HashContents(entries, total) { }
+           EqualityHashContents(size_t entries) : HashContents(entries) { }
 
     // default index comparison method
     bool isIndexEqual(RexxInternalObject *target, RexxInternalObject *entryIndex) override
@@ -438,9 +473,9 @@ public:
     }
 
     // Use the full hash() method processing to determine this.
-    ItemLink hashIndex(RexxInternalObject *index) override
+    HashCode hashIndex(RexxInternalObject *index) override
     {
-        return (ItemLink)(index->hash() % bucketSize);
+        return scrambleHash(index->hash());
     }
 };
 
@@ -458,7 +493,7 @@ public:
 
     inline MultiValueContents() { ; };
     inline MultiValueContents(RESTORETYPE restoreType) { ; };
-           MultiValueContents(size_t entries, size_t total) : EqualityHashContents(entries, total) { }
+           MultiValueContents(size_t entries) : EqualityHashContents(entries) { }
 
     // remap the put method to the multi-value type
     void put(RexxInternalObject *value, RexxInternalObject *index) override
@@ -480,7 +515,7 @@ public:
 
     inline StringHashContents() { ; };
     inline StringHashContents(RESTORETYPE restoreType) { ; };
-           StringHashContents(size_t entries, size_t total) : EqualityHashContents(entries, total) { }
+           StringHashContents(size_t entries) : EqualityHashContents(entries) { }
 
     // default index comparison method
     bool isIndexEqual(RexxInternalObject *target, RexxInternalObject *entryIndex) override
@@ -491,9 +526,9 @@ public:
 
     // Take advantage of the knowledge that indexes are all strings and
     // do directly to the string hash method, which might be inlined.
-    ItemLink hashIndex(RexxInternalObject *index) override
+    HashCode hashIndex(RexxInternalObject *index) override
     {
-        return (ItemLink)(((RexxString *)index)->getStringHash() % bucketSize);
+        return scrambleHash(((RexxString *)index)->getStringHash());
     }
 };
 
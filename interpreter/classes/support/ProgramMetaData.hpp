@@ -71,7 +71,7 @@ protected:
     enum
     {
         MAGICNUMBER = 11111,           // remains constant from release-to-release
-        METAVERSION = 43               // gets updated when internal form changes
+        METAVERSION = 47               // gets updated when internal form changes
     };
 
 
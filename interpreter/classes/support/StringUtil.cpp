@@ -51,6 +51,390 @@
 #include "NumberStringClass.hpp"
 #include "MutableBufferClass.hpp"
 
+// SSE2 is part of every x86-64 processor, so the vector search kernels
+// need no runtime checks.  Other processors use the memchr() based
+// kernels, which the C libraries implement with vector instructions too.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSE2_SEARCH
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+// needles at least this long are searched with Horspool's algorithm, which can
+// skip up to the needle length at a time
+const size_t LongNeedleLength = 32;
+// the table setup for Horspool only pays off for haystacks at least this long
+const size_t LongHaystackLength = 2048;
+
+
+/**
+ * Return the index of the lowest bit set in a (non-zero) mask.
+ *
+ * @param mask   The bit mask.
+ *
+ * @return The bit index.
+ */
+static inline unsigned int lowestBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+
+/**
+ * Return the index of the highest bit set in a (non-zero) mask.
+ *
+ * @param mask   The bit mask.
+ *
+ * @return The bit index.
+ */
+static inline unsigned int highestBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned int)index;
+#else
+    return 31 - (unsigned int)__builtin_clz(mask);
+#endif
+}
+
+
+#ifdef SSE2_SEARCH
+/**
+ * Fold the uppercase letters of 16 characters to lowercase.
+ *
+ * @param data   The characters.
+ *
+ * @return The folded characters.
+ */
+static inline __m128i foldLower(__m128i data)
+{
+    // 'A' to 'Z' become 0 to 25, everything else is larger as an unsigned value
+    __m128i offset = _mm_sub_epi8(data, _mm_set1_epi8('A'));
+    __m128i isUpper = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(25)), offset);
+    return _mm_or_si128(data, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+
+/**
+ * Search for a long needle using Horspool's algorithm.
+ *
+ * @param haystack  The data to search.
+ * @param haystackLen
+ *                  The length of the data.
+ * @param needle    The needle to search for.
+ * @param needleLen The length of the needle, at least 2 and not longer than the haystack.
+ *
+ * @return A pointer to the first match or NULL if there is no match.
+ */
+static const char *horspoolSearch(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+    // the distance we can move forward for each possible last character
+    size_t skip[256];
+    for (size_t i = 0; i < 256; i++)
+    {
+        skip[i] = needleLen;
+    }
+    for (size_t i = 0; i < needleLen - 1; i++)
+    {
+        skip[(unsigned char)needle[i]] = needleLen - 1 - i;
+    }
+
+    char lastChar = needle[needleLen - 1];
+    const char *last = haystack + haystackLen - needleLen;
+    while (haystack <= last)
+    {
+        char ch = haystack[needleLen - 1];
+        if (ch == lastChar && memcmp(haystack, needle, needleLen - 1) == 0)
+        {
+            return haystack;
+        }
+        haystack += skip[(unsigned char)ch];
+    }
+    return NULL;
+}
+
+
+/**
+ * Find the first occurrence of a needle.  Candidate positions are
+ * located with memchr() on the first character of the needle.  If
+ * that character turns out to be a common one, the search switches
+ * to matching both the first and the last character of the needle,
+ * 16 positions at a time where SSE2 is available.
+ *
+ * @param haystack  The data to search.
+ * @param haystackLen
+ *                  The length of the data.
+ * @param needle    The needle to search for.
+ * @param needleLen The length of the needle.
+ *
+ * @return A pointer to the first match or NULL if there is no match.
+ */
+static const char *searchForward(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+    if (needleLen == 0 || needleLen > haystackLen)
+    {
+        return NULL;
+    }
+    if (needleLen == 1)
+    {
+        return (const char *)memchr(haystack, needle[0], haystackLen);
+    }
+    if (needleLen >= LongNeedleLength && haystackLen >= LongHaystackLength)
+    {
+        return horspoolSearch(haystack, haystackLen, needle, needleLen);
+    }
+
+    // the number of positions where a match can start
+    size_t positions = haystackLen - needleLen + 1;
+    char first = needle[0];
+    char last = needle[needleLen - 1];
+    size_t i = 0;
+    size_t falseHits = 0;
+
+    while (i < positions)
+    {
+#ifdef SSE2_SEARCH
+        // more than one candidate per 32 characters, the first character alone is
+        // not selective enough
+        if (falseHits > 8 && falseHits * 32 > i)
+        {
+            break;
+        }
+#endif
+        const char *candidate = (const char *)memchr(haystack + i, first, positions - i);
+        if (candidate == NULL)
+        {
+            return NULL;
+        }
+        if (candidate[needleLen - 1] == last && memcmp(candidate + 1, needle + 1, needleLen - 2) == 0)
+        {
+            return candidate;
+        }
+        falseHits++;
+        i = candidate - haystack + 1;
+    }
+
+#ifdef SSE2_SEARCH
+    __m128i firstChar = _mm_set1_epi8(first);
+    __m128i lastChar = _mm_set1_epi8(last);
+
+    for (; i + 16 <= positions; i += 16)
+    {
+        __m128i firstBlock = _mm_loadu_si128((const __m128i *)(haystack + i));
+        __m128i lastBlock = _mm_loadu_si128((const __m128i *)(haystack + i + needleLen - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstChar, firstBlock), _mm_cmpeq_epi8(lastChar, lastBlock)));
+        while (mask != 0)
+        {
+            const char *candidate = haystack + i + lowestBit(mask);
+            if (memcmp(candidate + 1, needle + 1, needleLen - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    // the remaining positions
+    for (; i < positions; i++)
+    {
+        if (haystack[i] == first && haystack[i + needleLen - 1] == last &&
+            memcmp(haystack + i + 1, needle + 1, needleLen - 2) == 0)
+        {
+            return haystack + i;
+        }
+    }
+#endif
+    return NULL;
+}
+
+
+/**
+ * Find the first caseless occurrence of a needle.  The haystack
+ * characters are folded to lowercase in the vector registers.
+ *
+ * @param haystack  The data to search.
+ * @param haystackLen
+ *                  The length of the data.
+ * @param needle    The needle to search for.
+ * @param needleLen The length of the needle.
+ *
+ * @return A pointer to the first match or NULL if there is no match.
+ */
+static const char *caselessSearchForward(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+    if (needleLen == 0 || needleLen > haystackLen)
+    {
+        return NULL;
+    }
+
+    size_t positions = haystackLen - needleLen + 1;
+    size_t i = 0;
+    char first = Utilities::toLower(needle[0]);
+    char last = Utilities::toLower(needle[needleLen - 1]);
+
+#ifdef SSE2_SEARCH
+    __m128i firstChar = _mm_set1_epi8(first);
+    __m128i lastChar = _mm_set1_epi8(last);
+
+    for (; i + 16 <= positions; i += 16)
+    {
+        __m128i firstBlock = foldLower(_mm_loadu_si128((const __m128i *)(haystack + i)));
+        __m128i lastBlock = foldLower(_mm_loadu_si128((const __m128i *)(haystack + i + needleLen - 1)));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstChar, firstBlock), _mm_cmpeq_epi8(lastChar, lastBlock)));
+        while (mask != 0)
+        {
+            const char *candidate = haystack + i + lowestBit(mask);
+            if (StringUtil::caselessCompare(candidate, needle, needleLen) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // the remaining positions
+    for (; i < positions; i++)
+    {
+        if (Utilities::toLower(haystack[i]) == first && Utilities::toLower(haystack[i + needleLen - 1]) == last &&
+            StringUtil::caselessCompare(haystack + i, needle, needleLen) == 0)
+        {
+            return haystack + i;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * Find the last occurrence of a needle, using the same candidate
+ * filtering as searchForward().
+ *
+ * @param haystack  The data to search.
+ * @param haystackLen
+ *                  The length of the data.
+ * @param needle    The needle to search for.
+ * @param needleLen The length of the needle (not zero).
+ *
+ * @return A pointer to the last match or NULL if there is no match.
+ */
+static const char *searchBackward(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+    if (needleLen > haystackLen)
+    {
+        return NULL;
+    }
+
+    // positions below this one remain to be checked
+    size_t positions = haystackLen - needleLen + 1;
+    char first = needle[0];
+    char last = needle[needleLen - 1];
+
+#ifdef SSE2_SEARCH
+    __m128i firstChar = _mm_set1_epi8(first);
+    __m128i lastChar = _mm_set1_epi8(last);
+
+    for (; positions >= 16; positions -= 16)
+    {
+        const char *block = haystack + positions - 16;
+        __m128i firstBlock = _mm_loadu_si128((const __m128i *)block);
+        __m128i lastBlock = _mm_loadu_si128((const __m128i *)(block + needleLen - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstChar, firstBlock), _mm_cmpeq_epi8(lastChar, lastBlock)));
+        while (mask != 0)
+        {
+            unsigned int bit = highestBit(mask);
+            if (memcmp(block + bit, needle, needleLen) == 0)
+            {
+                return block + bit;
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+#endif
+
+    // the remaining positions
+    while (positions > 0)
+    {
+        positions--;
+        if (haystack[positions] == first && haystack[positions + needleLen - 1] == last &&
+            memcmp(haystack + positions, needle, needleLen) == 0)
+        {
+            return haystack + positions;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * Find the last caseless occurrence of a needle.
+ *
+ * @param haystack  The data to search.
+ * @param haystackLen
+ *                  The length of the data.
+ * @param needle    The needle to search for.
+ * @param needleLen The length of the needle (not zero).
+ *
+ * @return A pointer to the last match or NULL if there is no match.
+ */
+static const char *caselessSearchBackward(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+    if (needleLen > haystackLen)
+    {
+        return NULL;
+    }
+
+    size_t positions = haystackLen - needleLen + 1;
+    char first = Utilities::toLower(needle[0]);
+    char last = Utilities::toLower(needle[needleLen - 1]);
+
+#ifdef SSE2_SEARCH
+    __m128i firstChar = _mm_set1_epi8(first);
+    __m128i lastChar = _mm_set1_epi8(last);
+
+    for (; positions >= 16; positions -= 16)
+    {
+        const char *block = haystack + positions - 16;
+        __m128i firstBlock = foldLower(_mm_loadu_si128((const __m128i *)block));
+        __m128i lastBlock = foldLower(_mm_loadu_si128((const __m128i *)(block + needleLen - 1)));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstChar, firstBlock), _mm_cmpeq_epi8(lastChar, lastBlock)));
+        while (mask != 0)
+        {
+            unsigned int bit = highestBit(mask);
+            if (StringUtil::caselessCompare(block + bit, needle, needleLen) == 0)
+            {
+                return block + bit;
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+#endif
+
+    while (positions > 0)
+    {
+        positions--;
+        if (Utilities::toLower(haystack[positions]) == first && Utilities::toLower(haystack[positions + needleLen - 1]) == last &&
+            StringUtil::caselessCompare(haystack + positions, needle, needleLen) == 0)
+        {
+            return haystack + positions;
+        }
+    }
+    return NULL;
+}
+
+
 /**
  * Extract a substring from a data buffer.
  *
@@ -219,37 +603,8 @@ size_t StringUtil::pos(const char *stringData, size_t haystack_length, RexxStrin
         return 0;
     }
 
-    // address the string value
-    const char *haypointer = stringData + _start;
-    const char *needlepointer = needle->getStringData();
-
-    // this is the last possible position (plus one) for a first character of needle
-    const char *endpointer = haypointer + _range - needle_length + 1;
-
-    // try to find the first char of needle with memchr()
-    haypointer = (char *)memchr(haypointer, *needlepointer, endpointer - haypointer);
-
-    // if needle is just a single char, we're finshed
-    if (needle_length == 1)
-    {
-      return haypointer ? haypointer - stringData + 1 : 0;
-    }
-
-    // our needle is two chars or longer, so we repeatedly
-    // - search for the first char of needle with memchr() and then
-    // - test for the complete needle with memcmp()
-    while (haypointer)
-    {
-        // memchr() gave us a match for the first character of needle
-        // before calling memcmp() we also check for a match of the second character
-        if ( *(haypointer + 1) == *(needlepointer + 1) &&
-            memcmp(haypointer + 2, needlepointer + 2, needle_length - 2) == 0)
-        {
-            return haypointer - stringData + 1;
-        }
-        haypointer = (char *)memchr(haypointer + 1, *needlepointer, endpointer - haypointer);
-    }
-    return 0;  // we got nothing...
+    const char *match = searchForward(stringData + _start, _range, needle->getStringData(), needle_length);
+    return match == NULL ? 0 : match - stringData + 1;
 }
 
 
@@ -281,26 +636,8 @@ size_t StringUtil::caselessPos(const char *stringData, size_t haystack_length, R
         return 0;
     }
 
-    // address the string value
-    const char *haypointer = stringData + _start;
-    const char *needlepointer = needle->getStringData();
-    size_t location = _start + 1;         // this is the match location as an index
-    // calculate the number of probes we can make in this string
-    size_t count = _range - needle_length + 1;
-
-    // now scan
-    while (count--)
-    {
-        // this is a caseless compare
-        if (caselessCompare(haypointer, needlepointer, needle_length) == 0)
-        {
-            return location;
-        }
-        // step our pointers accordingly
-        location++;
-        haypointer++;
-    }
-    return 0;  // we got nothing...
+    const char *match = caselessSearchForward(stringData + _start, _range, needle->getStringData(), needle_length);
+    return match == NULL ? 0 : match - stringData + 1;
 }
 
 
@@ -378,28 +715,12 @@ size_t StringUtil::lastPos(const char *stringData, size_t haystackLen, RexxStrin
  */
 const char *StringUtil::lastPos(const char *needle, size_t needleLen, const char *haystack, size_t haystackLen)
 {
-    // if the needle's longer than the haystack, no chance of a match
-    if (needleLen > haystackLen)
-    {
-        return NULL;
-    }
-    // set the search startpoing point relative to the end of the search string
-    haystack = haystack + haystackLen - needleLen;
-    // this is the possible number of compares we might need to perform
-    size_t count = haystackLen - needleLen + 1;
-    // now scan backward
-    while (count > 0)
+    // a null string matches at the very end
+    if (needleLen == 0)
     {
-        // got a match at this position, return it directly
-        if (memcmp(haystack, needle, needleLen) == 0)
-        {
-            return haystack;
-        }
-        // decrement count and position
-        count--;
-        haystack--;
+        return haystack + haystackLen;
     }
-    return NULL;   // nothing to see here folks, move along
+    return searchBackward(haystack, haystackLen, needle, needleLen);
 }
 
 
@@ -454,28 +775,12 @@ size_t StringUtil::caselessLastPos(const char *stringData, size_t haystackLen, R
  */
 const char *StringUtil::caselessLastPos(const char *needle, size_t needleLen, const char *haystack, size_t haystackLen)
 {
-    // if the needle's longer than the haystack, no chance of a match
-    if (needleLen > haystackLen)
+    // a null string matches at the very end
+    if (needleLen == 0)
     {
-        return NULL;
+        return haystack + haystackLen;
     }
-    // set the search startpoing point relative to the end of the search string
-    haystack = haystack + haystackLen - needleLen;
-    // this is the possible number of compares we might need to perform
-    size_t count = haystackLen - needleLen + 1;
-    // now scan backward
-    while (count > 0)
-    {
-        // got a match at this position, return it directly
-        if (caselessCompare(haystack, needle, needleLen) == 0)
-        {
-            return haystack;
-        }
-        // decrement count and position
-        count--;
-        haystack--;
-    }
-    return NULL;   // nothing to see here folks, move along
+    return caselessSearchBackward(haystack, haystackLen, needle, needleLen);
 }
 
 
@@ -518,17 +823,13 @@ RexxString *StringUtil::subchar(const char *stringData, size_t stringLength, Rex
  */
 const char *StringUtil::locateSeparator(const char *start, const char *end, const char *sepData, size_t sepLength)
 {
-    // search for separator character
-    while (start < end)
+    // nothing to search
+    if (start >= end)
     {
-        if (memcmp(start, sepData, sepLength) == 0)
-        {
-            return start;
-        }
-        start++;
+        return NULL;
     }
-    // not found
-    return NULL;
+    // the separator may start at any position before end
+    return searchForward(start, end - start + sepLength - 1, sepData, sepLength);
 }
 
 
@@ -1188,19 +1489,16 @@ size_t StringUtil::countStr(const char *hayStack, size_t hayStackLength, RexxStr
         return 0;
     }
 
-    // the new start position; zero to start with
-    size_t newPos = 0;
+    const char *needleData = needle->getStringData();
+    const char *end = hayStack + hayStackLength;
 
-    // the offset to be added to the current match to get the new start position
-    size_t step = needleLength - 1;
-
-    size_t count, matchPos;
-    for (count = 0; count < maxCount &&
-        (matchPos = pos(hayStack, hayStackLength, needle, newPos, hayStackLength)) != 0;
-         count++)
+    size_t count = 0;
+    const char *match;
+    while (count < maxCount && (match = searchForward(hayStack, end - hayStack, needleData, needleLength)) != NULL)
     {
-        // step to the new position
-        newPos = matchPos + step;
+        count++;
+        // matches don't overlap, continue after this one
+        hayStack = match + needleLength;
     }
     return count;
 }
@@ -1228,19 +1526,16 @@ size_t StringUtil::caselessCountStr(const char *hayStack, size_t hayStackLength,
         return 0;
     }
 
-    // the new start position; zero to start with
-    size_t newPos = 0;
-
-    // the offset to be added to the current match to get the new start position
-    size_t step = needleLength - 1;
+    const char *needleData = needle->getStringData();
+    const char *end = hayStack + hayStackLength;
 
-    size_t count, matchPos;
-    for (count = 0; count < maxCount &&
-        (matchPos = caselessPos(hayStack, hayStackLength, needle, newPos, hayStackLength)) != 0;
-         count++)
+    size_t count = 0;
+    const char *match;
+    while (count < maxCount && (match = caselessSearchForward(hayStack, end - hayStack, needleData, needleLength)) != NULL)
     {
-        // step to the new position
-        newPos = matchPos + step;
+        count++;
+        // matches don't overlap, continue after this one
+        hayStack = match + needleLength;
     }
     return count;
 }
@@ -1257,15 +1552,124 @@ size_t StringUtil::caselessCountStr(const char *hayStack, size_t hayStackLength,
  */
 size_t StringUtil::memPos(const char *string, size_t length, char target)
 {
-    for (const char *scan = string; length; scan++, length--)
+    const char *match = (const char *)memchr(string, target, length);
+    return match == NULL ? SIZE_MAX : match - string;
+}
+
+
+/**
+ * Load an unaligned 64-bit word from a character buffer.  The
+ * bytes are always taken in little-endian order so that a string
+ * hashes to the same value on every platform.  Written this way,
+ * the compilers reduce it to a single load on little-endian
+ * machines.
+ *
+ * @param data   The data pointer.
+ *
+ * @return The word value.
+ */
+static inline uint64_t loadWord(const char *data)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    return (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8) | ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
+           ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) | ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+}
+
+
+/**
+ * Load the last few bytes of a buffer as a zero-padded 64-bit
+ * word, in the same byte order as loadWord().
+ *
+ * @param data   The data pointer.
+ * @param count  The number of bytes left (less than eight).
+ *
+ * @return The word value.
+ */
+static inline uint64_t loadTail(const char *data, size_t count)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; i++)
     {
-        // if we have a match, return the offset
-        if (*scan == target)
-        {
-            return scan - string;
-        }
+        word |= (uint64_t)bytes[i] << (i * 8);
+    }
+    return word;
+}
+
+
+/**
+ * Fold a data word into a running hash state.
+ *
+ * @param state  The current hash state.
+ * @param word   The next data word.
+ *
+ * @return The updated state.
+ */
+static inline uint64_t hashWord(uint64_t state, uint64_t word)
+{
+    state ^= word;
+    state *= 0xbf58476d1ce4e5b9ULL;
+    return state ^ (state >> 31);
+}
+
+
+/**
+ * Calculate the hash code for a block of character data.  The
+ * data is consumed a 64-bit word at a time in two independent
+ * lanes so the multiplies can overlap, and the result is run
+ * through a final avalanche step so that all of the bits are
+ * usable by the hash collections.
+ *
+ * @param data   The data pointer.
+ * @param length The length of the data.
+ *
+ * @return A hash code for the data.  This is never zero, since
+ *         zero is used to indicate that a string has not been hashed yet.
+ */
+size_t StringUtil::hash(const char *data, size_t length)
+{
+    uint64_t lane1 = 0x9e3779b97f4a7c15ULL ^ (uint64_t)length;
+    uint64_t lane2 = 0x6a09e667f3bcc909ULL;
+
+    size_t remaining = length;
+    while (remaining >= 2 * sizeof(uint64_t))
+    {
+        lane1 = hashWord(lane1, loadWord(data));
+        lane2 = hashWord(lane2, loadWord(data + sizeof(uint64_t)));
+        data += 2 * sizeof(uint64_t);
+        remaining -= 2 * sizeof(uint64_t);
+    }
+
+    if (remaining >= sizeof(uint64_t))
+    {
+        lane1 = hashWord(lane1, loadWord(data));
+        data += sizeof(uint64_t);
+        remaining -= sizeof(uint64_t);
+    }
+
+    // the tail is padded with zeros.  The length is part of the seed, so
+    // trailing nulls still produce a different value.
+    if (remaining > 0)
+    {
+        lane2 = hashWord(lane2, loadTail(data, remaining));
     }
-    return SIZE_MAX;             // no match position
+
+    // the full MurmurHash3 finalizer.  Short keys that differ only in
+    // their last character reach this point differing in a few bits of
+    // lane2, and both rounds are needed to spread that to every bit.
+    uint64_t h = lane1 ^ ((lane2 << 29) | (lane2 >> 35));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+#ifndef __REXX64__
+    h ^= h >> 32;
+#endif
+
+    size_t result = (size_t)h;
+    return result == 0 ? 1 : result;
 }
 
 
@@ -81,6 +81,7 @@ public:
     static size_t countStr(const char *hayStack, size_t hayStackLength, RexxString *needle, size_t maxCount);
     static size_t caselessCountStr(const char *hayStack, size_t hayStackLength, RexxString *needle, size_t maxCount);
     static size_t memPos(const char *string, size_t length, char target);
+    static size_t hash(const char *data, size_t length);
     static RexxInteger *verify(const char *data, size_t stringLen, RexxString  *ref, RexxString  *option, RexxInteger *_start, RexxInteger *range);
     static RexxString *subWord(const char *data, size_t length, RexxInteger *position, RexxInteger *plength);
     static ArrayClass *subWords(const char *data, size_t length, RexxInteger *position, RexxInteger *plength);
@@ -133,6 +133,7 @@ void Activity::live(size_t liveMark)
     memory_mark(dispatchMessage);
     memory_mark(heldMutexes);
     memory_mark(spawnerStackFrameInfo);
+    memory_mark(executorWorker);
 
     // have the frame stack do its own marking.
     frameStack.live(liveMark);
@@ -167,6 +168,7 @@ void Activity::liveGeneral(MarkReason reason)
     memory_mark_general(dispatchMessage);
     memory_mark_general(heldMutexes);
     memory_mark_general(spawnerStackFrameInfo);
+    memory_mark_general(executorWorker);
 
     /* have the frame stack do its own marking. */
     frameStack.liveGeneral(reason);
@@ -250,12 +252,15 @@ void Activity::runThread()
 
         // cast off any items related to our initial dispatch.
         dispatchMessage = OREF_NULL;
+        setExecutorWorker(OREF_NULL, 0);
 
         // no longer an active activity
         deactivate();
 
         // make sure we clean up any mutexes we hold
         cleanupMutexes();
+        // and any system resources tied to the work we just did
+        currentThread.cleanupResources();
 
         // reset our semaphores
         runSem.reset();
@@ -197,6 +197,7 @@ class Activity : public RexxInternalObject
     void        terminatePoolActivity();
     thread_id_t threadIdMethod();
     bool isThread(thread_id_t id) { return currentThread.equals(id); }
+    inline SysActivity &getSysActivity() { return currentThread; }
     inline bool isClauseExitUsed() { return clauseExitUsed; }
     void queryTrcHlt();
     bool callExit(RexxActivation * activation, const char *exitName, int function, int subfunction, void *exitbuffer);
@@ -354,6 +355,8 @@ class Activity : public RexxInternalObject
     void addMutex(MutexSemaphoreClass *m);
     void removeMutex(MutexSemaphoreClass *m);
     void cleanupMutexes();
+    inline void setExecutorWorker(RexxObject *e, size_t s) { executorWorker = e; executorSlot = s; }
+    inline size_t getExecutorSlot(RexxObject *e) { return executorWorker == e ? executorSlot : 0; }
 
     static void initializeThreadContext();
 
@@ -428,6 +431,8 @@ class Activity : public RexxInternalObject
     ActivationFrame *activationFrames;  // list of stack-based object protectors
     Activity *nestedActivity;           // used to push down activities in threads with more than one instance
     IdentityTable *heldMutexes;         // a list of Mutex objects owned by this activity.
+    RexxObject *executorWorker;         // the Executor this activity is running a task for
+    size_t      executorSlot;           // the deque number of that Executor worker
 
     // structures containing the various interface vectors
     static RexxThreadInterface threadContextFunctions;
@@ -113,6 +113,9 @@ bool ActivityManager::processTerminating = false;
 // number of active interpreter instances in this process
 size_t ActivityManager::interpreterInstances = 0;
 
+// number of idle activities we keep around for reuse
+size_t ActivityManager::threadPoolSize = MAX_THREAD_POOL_SIZE;
+
 
 /**
  * Initialize the activity manager when the interpreter starts up.
@@ -143,15 +146,20 @@ void ActivityManager::live(size_t liveMark)
     memory_mark(availableActivities);
     // the list is not a Rexx object, but its contents are, and this is what keeps
     // the activities alive. We already hold kernel access here, so taking the
-    // resource lock the maintaining paths hold is the permitted order.
+    // resource lock the maintaining paths hold is the permitted order.  On a
+    // parallel mark, the collecting thread already holds it for all markers.
     {
-        ResourceSection lock;
+        bool locked = !memoryObject.isParallelMarking() && Interpreter::getResourceLock();
         std::vector<Activity *> &acts = allActivities().contents();
         for (size_t i = 0; i < acts.size(); i++)
         {
             RexxInternalObject *entry = acts[i];
             memory_mark(entry);
         }
+        if (locked)
+        {
+            Interpreter::releaseResourceLock();
+        }
     }
 }
 
@@ -216,8 +224,12 @@ void ActivityManager::addWaitingActivity(Activity *waitingAct, bool release )
     // so other waiters can get this while we're setting up
     if (release)
     {
-        // release the kernel semaphore and poke the next activity
-        releaseAccess();
+        // release the kernel semaphore and poke the next activity. We are about
+        // to wait for our own dispatch at the back of the line, so nobody else
+        // would post the activity at the head of the queue: it would sit out the
+        // full dispatch timeout, and each time slice hand-off between busy
+        // threads would cost that timeout.
+        releaseAccess(true);
         // we are going to queue up unconditionally and wait in line
         inWaitQueue = true;
 
@@ -647,7 +659,7 @@ bool ActivityManager::poolActivity(Activity *activity)
     // ResourceSection lock held by caller: bool InterpreterInstance::poolActivity(Activity *activity
 
     // are we shutting down or have too many threads in the pool?
-    if (processTerminating || availableActivities->items() > MAX_THREAD_POOL_SIZE)
+    if (processTerminating || availableActivities->items() > threadPoolSize)
     {
         // have the activity clean up its resources.
         activity->cleanupActivityResources();
@@ -240,6 +240,8 @@ public:
     static bool dispatchNext(DispatchSection &lock);
     static inline bool hasWaiters() { return waitingAccess != 0 || waitingAttaches != 0; }
     static inline bool hasApiWaiters() { return waitingApiAccess != 0; }
+    static inline void setThreadPoolSize(size_t s) { threadPoolSize = s; }
+    static inline size_t getThreadPoolSize() { return threadPoolSize; }
 
     static Activity *findActivity();
     static Activity *findActivity(thread_id_t);
@@ -354,8 +356,9 @@ public:
 
 protected:
 
-    // maximum number of activities we'll pool
+    // default maximum number of activities we'll pool (RXTHREADPOOL overrides)
     static const size_t MAX_THREAD_POOL_SIZE = 5;
+    static size_t threadPoolSize;                          // the pool limit in effect, activities are released once the pool holds more
     static const uint64_t timeSliceLength = 24;            // how long we'll run before checking for a control yield.
 
     static QueueClass       *availableActivities;     // table of available activities
@@ -1308,6 +1308,8 @@ PCPPM CPPCode::exportedMethods[] =
     CPPM(RexxInfo::getRexxExecutable),
     CPPM(RexxInfo::getRexxLibrary),
     CPPM(RexxInfo::getDebug),
+    CPPM(RexxInfo::getInterpretCacheHits),
+    CPPM(RexxInfo::getInterpretCacheMisses),
 
     CPPM(VariableReference::newRexx),
     CPPM(VariableReference::getName),
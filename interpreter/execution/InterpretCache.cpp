@@ -0,0 +1,158 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                           InterpretCache.cpp   */
+/*                                                                            */
+/* Cache of translated INTERPRET strings                                      */
+/*                                                                            */
+/******************************************************************************/
+#include "RexxCore.h"
+#include "InterpretCache.hpp"
+#include "RexxCode.hpp"
+#include "LanguageParser.hpp"
+
+
+/**
+ * Normal live marking.
+ */
+void InterpretCache::live(size_t liveMark)
+{
+    if (entries == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < CACHE_SIZE; i++)
+    {
+        memory_mark(entries[i].source);
+        memory_mark(entries[i].context);
+        memory_mark(entries[i].code);
+    }
+}
+
+
+/**
+ * Generalized live marking.
+ */
+void InterpretCache::liveGeneral(MarkReason reason)
+{
+    // the cache is never part of a saved image
+    if (reason != SAVINGIMAGE && entries != NULL)
+    {
+        for (size_t i = 0; i < CACHE_SIZE; i++)
+        {
+            memory_mark_general(entries[i].source);
+            memory_mark_general(entries[i].context);
+            memory_mark_general(entries[i].code);
+        }
+    }
+}
+
+
+/**
+ * Return the translated code for an INTERPRET string, either
+ * from the cache or by translating it.
+ *
+ * @param context    The code the string is interpreted in.
+ * @param source     The source string.
+ * @param lineNumber The line number of the context.
+ *
+ * @return A translated code object.
+ */
+RexxCode *InterpretCache::translate(RexxCode *context, RexxString *source, size_t lineNumber)
+{
+    // all three parts of the key contribute to the set selection.  Objects
+    // never move, so the context address is stable while we reference it.
+    if (entries == NULL)
+    {
+        entries = new CacheEntry[CACHE_SIZE]();
+    }
+
+    size_t hash = (size_t)source->getStringHash() + lineNumber * 31 + ((uintptr_t)context >> 4);
+    CacheEntry *set = entries + (hash & (CACHE_SETS - 1)) * CACHE_WAYS;
+
+    useCounter++;
+
+    CacheEntry *victim = set;
+    for (size_t i = 0; i < CACHE_WAYS; i++)
+    {
+        CacheEntry *entry = set + i;
+        if (entry->code == OREF_NULL)
+        {
+            // an empty slot is always the best candidate for replacement
+            if (victim->code != OREF_NULL)
+            {
+                victim = entry;
+            }
+            continue;
+        }
+
+        if (entry->context == context && entry->lineNumber == lineNumber && entry->source->memCompare(source))
+        {
+            hits++;
+            entry->lastUsed = useCounter;
+            return entry->code;
+        }
+
+        if (victim->code != OREF_NULL && entry->lastUsed < victim->lastUsed)
+        {
+            victim = entry;
+        }
+    }
+
+    misses++;
+    // this raises an error if there is a syntax problem, in which case
+    // nothing gets added to the cache.
+    RexxCode *code = LanguageParser::translateInterpret(source, context->getPackage(), context->getLabels(), lineNumber);
+
+    victim->source = source;
+    victim->context = context;
+    victim->lineNumber = lineNumber;
+    victim->code = code;
+    victim->lastUsed = useCounter;
+    return code;
+}
+
+
+/**
+ * Drop all cached code, used at instance termination.  The
+ * statistics are kept.
+ */
+void InterpretCache::clear()
+{
+    delete [] entries;
+    entries = NULL;
+}
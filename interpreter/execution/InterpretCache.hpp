@@ -0,0 +1,108 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                           InterpretCache.hpp   */
+/*                                                                            */
+/* Cache of translated INTERPRET strings                                      */
+/*                                                                            */
+/******************************************************************************/
+#ifndef Included_InterpretCache
+#define Included_InterpretCache
+
+#include "RexxCore.h"
+
+class RexxCode;
+
+/**
+ * A bounded cache of the code translated for INTERPRET
+ * strings.  Programs that build instructions as strings and
+ * interpret them over and over would otherwise pay for a full
+ * translation on every execution.
+ *
+ * The translation of an INTERPRET string depends on the source
+ * text, the code it is interpreted in (this gives the package
+ * and the labels visible to SIGNAL and CALL), and the line
+ * number of the INTERPRET instruction (used for error
+ * reporting).  All three form the cache key.
+ *
+ * The cache is organized as a set-associative table.  A key
+ * maps to a single set, and when that set is full, the least
+ * recently used entry gets replaced.
+ *
+ * Each interpreter instance has its own cache.  The entries
+ * keep the code they were interpreted in, and with it the
+ * package, alive, so the cache is emptied when the instance
+ * terminates.
+ */
+class InterpretCache
+{
+public:
+    // zero-filled storage is an empty cache
+    void live(size_t liveMark);
+    void liveGeneral(MarkReason reason);
+
+    RexxCode *translate(RexxCode *context, RexxString *source, size_t lineNumber);
+    void clear();
+
+    inline size_t getHits() { return hits; }
+    inline size_t getMisses() { return misses; }
+
+protected:
+
+    static const size_t CACHE_SETS = 64;     // number of sets, must be a power of two
+    static const size_t CACHE_WAYS = 4;      // entries per set
+    static const size_t CACHE_SIZE = CACHE_SETS * CACHE_WAYS;
+
+    /**
+     * A single cache entry.
+     */
+    typedef struct
+    {
+        RexxString *source;          // the interpreted string
+        RexxCode   *context;         // the code the string was interpreted in
+        size_t      lineNumber;      // the line number of the INTERPRET
+        RexxCode   *code;            // the translated code
+        size_t      lastUsed;        // the use counter value when last used
+    } CacheEntry;
+
+    CacheEntry *entries;             // allocated on first use
+    size_t      useCounter;          // increases with every lookup, used for LRU
+    size_t      hits;                // number of lookups satisfied from the cache
+    size_t      misses;              // number of lookups needing a translation
+};
+
+#endif
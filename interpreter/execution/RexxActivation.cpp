@@ -3129,32 +3129,20 @@ bool RexxActivation::callExternalRexx(RexxString *target, RexxObject **arguments
         return parent->callExternalRexx(target, arguments, argcount, calltype, resultObj);
     }
 
-    // Get full name including path
-    Protected<RexxString> filename = resolveProgramName(target, RESOLVE_DEFAULT);
-    if (!filename.isNull())
-    {
-        // try for a saved program or translate a anew
-
-        Protected<RoutineClass> routine = LanguageParser::createProgramFromFile(filename);
-        // do we have something?  return not found
-        if (routine.isNull())
-        {
-            return false;
-        }
-        else
-        {
-            // run as a call
-            routine->call(activity, target, arguments, argcount, calltype, settings.currentAddress, EXTERNALCALL, resultObj);
-            // merge all of the public info
-            settings.parentCode->mergeRequired(routine->getPackageObject());
-            return true;
-        }
-    }
+    // locate and translate the program.  The instance remembers both the
+    // search result and the translation for later calls.
+    Protected<RoutineClass> routine = activity->getInstance()->resolveExternalProgram(activity, code->getPackageObject(), target);
     // the external routine wasn't found
-    else
+    if (routine.isNull())
     {
         return false;
     }
+
+    // run as a call
+    routine->call(activity, target, arguments, argcount, calltype, settings.currentAddress, EXTERNALCALL, resultObj);
+    // merge all of the public info
+    settings.parentCode->mergeRequired(routine->getPackageObject());
+    return true;
 }
 
 
@@ -5211,6 +5199,7 @@ StringTable * RexxActivation::createTraceObject(Activity *activity, RexxActivati
         traceObject -> put(new_integer(activation -> getVariableDictionary()->getIdntfr()), GlobalNames::ATTRIBUTEPOOL);
         traceObject -> put(activation -> isGuarded() ? TheTrueObject : TheFalseObject, GlobalNames::ISGUARDED );
         traceObject -> put(new_integer(activation -> getReserveCount()), GlobalNames::SCOPELOCKCOUNT);
+        traceObject -> put(new_integer(activation -> getScopeContentions()), GlobalNames::SCOPELOCKCONTENTIONS);
         traceObject -> put(activation -> isObjectScopeLocked() ? TheTrueObject : TheFalseObject, GlobalNames::HASSCOPELOCK);
             // although receiver can be fetched via StackFrame's target, allow speeding up for debugger, hence add it always here as well
         traceObject -> put(activation -> getReceiver(), GlobalNames::RECEIVER);
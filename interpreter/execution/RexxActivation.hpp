@@ -416,6 +416,7 @@ class RexxActivation : public ActivationBase
    inline bool              isObjectScopeLocked() { return this->objectScope == SCOPE_RESERVED; } // for concurrency trace
    unsigned short           getReserveCount() { VariableDictionary *ovd = this->getVariableDictionary(); return ovd ? ovd->getReserveCount() : 0; } // for concurrency trace. Try to get the ovd counter, even if not yet assigned to current activation.
    VariableDictionary *     getVariableDictionary() { return this->receiver ? this->receiver->getObjectVariables(this->scope) : NULL; } // for concurrency trace. Try to get the ovd, even if not yet assigned to current activation.
+   size_t                   getScopeContentions() { return this->scope != OREF_NULL && (RexxObject *)this->scope != TheNilObject ? this->scope->getGuardContentions() : 0; } // for concurrency trace
 
           void              enableExternalTrace();
           void              disableExternalTrace();
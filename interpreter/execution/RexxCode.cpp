@@ -49,6 +49,8 @@
 #include "ActivityManager.hpp"
 #include "RexxActivation.hpp"
 #include "LanguageParser.hpp"
+#include "Activity.hpp"
+#include "InterpreterInstance.hpp"
 
 
 /**
@@ -260,7 +262,8 @@ RexxObject *RexxCode::setSecurityManager(RexxObject *manager)
  */
 RexxCode *RexxCode::interpret(RexxString *source, size_t lineNumber)
 {
-    return LanguageParser::translateInterpret(source, package, labels, lineNumber);
+    // strings interpreted repeatedly are only translated once
+    return ActivityManager::currentActivity.load()->getInstance()->getInterpretCache().translate(this, source, lineNumber);
 }
 
 
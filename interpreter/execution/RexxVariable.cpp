@@ -106,11 +106,29 @@ void RexxVariable::flatten(Envelope *envelope)
      flattenRef(variableName);
      flattenRef(creator);
      flattenRef(dependents);
+     // a restored value can be referenced from anywhere
+     newThis->ownership = VALUE_SHARED;
 
     cleanUpFlatten
 }
 
 
+/**
+ * Copy a variable object.  The copy references the same value
+ * object as the original, so neither variable can extend that
+ * value in place any longer.
+ *
+ * @return A copy of the variable.
+ */
+RexxInternalObject *RexxVariable::copy()
+{
+    ownership = VALUE_SHARED;
+    RexxVariable *newObj = (RexxVariable *)RexxInternalObject::copy();
+    newObj->ownership = VALUE_SHARED;
+    return newObj;
+}
+
+
 /**
  * Request that an activity be informed of any variable
  * modifications.
@@ -169,6 +187,26 @@ void RexxVariable::drop()
 }
 
 
+/**
+ * Assign a value that only this variable references.  The
+ * string appends use this after building or extending a value.
+ *
+ * @param value  The new value.
+ */
+void RexxVariable::setOwned(RexxObject *value)
+{
+    // this may be the same string object extended in place, but any
+    // waiters still need to see the change.  The ownership must be
+    // set before notifying, since that can yield to other threads.
+    setField(variableValue, value);
+    ownership = VALUE_OWNED;
+    if (dependents != OREF_NULL)
+    {
+        notify();
+    }
+}
+
+
 /**
  * notify all waiting activities that a variable has been updated.
  */
@@ -52,16 +52,27 @@ class VariableReference;
 class RexxVariable : public RexxInternalObject
 {
  public:
+    // Tracks whether the variable holds the only reference to its string
+    // value so that appends can extend that string in place.  Any read of
+    // the value gives up the ownership.
+    typedef enum
+    {
+        VALUE_SHARED,                    // the value may be referenced elsewhere
+        VALUE_OWNED,                     // nobody has read the value since it was assigned
+        VALUE_APPENDING,                 // an append is evaluating its operands
+    } ValueOwnership;
+
     void *operator new(size_t);
     inline void  operator delete(void *) { }
 
-    inline RexxVariable() : variableName(OREF_NULL), variableValue(OREF_NULL), creator(OREF_NULL), dependents(OREF_NULL) {;};
-    inline RexxVariable(RexxString *n) : variableName(n), variableValue(OREF_NULL), creator(OREF_NULL), dependents(OREF_NULL) {;};
+    inline RexxVariable() : variableName(OREF_NULL), variableValue(OREF_NULL), creator(OREF_NULL), dependents(OREF_NULL), ownership(VALUE_SHARED) {;};
+    inline RexxVariable(RexxString *n) : variableName(n), variableValue(OREF_NULL), creator(OREF_NULL), dependents(OREF_NULL), ownership(VALUE_SHARED) {;};
     inline RexxVariable(RESTORETYPE restoreType) { ; };
 
     void live(size_t) override;
     void liveGeneral(MarkReason reason) override;
     void flatten(Envelope *) override;
+    RexxInternalObject *copy() override;
 
     void inform(Activity *);
     void drop();
@@ -72,6 +83,7 @@ class RexxVariable : public RexxInternalObject
     inline void set(RexxObject *value)
     {
         setField(variableValue, value);
+        ownership = VALUE_SHARED;
         if (dependents != OREF_NULL)
         {
             notify();
@@ -83,8 +95,13 @@ class RexxVariable : public RexxInternalObject
     inline void setCreator(RexxActivation *creatorActivation) { creator = creatorActivation; }
     inline bool isLocal() { return creator != OREF_NULL; }
            bool isAliasable();
-    inline RexxObject *getVariableValue() { return variableValue; };
-    inline RexxObject *getResolvedValue() { return variableValue != OREF_NULL ? variableValue : variableName; };
+    inline RexxObject *getVariableValue() { ownership = VALUE_SHARED; return variableValue; };
+    inline RexxObject *getResolvedValue() { ownership = VALUE_SHARED; return variableValue != OREF_NULL ? variableValue : variableName; };
+    // access to the value that does not give up ownership.  Only for appends.
+    inline RexxObject *peekVariableValue() { return variableValue; }
+    inline ValueOwnership getOwnership() { return ownership; }
+    inline void setOwnership(ValueOwnership o) { ownership = o; }
+    void setOwned(RexxObject *value);
     inline RexxString *getName() { return variableName; }
     inline void setName(RexxString *name) { setField(variableName, name); }
     inline bool isDropped() { return variableValue == OREF_NULL; }
@@ -101,6 +118,7 @@ protected:
     RexxObject *variableValue;           // the assigned value of the variable.
     RexxActivation *creator;             // the activation that created this variable
     IdentityTable  *dependents;          // guard expression dependents
+    ValueOwnership  ownership;           // whether the value can be appended to in place
 };
 
 
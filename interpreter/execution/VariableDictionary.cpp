@@ -47,6 +47,7 @@
 #include "StringClass.hpp"
 #include "Activity.hpp"
 #include "ArrayClass.hpp"
+#include "ClassClass.hpp"
 #include "VariableDictionary.hpp"
 #include "StemClass.hpp"
 #include "ExpressionBaseVariable.hpp"
@@ -174,7 +175,7 @@ void VariableDictionary::initialize(size_t capacity)
     if (contents == OREF_NULL)
     {
         size_t bucketSize = HashCollection::calculateBucketSize(capacity);
-        contents = allocateContents(bucketSize, bucketSize * 2);
+        contents = allocateContents(bucketSize);
     }
 }
 
@@ -184,14 +185,13 @@ void VariableDictionary::initialize(size_t capacity)
  * collection.  Collections with special requirements should
  * override this and return the appropriate subclass.
  *
- * @param bucketSize The bucket size of the collection.
- * @param totalSize  The total capacity of the collection.
+ * @param bucketSize The number of slots in the collection.
  *
  * @return A new HashContents object appropriate for this collection type.
  */
-StringHashContents *VariableDictionary::allocateContents(size_t bucketSize, size_t totalSize)
+StringHashContents *VariableDictionary::allocateContents(size_t bucketSize)
 {
-    return new (totalSize) StringHashContents(bucketSize, totalSize);
+    return new (bucketSize) StringHashContents(bucketSize);
 }
 
 
@@ -213,7 +213,7 @@ void VariableDictionary::expandContents()
 void VariableDictionary::expandContents(size_t capacity )
 {
     size_t bucketSize = HashCollection::calculateBucketSize(capacity);
-    Protected<StringHashContents> newContents = allocateContents(bucketSize, bucketSize * 2);
+    Protected<StringHashContents> newContents = allocateContents(bucketSize);
     // copy all of the items into the new table
     contents->reMerge(newContents);
     // if this is a contents item in the old space, we need to
@@ -514,76 +514,62 @@ void VariableDictionary::set(RexxString *name, RexxObject *value)
 
 
 /**
- * Reserve a scope on an object, waiting for completion if this
- * is already reserved by another activity
+ * Reserve a scope on an object that is already reserved by a
+ * different activity, waiting for the lock if necessary.  This
+ * is the slow path of reserve().
  *
  * @param activity The activity reserving the scope.
  */
-void VariableDictionary::reserve(Activity *activity)
+void VariableDictionary::reserveContended(Activity *activity)
 {
-    // not reserved at all?  This is easy.
-    if (reservingActivity == OREF_NULL)
-    {
-        // Activity objects are automatically safe from
-        // garbage collection and this is something we
-        // want to occur as quickly a possible, so just assign
-        // this value directly without worrying about old-to-new issues.
-        reservingActivity = activity;
-        reserveCount = 1;
-    }
     // doing this again on the same stack?  Just bump the
     // nesting count. Note that nested activities created via
     // attach thread will count as being part of the same activity
     // stack since they are on the same system thread.
-    else if (activity->isSameActivityStack(reservingActivity))
+    if (activity->isSameActivityStack(reservingActivity))
     {
         reserveCount++;
+        return;
     }
+
     // we have an access collision.  We need to wait on this one.
-    else
+    reservingActivity->checkDeadLock(activity);
+    // keep track of how often this happens for each class scope
+    if (scope != OREF_NULL && (RexxObject *)scope != TheNilObject)
     {
-        reservingActivity->checkDeadLock(activity);
-        // this one we need to use setField()
-        if (waitingActivities == OREF_NULL)
-        {
-            setField(waitingActivities, new_array());
-        }
-        // add to the end of the queue
-        waitingActivities->append(activity);
-        // ok, now we wait
-        // When release() wakes us via reservePost(), it has already set
-        // reservingActivity = us and reserveCount = 1.
-        // reserveSem is only posted by release(), never by
-        // RexxVariable::notify() (which uses guardSem).
-        activity->waitReserve(this);
+        scope->noteGuardContention();
+    }
+    // this one we need to use setField()
+    if (waitingActivities == OREF_NULL)
+    {
+        setField(waitingActivities, new_array());
     }
+    // add to the end of the queue
+    waitingActivities->append(activity);
+    // ok, now we wait
+    // When release() wakes us via reservePost(), it has already set
+    // reservingActivity = us and reserveCount = 1.
+    // reserveSem is only posted by release(), never by
+    // RexxVariable::notify() (which uses guardSem).
+    activity->waitReserve(this);
 }
 
 
 /**
- * Release the lock on an object's variable dictionary.
- *
- * @param activity The activity owning the lock.
+ * Hand a released lock over to the first waiting activity,
+ * if there is one.
  */
-void VariableDictionary::release(Activity *activity)
+void VariableDictionary::releaseToWaiter()
 {
-    reserveCount--;
-    // if this is the last reserver on this activity, we just clear everything out
-    if (reserveCount == 0)
+    if (!waitingActivities->isEmpty())
     {
-        // setField() not required here.  See comment in reserve()
-        reservingActivity = OREF_NULL;
-        // potential waiters?
-        if (waitingActivities != OREF_NULL && !waitingActivities->isEmpty())
-        {
-            // remove the first item and make it the new reserver
-            reservingActivity = (Activity *)waitingActivities->removeFirst();
-            reserveCount = 1;
-            // wake up the waiting activity using the dedicated reserve
-            // semaphore so it cannot be confused with guard expression
-            // notifications posted via guardPost/guardSem.
-            reservingActivity->reservePost();
-        }
+        // remove the first item and make it the new reserver
+        reservingActivity = (Activity *)waitingActivities->removeFirst();
+        reserveCount = 1;
+        // wake up the waiting activity using the dedicated reserve
+        // semaphore so it cannot be confused with guard expression
+        // notifications posted via guardPost/guardSem.
+        reservingActivity->reservePost();
     }
 }
 
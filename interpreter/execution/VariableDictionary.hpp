@@ -133,7 +133,7 @@ class VariableDictionary : public RexxInternalObject
            VariableDictionary(RexxClass *scope);
     inline VariableDictionary(RESTORETYPE restoreType) { ; };
 
-    StringHashContents *allocateContents(size_t bucketSize, size_t capacity);
+    StringHashContents *allocateContents(size_t bucketSize);
 
     void initialize(size_t capacity = DefaultObjectDictionarySize);
     void expandContents();
@@ -194,8 +194,57 @@ class VariableDictionary : public RexxInternalObject
     void         set(RexxString *, RexxObject *);
     void         drop(RexxString *);
     void         dropStemVariable(RexxString *);
-    void         reserve(Activity *);
-    void         release(Activity *);
+    /**
+     * Reserve the scope lock for an activity.  All guard handling
+     * runs while holding the interpreter lock, so the uncontended
+     * and nested cases are just an update of the owner and count.
+     * The owner is deliberately a plain field rather than an atomic
+     * word: the interpreter lock already orders every access, and no
+     * thread can reach this code without it.
+     *
+     * @param activity The activity reserving the scope.
+     */
+    inline void reserve(Activity *activity)
+    {
+        // not reserved at all?  This is easy.  Activity objects are automatically
+        // safe from garbage collection, so no setField() required
+        if (reservingActivity == OREF_NULL)
+        {
+            reservingActivity = activity;
+            reserveCount = 1;
+        }
+        // nested reservation by the same activity
+        else if (reservingActivity == activity)
+        {
+            reserveCount++;
+        }
+        else
+        {
+            reserveContended(activity);
+        }
+    }
+
+    /**
+     * Release the scope lock held by an activity.
+     *
+     * @param activity The activity owning the lock.
+     */
+    inline void release(Activity *activity)
+    {
+        // if this is the last reserver on this activity, we just clear everything out
+        if (--reserveCount == 0)
+        {
+            reservingActivity = OREF_NULL;
+            // the wait queue only exists once someone had to wait
+            if (waitingActivities != OREF_NULL)
+            {
+                releaseToWaiter();
+            }
+        }
+    }
+
+    void         reserveContended(Activity *);
+    void         releaseToWaiter();
     bool         transfer(Activity *);
 
     CompoundTableElement *getCompoundVariable(RexxString *stemName, RexxInternalObject **tail, size_t tailCount);
@@ -59,6 +59,10 @@ class RexxExpressionOperator : public RexxInternalObject
     void   flatten(Envelope *) override;
 
     inline const char *operatorName() { return operatorNames[oper]; }
+    inline TokenSubclass getOperator() { return oper; }
+    inline RexxInternalObject *getLeftTerm() { return left_term; }
+    inline RexxInternalObject *getRightTerm() { return right_term; }
+    inline bool isConcatenation() { return oper == OPERATOR_CONCATENATE || oper == OPERATOR_ABUTTAL || oper == OPERATOR_BLANK; }
 
 protected:
     // table of operator names
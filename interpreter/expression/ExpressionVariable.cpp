@@ -117,6 +117,20 @@ void RexxSimpleVariable::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Resolve the variable object this retriever refers to in
+ * the current context.
+ *
+ * @param context The current execution context.
+ *
+ * @return The variable object.
+ */
+RexxVariable *RexxSimpleVariable::getVariable(RexxActivation *context)
+{
+    return context->getLocalVariable(variableName, index);
+}
+
+
 /**
  * Evaluate a simple variable in an expression.
  *
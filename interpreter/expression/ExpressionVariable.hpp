@@ -84,6 +84,7 @@ class RexxSimpleVariable : public RexxVariableBase
     void alias(RexxActivation *, RexxVariable *) override;
 
     RexxString *getName();
+    RexxVariable *getVariable(RexxActivation *);
 
 protected:
 
@@ -45,6 +45,9 @@
 #include "ExpressionBaseVariable.hpp"
 #include "RexxActivation.hpp"
 #include "AssignmentInstruction.hpp"
+#include "ExpressionVariable.hpp"
+#include "ExpressionOperator.hpp"
+#include "RexxVariable.hpp"
 
 RexxInstructionAssignment::RexxInstructionAssignment(RexxVariableBase *target, RexxInternalObject *_expression)
 {
@@ -130,3 +133,177 @@ void RexxInstructionAssignment::execute(RexxActivation *context, ExpressionStack
     }
 }
 
+
+
+/**
+ * Create an append assignment.
+ *
+ * @param target      The simple variable that is assigned to.
+ * @param _expression The complete assignment expression.
+ * @param count       The number of concatenation operators on the left side
+ *                    of the expression, between the expression and the target.
+ */
+RexxInstructionAppendAssignment::RexxInstructionAppendAssignment(RexxVariableBase *target,
+    RexxInternalObject *_expression, size_t count) : RexxInstructionAssignment(target, _expression)
+{
+    operatorCount = count;
+    // the outermost operator is the last one applied
+    RexxInternalObject *term = _expression;
+    for (size_t i = count; i > 0; i--)
+    {
+        operators[i - 1] = (RexxBinaryOperator *)term;
+        term = operators[i - 1]->getLeftTerm();
+    }
+}
+
+
+/**
+ * Perform garbage collection on a live object.
+ *
+ * @param liveMark The current live mark.
+ */
+void RexxInstructionAppendAssignment::live(size_t liveMark)
+{
+    memory_mark(nextInstruction);
+    memory_mark(variable);
+    memory_mark(expression);
+    memory_mark_array(operatorCount, operators);
+}
+
+
+/**
+ * Perform generalized live marking on an object.  This is
+ * used when mark-and-sweep processing is needed for purposes
+ * other than garbage collection.
+ *
+ * @param reason The reason for the marking call.
+ */
+void RexxInstructionAppendAssignment::liveGeneral(MarkReason reason)
+{
+    // must be first object marked
+    memory_mark_general(nextInstruction);
+    memory_mark_general(variable);
+    memory_mark_general(expression);
+    memory_mark_general_array(operatorCount, operators);
+}
+
+
+/**
+ * Flatten a source object.
+ *
+ * @param envelope The envelope that will hold the flattened object.
+ */
+void RexxInstructionAppendAssignment::flatten(Envelope *envelope)
+{
+    setUpFlatten(RexxInstructionAppendAssignment)
+
+    flattenRef(nextInstruction);
+    flattenRef(variable);
+    flattenRef(expression);
+    flattenArrayRefs(operatorCount, operators);
+
+    cleanUpFlatten
+}
+
+
+/**
+ * Execute an append assignment.  The operands are evaluated
+ * and converted in the same order as the full expression
+ * would, and only once all of them are done, they are copied
+ * straight into the result.  If the variable still holds the
+ * only reference to its current value at that point, and that
+ * string has room, the data goes into the unused space of the
+ * string and the string is extended in place.  Otherwise a new
+ * string with room for further appends is built.
+ *
+ * @param context The current execution context.
+ * @param stack   The current evaluation stack.
+ */
+void RexxInstructionAppendAssignment::execute(RexxActivation *context, ExpressionStack *stack)
+{
+    // tracing shows each intermediate result, so use the full expression
+    if (context->tracingInstructions())
+    {
+        RexxInstructionAssignment::execute(context, stack);
+        return;
+    }
+
+    RexxVariable *target = ((RexxSimpleVariable *)variable)->getVariable(context);
+    RexxObject *value = target->peekVariableValue();
+
+    // we only handle appends to non-null primitive strings.  Everything else
+    // (NOVALUE handling, other objects that might implement their own
+    // concatenation operators) goes through the normal expression evaluation.
+    if (value == OREF_NULL || !isString(value) || ((RexxString *)value)->getLength() == 0)
+    {
+        variable->assign(context, expression->evaluate(context, stack));
+        return;
+    }
+
+    RexxString *current = (RexxString *)value;
+    size_t length = current->getLength();
+
+    // if nothing else can see the current value, we might be able to write into its
+    // spare space.  Any read of the variable while the operands are evaluated
+    // cancels this.
+    bool appending = target->getOwnership() == RexxVariable::VALUE_OWNED && !current->isOldSpace();
+    if (appending)
+    {
+        target->setOwnership(RexxVariable::VALUE_APPENDING);
+    }
+
+    // the original value stays protected in the position of the left operand
+    stack->push(current);
+
+    // The operands might read the variable (and with it, the current value), so
+    // nothing gets written until all of them are evaluated.  The converted pieces
+    // stay protected on the stack until they are copied.  The parser reserved the
+    // stack space for this.
+    size_t newLength = length;
+    for (size_t i = 0; i < operatorCount; i++)
+    {
+        RexxObject *operand = operators[i]->getRightTerm()->evaluate(context, stack);
+        RexxString *piece = operand->requestString();
+        stack->prefixResult(piece);
+        newLength += piece->getLength() + (operators[i]->getOperator() == OPERATOR_BLANK ? 1 : 0);
+    }
+
+    // concatenating null strings does not change anything, this is just an
+    // assignment of the same value
+    if (newLength == length)
+    {
+        variable->assign(context, current);
+        return;
+    }
+
+    // we can only use the current value if nobody read or changed the variable
+    // in the meantime.
+    appending = appending && target->getOwnership() == RexxVariable::VALUE_APPENDING && target->peekVariableValue() == current;
+
+    RexxString *result = current;
+    if (!appending || newLength > current->getCapacity())
+    {
+        // the first copy of a shared value is an exact fit.  Once we are
+        // appending to our own copy, double the room so that a loop
+        // of appends only copies the data a logarithmic number of times.
+        size_t capacity = appending ? newLength * 2 : newLength;
+        result = RexxString::rawString(length, capacity);
+        result->put(0, current->getStringData(), length);
+    }
+
+    // the first piece is the deepest one on the stack
+    char *data = result->getWritableData() + length;
+    for (size_t i = 0; i < operatorCount; i++)
+    {
+        RexxString *piece = (RexxString *)stack->peek(operatorCount - 1 - i);
+        if (operators[i]->getOperator() == OPERATOR_BLANK)
+        {
+            *data++ = ' ';
+        }
+        memcpy(data, piece->getStringData(), piece->getLength());
+        data += piece->getLength();
+    }
+
+    result->extendLength(newLength);
+    target->setOwned(result);
+}
@@ -63,4 +63,31 @@ class RexxInstructionAssignment : public RexxInstruction
     RexxInternalObject *expression;      // assignment expression
     RexxVariableBase *variable;          // assignment target
 };
+
+
+class RexxBinaryOperator;
+
+/**
+ * An assignment that appends to the value of the target
+ * variable ("var = var || expr", "var ||= expr", and similar).
+ * While the variable holds the only reference to its string
+ * value, the string is extended in place rather than copied.
+ */
+class RexxInstructionAppendAssignment : public RexxInstructionAssignment
+{
+ public:
+    RexxInstructionAppendAssignment(RexxVariableBase *, RexxInternalObject *, size_t);
+    inline RexxInstructionAppendAssignment(RESTORETYPE restoreType) : RexxInstructionAssignment(restoreType) { ; };
+
+    void live(size_t) override;
+    void liveGeneral(MarkReason reason) override;
+    void flatten(Envelope *) override;
+
+    void execute(RexxActivation *, ExpressionStack *) override;
+
+ protected:
+
+    size_t operatorCount;                // number of concatenations
+    RexxBinaryOperator *operators[1];    // the concatenations, innermost first
+};
 #endif
@@ -48,6 +48,8 @@
 #include "ParseTrigger.hpp"
 #include "ParseTarget.hpp"
 #include "ExpressionBaseVariable.hpp"
+#include "ExpressionVariable.hpp"
+#include "IntegerClass.hpp"
 #include "MethodArguments.hpp"
 
 /**
@@ -83,6 +85,33 @@ ParseTrigger::ParseTrigger(ParseTriggerType type, RexxInternalObject *_value, si
     // now copy any arguments from the sub term stack
     // NOTE:  The arguments are in last-to-first order on the stack.
     initializeObjectArray(_variableCount, variables, RexxVariableBase, _variables);
+
+    // Work out what this trigger can do without the general machinery.  Literal
+    // patterns and whole number positions can be used directly without evaluating
+    // them each time, and simple variables can be assigned directly in their
+    // variable slots.
+    constantValue = false;
+    if (value != OREF_NULL)
+    {
+        if (triggerType == TRIGGER_STRING || triggerType == TRIGGER_MIXED)
+        {
+            constantValue = isString(value);
+        }
+        else
+        {
+            constantValue = isInteger(value) && ((RexxInteger *)value)->getValue() >= 0;
+        }
+    }
+
+    simpleVariables = true;
+    for (size_t i = 0; i < variableCount; i++)
+    {
+        if (variables[i] != OREF_NULL && !isOfClass(VariableTerm, variables[i]))
+        {
+            simpleVariables = false;
+            break;
+        }
+    }
 }
 
 
@@ -188,6 +217,127 @@ RexxString *ParseTrigger::stringTrigger(RexxActivation *context, ExpressionStack
  */
 void ParseTrigger::parse(RexxActivation *context, ExpressionStack *stack,
     RexxTarget *target )
+{
+    // if we are tracing, we need to display each trigger and assignment result.  We
+    // have two copies of this, one optimized for untraced operation and a second
+    // one for traced operation.
+    if (context->tracingResults())
+    {
+        move(context, stack, target);
+        assignTraced(context, target);
+        return;
+    }
+
+    if (constantValue)
+    {
+        moveConstant(context, stack, target);
+    }
+    else
+    {
+        move(context, stack, target);
+    }
+
+    // simple variables can be resolved up front and then set directly.
+    // Since the variable objects are anchored in the context, the extracted
+    // strings need no other protection.
+    if (simpleVariables)
+    {
+        for (size_t i = 0; i < variableCount; i++)
+        {
+            RexxSimpleVariable *variable = (RexxSimpleVariable *)variables[i];
+            bool last = i + 1 == variableCount;
+            if (variable != OREF_NULL)
+            {
+                RexxVariable *slot = variable->getVariable(context);
+                slot->set(last ? target->remainder() : target->getWord());
+            }
+            // placeholders skip without creating a string
+            else if (last)
+            {
+                target->skipRemainder();
+            }
+            else
+            {
+                target->skipWord();
+            }
+        }
+        return;
+    }
+
+    assign(context, target);
+}
+
+
+/**
+ * Apply the movement part of a trigger when the trigger value
+ * is a literal.
+ *
+ * @param context The current execution context.
+ * @param stack   The current evaluation stack.
+ * @param target  The current parsing context.
+ */
+void ParseTrigger::moveConstant(RexxActivation *context, ExpressionStack *stack, RexxTarget *target)
+{
+    switch (triggerType)
+    {
+        case TRIGGER_STRING:
+            target->search((RexxString *)value);
+            return;
+
+        case TRIGGER_MIXED:
+            target->caselessSearch((RexxString *)value);
+            return;
+
+        default:
+            break;
+    }
+
+    // a literal position still needs to be valid under the current digits setting.
+    // If not, the normal path raises the error.
+    wholenumber_t position = ((RexxInteger *)value)->getValue();
+    if (!Numerics::isValid(position, number_digits()))
+    {
+        move(context, stack, target);
+        return;
+    }
+
+    switch (triggerType)
+    {
+        case TRIGGER_PLUS:
+            target->forward(position);
+            break;
+
+        case TRIGGER_MINUS:
+            target->backward(position);
+            break;
+
+        case TRIGGER_PLUS_LENGTH:
+            target->forwardLength(position);
+            break;
+
+        case TRIGGER_MINUS_LENGTH:
+            target->backwardLength(position);
+            break;
+
+        case TRIGGER_ABSOLUTE:
+            target->absolute(position);
+            break;
+
+        default:
+            move(context, stack, target);
+            break;
+    }
+}
+
+
+/**
+ * Apply the movement part of a parsing trigger.
+ *
+ * @param context The current execution context.
+ * @param stack   The current evaluation stack.
+ * @param target  The current parsing context.
+ */
+void ParseTrigger::move(RexxActivation *context, ExpressionStack *stack, RexxTarget *target)
 {
     // perform the trigger operaitons
     switch (triggerType)
@@ -241,19 +391,78 @@ void ParseTrigger::parse(RexxActivation *context, ExpressionStack *stack,
             reportException(Error_Interpretation_switch, "PARSE trigger type", triggerType);
             break;
     }
+}
 
-    // if we are tracing, we need to display each assignment result.  We
-    // have two copies of this loop, one optimized for untraced operation and
-    // a second one for traced operation.
-    if (context->tracingResults())
+
+/**
+ * Assign the trigger variables with tracing.
+ *
+ * @param context The current execution context.
+ * @param target  The current parsing context.
+ */
+void ParseTrigger::assignTraced(RexxActivation *context, RexxTarget *target)
+{
+    for (size_t i = 0; i < variableCount; i++)
     {
-        for (size_t i = 0; i < variableCount; i++)
+        RexxString *variableValue;
+
+        // if this is the last variable on the list, this gets the
+        // remainder of the parsing segment.  Otherwise, we just
+        // extract the next blank delimited word.
+        if (i + 1 == variableCount)
         {
-            RexxString *variableValue;
+            variableValue = target->remainder();
+        }
+        else
+        {
+            variableValue = target->getWord();
+        }
+        // needs protecting
+        ProtectedObject p(variableValue);
+        // get the next variable
+        RexxVariableBase *variable = variables[i];
+        // the '.' dummy placeholder shows up as a NULL value in the list.
+        // the dummy placeholder has a special trace form.
+        if (variable != OREF_NULL)
+        {
+            // NOTE:  The different variable types handle their own assignment tracing
+            variable->assign(context, variableValue);
+            // if only tracing results and not intermediates, then we need to
+            // trace this value explicitly.
+            if (!context->tracingIntermediates())
+            {
+                context->traceResult(variableValue);
+            }
+        }
+        // this is the dummy variable
+        else
+        {
+            context->traceIntermediate(variableValue, RexxActivation::TRACE_PREFIX_DUMMY);
+        }
+    }
+}
 
-            // if this is the last variable on the list, this gets the
-            // remainder of the parsing segment.  Otherwise, we just
-            // extract the next blank delimited word.
+
+/**
+ * Assign the trigger variables without tracing.  This handles
+ * compound variables and message terms, which might need to
+ * allocate objects while assigning.
+ *
+ * @param context The current execution context.
+ * @param target  The current parsing context.
+ */
+void ParseTrigger::assign(RexxActivation *context, RexxTarget *target)
+{
+    for (size_t i = 0; i < variableCount; i++)
+    {
+        // get the next retriever
+        RexxVariableBase *variable = variables[i];
+        // if we have a real variable (not a .), extract the string piece and assign.
+        if (variable != OREF_NULL)
+        {
+            RexxObject *variableValue;
+            // if this is the last variable in the list, grab the remainder,
+            // otherwise, we need to parse word off.
             if (i + 1 == variableCount)
             {
                 variableValue = target->remainder();
@@ -262,71 +471,24 @@ void ParseTrigger::parse(RexxActivation *context, ExpressionStack *stack,
             {
                 variableValue = target->getWord();
             }
-            // needs protecting
+            // needs protecting if the assignment is a compound var or a message
+            // target.
             ProtectedObject p(variableValue);
-            // get the next variable
-            RexxVariableBase *variable = variables[i];
-            // the '.' dummy placeholder shows up as a NULL value in the list.
-            // the dummy placeholder has a special trace form.
-            if (variable != OREF_NULL)
-            {
-                // NOTE:  The different variable types handle their own assignment tracing
-                variable->assign(context, variableValue);
-                // if only tracing results and not intermediates, then we need to
-                // trace this value explicitly.
-                if (!context->tracingIntermediates())
-                {
-                    context->traceResult(variableValue);
-                }
-            }
-            // this is the dummy variable
-            else
-            {
-                context->traceIntermediate(variableValue, RexxActivation::TRACE_PREFIX_DUMMY);
-            }
+            // do the assignment                 */
+            variable->assign(context, variableValue);
         }
-    }
-    // not tracing...this version is a bit more optimized.
-    else
-    {
-        for (size_t i = 0; i < variableCount; i++)
+        // dummy variable, we just skip the assignment
+        else
         {
-            // get the next retriever
-            RexxVariableBase *variable = variables[i];
-            // if we have a real variable (not a .), extract the string piece and assign.
-            if (variable != OREF_NULL)
+            // we need to figure out if we're skipping a word, or skipping everything.
+            if (i + 1 == variableCount)
             {
-                RexxObject *variableValue;
-                // if this is the last variable in the list, grab the remainder,
-                // otherwise, we need to parse word off.
-                if (i + 1 == variableCount)
-                {
-                    variableValue = target->remainder();
-                }
-                else
-                {
-                    variableValue = target->getWord();
-                }
-                // needs protecting if the assignment is a compound var or a message
-                // target.
-                ProtectedObject p(variableValue);
-                // do the assignment                 */
-                variable->assign(context, variableValue);
+                target->skipRemainder();
             }
-            // dummy variable, we just skip the assignment
             else
             {
-                // we need to figure out if we're skipping a word, or skipping everything.
-                if (i + 1 == variableCount)
-                {
-                    target->skipRemainder();
-                }
-                else
-                {
-                    target->skipWord();
-                }
+                target->skipWord();
             }
         }
     }
 }
-
@@ -76,11 +76,17 @@ class ParseTrigger : public RexxInternalObject
     size_t integerTrigger(RexxActivation *context, ExpressionStack *stack);
     RexxString *stringTrigger(RexxActivation *context, ExpressionStack *stack);
     void        parse(RexxActivation *, ExpressionStack *, RexxTarget *);
+    void        move(RexxActivation *, ExpressionStack *, RexxTarget *);
+    void        moveConstant(RexxActivation *, ExpressionStack *, RexxTarget *);
+    void        assign(RexxActivation *, RexxTarget *);
+    void        assignTraced(RexxActivation *, RexxTarget *);
 
 protected:
 
     ParseTriggerType  triggerType;       // type of trigger
     RexxInternalObject *value;           // value associated with trigger (can be an expression)
+    bool        constantValue;           // the value is a literal string or whole number needing no evaluation
+    bool        simpleVariables;         // all targets are simple variables or '.' placeholders
     size_t      variableCount;           // count of variables to assign after applying trigger
     RexxVariableBase *variables[1];      // after applying trigger
 };
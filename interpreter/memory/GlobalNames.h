@@ -273,6 +273,7 @@ GLOBAL_NAME(NOTIFY,              "NOTIFY")              // TraceObject: NOTIFY c
 GLOBAL_NAME(OPTION,              "OPTION")              // TraceObject: option at creation time
 GLOBAL_NAME(RECEIVER,            "RECEIVER")            // TraceObject: the receiver of a message
 GLOBAL_NAME(SCOPELOCKCOUNT,      "SCOPELOCKCOUNT")      // TraceObject: a counter (number, reserveCount)
+GLOBAL_NAME(SCOPELOCKCONTENTIONS, "SCOPELOCKCONTENTIONS") // TraceObject: times the method's scope lock had to be waited for
 GLOBAL_NAME(STACKFRAME,          "STACKFRAME")          // TraceObject: the RexxActivation's stack frame
 GLOBAL_NAME(TARGET,              "TARGET")              // TraceObject: message and index name (StackFrame and StringTable)
 GLOBAL_NAME(THREAD,              "THREAD")              // TraceObject: a counter (number, activity)
@@ -208,7 +208,7 @@ void NormalSegmentSet::checkObjectOverlap(DeadObject *obj)
  * @param mem    The hosting memory object.
  */
 LargeSegmentSet::LargeSegmentSet(MemoryObject *mem) :
-    MemorySegmentSet(mem, SET_NORMAL, "Large Allocation Segments"),
+    MemorySegmentSet(mem, SET_LARGEBLOCK, "Large Allocation Segments"),
     deadCache("Large Block Allocation Pool"), requests(0), smallestObject(0), largestObject(0) { }
 
 
@@ -266,6 +266,9 @@ NormalSegmentSet::NormalSegmentSet(MemoryObject *mem) :
     // to potentiall recover from errors in case there is an out of memory error. This
     // doesn't need to be a full segment worth, 1/2 should do
     recoverSegment = memory->newSegment(RecoverSegmentSize, RecoverSegmentSize);
+    // no sweep is pending until the first garbage collection
+    lazySweepSegment = NULL;
+    lazySweepPosition = NULL;
 }
 
 
@@ -613,7 +616,8 @@ DeadObject *NormalSegmentSet::donateObject(size_t allocationLength)
 {
     // If we're being asked to donate an object, then the request is larger
     // than the threshold for objects we manage. Therefore, we can look directly
-    // in our large object cache.
+    // in our large object cache, once all of our dead storage is in there.
+    completeSweep();
     return (DeadObject *)findLargeDeadObject(allocationLength);
 }
 
@@ -979,17 +983,36 @@ void MemorySegmentSet::sweep()
  */
 void MemorySegmentSet::sweepSingleSegment(MemorySegment *sweepSegment)
 {
-    size_t mark = memoryObject.markWord;
-
     // clear the live objects counter for tracking
     sweepSegment->liveObjects = 0;
 
-    RexxInternalObject *objectPtr = sweepSegment->startObject();
+    sweepObjects(sweepSegment, sweepSegment->startObject(), sweepSegment->endObject());
+}
+
+
+/**
+ * Sweep a range of objects within a memory segment, returning the
+ * dead objects to the segment set dead object cache for reuse.
+ * The sweep stops at the first object boundary at or beyond the
+ * limit, but a string of dead objects that spans the limit is
+ * always swept up as a single block.
+ *
+ * @param sweepSegment
+ *                 The segment containing the objects.
+ * @param objectPtr The first object to sweep.
+ * @param limitPtr  The position where the sweep may stop.
+ *
+ * @return The first object that has not been swept.
+ */
+RexxInternalObject *MemorySegmentSet::sweepObjects(MemorySegment *sweepSegment, RexxInternalObject *objectPtr, RexxInternalObject *limitPtr)
+{
+    size_t mark = memoryObject.markWord;
+
     RexxInternalObject *endPtr = sweepSegment->endObject();
 
-    // now we need to look at all of the objects in the segment looking
+    // now we need to look at all of the objects in the range looking
     // for ones that don't have the current live mark.
-    while (objectPtr < endPtr)
+    while (objectPtr < limitPtr)
     {
         // live objects have been tagged by the marking operation.
         if (objectPtr->isObjectLive(mark))
@@ -1034,6 +1057,112 @@ void MemorySegmentSet::sweepSingleSegment(MemorySegment *sweepSegment)
             objectPtr = objectPtr->nextObject(deadLength);
         }
     }
+    return objectPtr;
+}
+
+
+/**
+ * Start the sweep of the normal segments following a mark
+ * operation.  The dead chains are rebuilt from scratch, but the
+ * segments themselves are swept incrementally as the allocator
+ * needs storage, which keeps the collection pause down to the
+ * mark operation.
+ */
+void NormalSegmentSet::beginSweep()
+{
+    // any sweep left over from the last cycle must already be finished,
+    // otherwise its dead objects would be dropped from the chains.
+    completeSweep();
+
+    prepareForSweep();
+    lazySweepSegment = first();
+    lazySweepPosition = NULL;
+    // an empty set has nothing to sweep
+    if (lazySweepSegment == NULL)
+    {
+        completeSweepOperation();
+    }
+}
+
+
+/**
+ * Sweep all segments that have not been processed yet by the
+ * lazy sweep.  This must be done before the mark word changes,
+ * since an unswept dead object would then appear to be live, and
+ * before anything that needs to walk all of the heap objects.
+ */
+void NormalSegmentSet::completeSweep()
+{
+    while (isSweepPending())
+    {
+        sweepNextIncrement();
+    }
+}
+
+
+/**
+ * Sweep the next portion of the pending lazy sweep.
+ */
+void NormalSegmentSet::sweepNextIncrement()
+{
+    MemorySegment *segment = lazySweepSegment;
+
+    // if this is the first increment for this segment, we're starting
+    // the live object count over.
+    if (lazySweepPosition == NULL)
+    {
+        segment->liveObjects = 0;
+        lazySweepPosition = segment->startObject();
+    }
+
+    char *limit = (char *)lazySweepPosition + SweepIncrement;
+    RexxInternalObject *limitPtr = limit < segment->end() ? (RexxInternalObject *)limit : segment->endObject();
+
+    lazySweepPosition = sweepObjects(segment, lazySweepPosition, limitPtr);
+
+    // finished with this segment? step to the next one.
+    if (lazySweepPosition >= segment->endObject())
+    {
+        lazySweepSegment = next(segment);
+        lazySweepPosition = NULL;
+        // once we've run out of segments, the sweep is complete
+        if (lazySweepSegment == NULL)
+        {
+            completeSweepOperation();
+        }
+    }
+}
+
+
+/**
+ * Continue a pending lazy sweep until storage for an allocation
+ * request has been reclaimed.  Once the sweep finishes, we have good
+ * data on the live and dead storage, so we decide whether the heap
+ * needs to be adjusted.
+ *
+ * @param allocationLength
+ *               The size of the object we need.
+ *
+ * @return An allocated object, or NULL if the sweep completed without
+ *         reclaiming a large enough block.
+ */
+RexxInternalObject *NormalSegmentSet::sweepForObject(size_t allocationLength)
+{
+    while (isSweepPending())
+    {
+        sweepNextIncrement();
+        if (!isSweepPending())
+        {
+            adjustMemorySize();
+        }
+
+        RexxInternalObject *newObject = findObject(allocationLength);
+        if (newObject != OREF_NULL)
+        {
+            return newObject;
+        }
+    }
+    return OREF_NULL;
 }
 
 
@@ -1134,15 +1263,19 @@ RexxInternalObject *NormalSegmentSet::findObject(size_t allocationLength)
  */
 RexxInternalObject *NormalSegmentSet::handleAllocationFailure(size_t allocationLength)
 {
+    // Step 1, reclaim any storage that has not been swept since the last GC
+    RexxInternalObject *newObject = sweepForObject(allocationLength);
+    if (newObject != OREF_NULL)
+    {
+        return newObject;
+    }
+
     memory->verboseMessage("Normal allocation failure for %zu bytes" line_end, allocationLength);
 
-    // Step 1, force a GC
+    // Step 2, force a GC and sweep until we find a block.  Once the sweep is
+    // complete, we have good GC data and the heap size gets adjusted if needed.
     memory->collect();
-    // Step 2, now that we have good GC data, decide if we need to adjust
-    // the heap size.
-    adjustMemorySize();
-    // Step 3, see if can allocate now
-    RexxInternalObject *newObject = findObject(allocationLength);
+    newObject = sweepForObject(allocationLength);
     // still no luck?
     if (newObject == OREF_NULL)
     {
@@ -276,6 +276,7 @@ class MemorySegmentSet
       virtual void addDeadObject(DeadObject *object);
       virtual void addDeadObject(char *object, size_t length);
       RexxInternalObject *splitDeadObject(DeadObject *object, size_t allocationLength, size_t splitMinimum);
+      RexxInternalObject *sweepObjects(MemorySegment *sweepSegment, RexxInternalObject *objectPtr, RexxInternalObject *limitPtr);
       void insertSegment(MemorySegment *segment);
       virtual size_t suggestMemoryExpansion();
       virtual void prepareForSweep();
@@ -437,6 +438,9 @@ class NormalSegmentSet : public MemorySegmentSet
     DeadObject *donateObject(size_t allocationLength) override;
     void    getInitialSet();
     size_t suggestMemoryExpansion() override;
+    void beginSweep();
+    void completeSweep();
+    inline bool isSweepPending() { return lazySweepSegment != NULL; }
 
   protected:
     void addDeadObject(DeadObject *object) override;
@@ -465,6 +469,8 @@ class NormalSegmentSet : public MemorySegmentSet
     static const size_t RecoverSegmentSize = ((MemorySegment::SegmentSize/2) - MemorySegment::MemorySegmentOverhead);
     // initial allocation size for normal space.
     static const size_t InitialNormalSegmentSpace;
+    // amount of segment storage examined by each step of a lazy sweep
+    static const size_t SweepIncrement = MemorySegment::SegmentSize / 4;
 
     // map an object length to an allocation deadpool.  NOTE:  this
     // assumes the length has already been rounded to ObjectGrain!
@@ -477,6 +483,8 @@ class NormalSegmentSet : public MemorySegmentSet
     inline size_t recommendedMemorySize() { return (size_t)((float)liveObjectBytes/(1.0 - NormalMemoryExpansionThreshold)); }
     void checkObjectOverlap(DeadObject *obj);
     RexxInternalObject *findObject(size_t allocationLength);
+    void sweepNextIncrement();
+    RexxInternalObject *sweepForObject(size_t allocationLength);
     inline RexxInternalObject *splitNormalDeadObject(DeadObject *object, size_t allocationLength, size_t deadLength)
     {
         /* we need to keep all of these sizes as ObjectGrain multiples, */
@@ -520,6 +528,8 @@ class NormalSegmentSet : public MemorySegmentSet
     DeadObjectPool subpools[DeadPools];   /* our set of allocation subpools */
     size_t lastUsedSubpool[DeadPools + 1];/* a look-aside index to tell us what pool to use for a given size */
     MemorySegment *recoverSegment;        /* our last-ditch memory segment */
+    MemorySegment *lazySweepSegment;      /* the next segment to be swept (NULL when no sweep is pending) */
+    RexxInternalObject *lazySweepPosition;/* the first unswept object in lazySweepSegment (NULL if not started) */
 };
 
 
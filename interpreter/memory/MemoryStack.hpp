@@ -115,6 +115,7 @@ class LiveStack
     inline bool        checkRoom() { return top < size; }
     inline bool        checkRoom(size_t needed) { return size - top > needed; }
     inline size_t      stackSize() { return size; };
+    inline size_t      items() { return top; };
     inline RexxInternalObject *stackTop() { return top == 0 ? OREF_NULL : stack[top - 1]; };
     inline void        copyEntries(LiveStack *other) { memcpy((char *)stack, (char *)other->stack, other->size * sizeof(RexxInternalObject *)); top = other->top; }
     inline void        clear() { memset(stack, 0, sizeof(RexxInternalObject*) * size); }
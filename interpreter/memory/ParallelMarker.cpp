@@ -0,0 +1,353 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                                                */
+/*                                                                            */
+/* Multi-threaded marking of the live object graph                            */
+/*                                                                            */
+/******************************************************************************/
+#include "RexxCore.h"
+#include "ParallelMarker.hpp"
+#include "Interpreter.hpp"
+
+thread_local MarkerStack *ParallelMarker::currentStack = NULL;
+
+
+/**
+ * Create a marker stack.  Like the main live stack, this is
+ * allocated from malloc() storage rather than the object heap.
+ */
+MarkerStack::MarkerStack()
+{
+    stack = new (InitialSize) LiveStack(InitialSize);
+    marked = 0;
+}
+
+
+/**
+ * Release the stack storage.
+ */
+MarkerStack::~MarkerStack()
+{
+    delete stack;
+}
+
+
+/**
+ * Grow the stack when it has filled up.
+ */
+void MarkerStack::expand()
+{
+    LiveStack *newStack = stack->reallocate(stack->stackSize());
+    delete stack;
+    stack = newStack;
+}
+
+
+/**
+ * Create the helper thread.  It parks on its run semaphore
+ * until a collection wants its help.
+ *
+ * @param m      The marker the thread helps.
+ */
+void MarkerThread::start(ParallelMarker *m)
+{
+    marker = m;
+    runSem.create();
+    doneSem.create();
+    started = true;
+    SysThread::createThread();
+}
+
+
+/**
+ * Shut the helper thread down and wait for it to end.
+ */
+void MarkerThread::stop()
+{
+    if (started)
+    {
+        marker = NULL;
+        runSem.post();
+        waitForTermination();
+        runSem.close();
+        doneSem.close();
+        started = false;
+    }
+}
+
+
+/**
+ * The helper thread loop.  Each time the run semaphore is
+ * posted we take part in one collection, then report back.
+ */
+void MarkerThread::dispatch()
+{
+    for (;;)
+    {
+        runSem.wait();
+        runSem.reset();
+        // a NULL marker is the request to shut down
+        if (marker == NULL)
+        {
+            return;
+        }
+        marker->helpMark();
+        doneSem.post();
+    }
+}
+
+
+/**
+ * Set up the parallel marker.  The helper threads are only
+ * created once a collection asks for them.
+ */
+ParallelMarker::ParallelMarker() : liveMark(0),
+    poolItems(0), participants(1), idleMarkers(0), finished(false), helperMarked(0)
+{
+    poolLock.create();
+    workSem.create();
+}
+
+
+/**
+ * Stop the helper threads.
+ */
+ParallelMarker::~ParallelMarker()
+{
+    for (size_t i = 0; i < MaxMarkers - 1; i++)
+    {
+        helpers[i].stop();
+    }
+    workSem.close();
+    poolLock.close();
+}
+
+
+/**
+ * Mark everything reachable from a root object.  The calling
+ * thread marks along with the helpers and returns once every
+ * reachable object has been marked.
+ *
+ * @param root   The root of the live object graph.
+ * @param m      The number of threads to use, including the collecting one.
+ * @param l      The live mark value used for this collection.
+ *
+ * @return The number of objects traced.
+ */
+size_t ParallelMarker::markFrom(RexxInternalObject *root, size_t m, size_t l)
+{
+    // the activity lists are maintained under the resource lock, often by
+    // threads without kernel access.  We take it here, before any work is
+    // shared, and hold it until all of the helpers are done.  This keeps the
+    // lists stable while the helpers read them without locking, since a helper
+    // waiting for the lock could block forever if this thread already owns it.
+    ResourceSection lock;
+
+    // the helpers are all parked, so nobody else is looking at this state
+    liveMark = l;
+    poolItems = 0;
+    participants = 1;
+    idleMarkers = 0;
+    finished = false;
+    helperMarked = 0;
+    workSem.reset();
+
+    MarkerStack stack;
+    currentStack = &stack;
+
+    // marking the root pushes it onto our stack, which gives us the
+    // first batch of work to share out.
+    memoryObject.mark(root);
+
+    size_t helperCount = std::min(m, (size_t)MaxMarkers) - 1;
+    for (size_t i = 0; i < helperCount; i++)
+    {
+        if (!helpers[i].started)
+        {
+            helpers[i].start(this);
+        }
+        helpers[i].beginMark();
+    }
+
+    drain(stack);
+
+    // everything has been marked once drain() returns, but the helpers
+    // might still be on their way out.
+    for (size_t i = 0; i < helperCount; i++)
+    {
+        helpers[i].waitForMark();
+    }
+
+    currentStack = NULL;
+    return stack.marked + helperMarked;
+}
+
+
+/**
+ * Take part in the marking as a helper thread.
+ */
+void ParallelMarker::helpMark()
+{
+    // a thread that was slow to start up may have missed the whole
+    // thing, in which case it never joins.
+    poolLock.request();
+    if (finished)
+    {
+        poolLock.release();
+        return;
+    }
+    participants++;
+    poolLock.release();
+
+    MarkerStack stack;
+    currentStack = &stack;
+    drain(stack);
+    currentStack = NULL;
+
+    helperMarked += stack.marked;
+}
+
+
+/**
+ * Trace objects until there is no more work for anybody.
+ *
+ * @param stack  The mark stack for this thread.
+ */
+void ParallelMarker::drain(MarkerStack &stack)
+{
+    // the memory_mark() macro expects a local liveMark
+    size_t liveMark = this->liveMark;
+
+    do
+    {
+        RexxInternalObject *markObject;
+        while ((markObject = stack.pop()) != OREF_NULL)
+        {
+            // mark the behaviour as live, then the objects this one references
+            memory_mark(markObject->behaviour);
+            stack.marked++;
+            markObject->live(liveMark);
+
+            // if somebody has run out of work and we have plenty, give some away
+            if (idleMarkers.load(std::memory_order_relaxed) > 0 && stack.items() > ShareThreshold &&
+                poolItems.load(std::memory_order_relaxed) < ShareCount)
+            {
+                shareWork(stack);
+            }
+        }
+    } while (findWork(stack));
+}
+
+
+/**
+ * Move some of our pending objects into the shared pool.
+ *
+ * @param stack  The mark stack for this thread.
+ */
+void ParallelMarker::shareWork(MarkerStack &stack)
+{
+    poolLock.request();
+    for (size_t i = 0; i < ShareCount; i++)
+    {
+        pool.push(stack.pop());
+    }
+    poolItems = pool.items();
+    // wake up anybody waiting for work
+    workSem.post();
+    poolLock.release();
+}
+
+
+/**
+ * Get more work once our own stack is empty, waiting for
+ * another marker to share some if the pool is empty.
+ *
+ * @param stack  The mark stack for this thread.
+ *
+ * @return true if we have more work, false if marking is complete.
+ */
+bool ParallelMarker::findWork(MarkerStack &stack)
+{
+    bool waiting = false;
+
+    for (;;)
+    {
+        poolLock.request();
+        if (pool.items() > 0)
+        {
+            for (size_t i = 0; i < ShareCount && pool.items() > 0; i++)
+            {
+                stack.push(pool.pop());
+            }
+            poolItems = pool.items();
+            if (waiting)
+            {
+                idleMarkers--;
+            }
+            poolLock.release();
+            return true;
+        }
+
+        if (!waiting)
+        {
+            waiting = true;
+            idleMarkers++;
+        }
+
+        // when every marker is out of work and the pool is empty, there
+        // is nothing left that could produce more.
+        if (idleMarkers == participants)
+        {
+            finished = true;
+            workSem.post();
+            poolLock.release();
+            return false;
+        }
+        if (finished)
+        {
+            poolLock.release();
+            return false;
+        }
+        // the pool is empty, so wait for the next share.  The reset
+        // happens under the pool lock, so a share made after we
+        // release the lock still wakes us.
+        workSem.reset();
+        poolLock.release();
+        workSem.wait();
+    }
+}
@@ -0,0 +1,181 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                           ParallelMarker.hpp   */
+/*                                                                            */
+/* Multi-threaded marking of the live object graph                            */
+/*                                                                            */
+/******************************************************************************/
+#ifndef Included_ParallelMarker
+#define Included_ParallelMarker
+
+#include "SysThread.hpp"
+#include "SysSemaphore.hpp"
+#include "MemoryStack.hpp"
+#include <atomic>
+
+class ParallelMarker;
+
+
+/**
+ * The private mark stack of one thread taking part in a
+ * parallel mark.  Only the owning thread pushes and pops, so
+ * no locking is needed here.
+ */
+class MarkerStack
+{
+ public:
+    enum
+    {
+        InitialSize = 16 * 1024       // starting number of stack slots
+    };
+
+    MarkerStack();
+    ~MarkerStack();
+
+    inline void push(RexxInternalObject *obj)
+    {
+        if (!stack->checkRoom())
+        {
+            expand();
+        }
+        stack->push(obj);
+    }
+    inline RexxInternalObject *pop() { return stack->pop(); }
+    inline size_t items() { return stack->items(); }
+    void expand();
+
+    LiveStack *stack;                 // the stack of objects waiting for their live() call
+    size_t     marked;                // count of objects this thread has traced
+};
+
+
+/**
+ * A helper thread that joins the marking for each parallel
+ * collection.  The thread is created the first time it is
+ * needed and then stays parked on its run semaphore between
+ * collections.
+ */
+class MarkerThread : public SysThread
+{
+ public:
+    inline MarkerThread() : SysThread(), marker(NULL), started(false) { }
+    inline ~MarkerThread() { terminate(); }
+
+    void start(ParallelMarker *m);
+    void stop();
+    void dispatch() override;
+
+    inline void beginMark() { runSem.post(); }
+    inline void waitForMark() { doneSem.wait(); doneSem.reset(); }
+
+    ParallelMarker *marker;           // the marker we belong to
+    SysSemaphore runSem;              // posted when a collection wants our help
+    SysSemaphore doneSem;             // posted when we are finished with a collection
+    bool started;                     // the thread has been created
+};
+
+
+/**
+ * Marks the live objects using several threads.  The
+ * interpreter is stopped for a collection, so the helper
+ * threads can read the object graph freely; all they write are
+ * the mark bits.  Each marker traces from its own stack, and a
+ * marker holding more work than it needs hands some over to a
+ * shared pool when another marker has run dry.  A marker that
+ * is out of work waits on the work semaphore until somebody
+ * shares some or the marking is finished.
+ *
+ * The mark bits are set with a plain store rather than an
+ * atomic operation.  Two markers can race on the same header,
+ * but nothing else changes a header during the mark phase, so
+ * both store the same flag value and neither update is lost.
+ * The loser of the race just sees the object as unmarked and
+ * traces it again, running its live() method twice.  Every
+ * helper reports back before markFrom() returns, so the sweep
+ * sees every mark.
+ *
+ * The collecting thread holds the resource lock for the whole
+ * mark, so the live() methods that read the activity lists
+ * don't take it themselves while a parallel mark is running.
+ *
+ * One marker is kept for the life of the process, along with
+ * its helper threads, so a collection does not pay for
+ * creating and joining threads.
+ */
+class ParallelMarker
+{
+ public:
+    enum
+    {
+        MaxMarkers = 8,               // the most threads we'll use for marking
+        ShareThreshold = 256,         // don't give away work unless we have at least this much
+        ShareCount = 128,             // number of objects handed over at a time
+    };
+
+    // the live set size (in objects) where using several threads starts to pay off
+    static const size_t ParallelMarkThreshold = 100000;
+
+    ParallelMarker();
+    ~ParallelMarker();
+
+    size_t markFrom(RexxInternalObject *root, size_t m, size_t l);
+    void   helpMark();
+
+    static inline void push(RexxInternalObject *obj) { currentStack->push(obj); }
+
+ protected:
+
+    void drain(MarkerStack &stack);
+    bool findWork(MarkerStack &stack);
+    void shareWork(MarkerStack &stack);
+
+    static thread_local MarkerStack *currentStack;  // the mark stack for the current thread
+
+    size_t   liveMark;                // the mark value passed to the live() methods
+    SysMutex poolLock;                // serializes access to the pool and the marker counts
+    SysSemaphore workSem;             // posted when work is shared or the marking is finished
+    MarkerStack pool;                 // work given up by busy markers
+    MarkerThread helpers[MaxMarkers - 1]; // the helper threads, started as needed
+    std::atomic<size_t> poolItems;    // the number of objects in the pool
+    std::atomic<size_t> participants; // the number of threads marking
+    std::atomic<size_t> idleMarkers;  // the number of threads waiting for work
+    std::atomic<bool>   finished;     // all the work is done
+    std::atomic<size_t> helperMarked; // count of objects traced by the helpers
+};
+
+#endif
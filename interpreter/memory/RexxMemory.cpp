@@ -81,6 +81,7 @@
 #include "SysProcess.hpp"
 #include <stdio.h>
 #include <stdarg.h>
+#include <thread>
 
 // restore a class from its
 // associated primitive behaviour
@@ -161,6 +162,11 @@ void MemoryObject::initialize(bool restoringImage, const char *imageTarget)
 
     collections = 0;
     allocations = 0;
+    markedObjects = 0;
+    parallelMarker = NULL;
+    markerPool = NULL;
+    // by default, use a marking thread per core for large collections (RXGCTHREADS can override)
+    setMarkingThreads(std::thread::hardware_concurrency());
     globalStrings = OREF_NULL;
 
     // get our table of virtual functions setup first thing.  We need this
@@ -229,7 +235,7 @@ void MemoryObject::logVerboseOutput(const char *message, void *sub1, void *sub2,
  * @param rootObject The root object used for the marking (usually the
  *                   MemoryObject).
  */
-void MemoryObject::markObjectsMain(RexxInternalObject *rootObject)
+void MemoryObject::markObjectsMain(RexxInternalObject *rootObject, size_t markers)
 {
     // for some of the root objects, we get called to mark them before they get allocated.
     // make sure we don't process any null references.
@@ -247,21 +253,37 @@ void MemoryObject::markObjectsMain(RexxInternalObject *rootObject)
     size_t liveMark = markWord | ObjectHeader::OldSpaceBit;
 
     allocations = 0;
-    // add a fence to the stack to act as a terminator.
-    pushLiveStack(OREF_NULL);
-    // mark the root object and start processing the stacked item.
-    // we terminate once we hit the null fence item.
-    mark(rootObject);
-    for (RexxInternalObject *markObject = popLiveStack(); markObject != OREF_NULL; markObject = popLiveStack())
+    // several threads can share the marking of a large object graph
+    if (markers > 1)
     {
-        // mark the behaviour as live
-        memory_mark(markObject->behaviour);
-        // Mark other referenced obj.  We can do this without checking
-        // the references flag because we only push the object on to
-        // the stack if it has references.
-        allocations++;
-        markObject->live(liveMark);
+        // the helper threads are kept parked between collections
+        if (markerPool == NULL)
+        {
+            markerPool = new ParallelMarker();
+        }
+        parallelMarker = markerPool;
+        allocations = markerPool->markFrom(rootObject, markers, liveMark);
+        parallelMarker = NULL;
     }
+    else
+    {
+        // add a fence to the stack to act as a terminator.
+        pushLiveStack(OREF_NULL);
+        // mark the root object and start processing the stacked item.
+        // we terminate once we hit the null fence item.
+        mark(rootObject);
+        for (RexxInternalObject *markObject = popLiveStack(); markObject != OREF_NULL; markObject = popLiveStack())
+        {
+            // mark the behaviour as live
+            memory_mark(markObject->behaviour);
+            // Mark other referenced obj.  We can do this without checking
+            // the references flag because we only push the object on to
+            // the stack if it has references.
+            allocations++;
+            markObject->live(liveMark);
+        }
+    }
+    markedObjects += allocations;
 
     // we are done marking, no longer in a critical section
     markingObjects = false;
@@ -417,8 +439,13 @@ void MemoryObject::markObjects()
 {
     verboseMessage("Beginning mark operation\n");
 
+    // if the last collection found a large live set, this one probably
+    // will too, so spread the marking over several threads.
+    size_t markers = markedObjects >= ParallelMarker::ParallelMarkThreshold ? markingThreads : 1;
+    markedObjects = 0;
+
     // do the marking using the memory object as the root object.
-    markObjectsMain(this);
+    markObjectsMain(this, markers);
     // now process the weak reference queue...We check this before the
     // uninit list is processed so that the uninit list doesn't mark any of the
     // weakly referenced items.  We don't want an object placed on the uninit queue
@@ -897,6 +924,10 @@ void MemoryObject::collect()
     verboseMessage("Begin collecting memory, cycle #%zu after %zu allocations.\n", collections, allocations);
     allocations = 0;
 
+    // the normal segments might not be completely swept from the last
+    // cycle.  That needs to be finished before the mark word changes.
+    newSpaceNormalSegments.completeSweep();
+
     // change our marker to the next value so we can distinguish
     // between objects marked on this cycle from the objects marked
     // in the pervious cycles.
@@ -907,17 +938,19 @@ void MemoryObject::collect()
     markObjects();
 
     // have each of the segment spaces sweep up the dead objects from
-    // all of their spaces.
-    newSpaceNormalSegments.sweep();
+    // all of their spaces.  The normal segments hold the bulk of the
+    // objects, so those are swept lazily as the allocator needs storage.
+    newSpaceNormalSegments.beginSweep();
     newSpaceLargeSegments.sweep();
     newSpaceSingleSegments.sweep();
 
-    // The space segments are now in a known, completely clean state.
-    // Now based on the context that caused garbage collection to be
-    // initiated, the segment sets may be expanded to add additional
+    // The large and single space segments are now in a known, completely
+    // clean state. Now based on the context that caused garbage collection
+    // to be initiated, the segment sets may be expanded to add additional
     // free memory.  The decision to expand the object space requires
     // the usage statistics collected by the mark-and-sweep
-    // operation.
+    // operation, so the normal segments make that decision once
+    // their sweep is complete.
 
     verboseMessage("End collecting memory\n");
 }
@@ -1219,13 +1252,13 @@ void MemoryObject::mark(RexxInternalObject *markObject)
             // more than once.
             markObject->behaviour->setObjectLive(markWord);
             // push the behaviour on the live stack to mark later
-            pushLiveStack(markObject->behaviour);
+            pushMarkStack(markObject->behaviour);
         }
     }
     else
     {
         // add this to the live stack so we can call the live() method late.r
-        pushLiveStack(markObject);
+        pushMarkStack(markObject);
     }
 }
 
@@ -1338,6 +1371,9 @@ void MemoryObject::saveImage(const char *imageTarget)
     imageStats = &_imageStats;     // set the pointer to the current collector
     _imageStats.clear();
 
+    // we're about to change the mark word, so finish any pending sweep
+    newSpaceNormalSegments.completeSweep();
+
     // get an array to hold all special objects.  This will be the first object
     // copied into the image buffer and allows us to recover all of the important
     // image objects at restore time.
@@ -1695,6 +1731,8 @@ void MemoryObject::dumpImageStats()
     MemoryStats _imageStats;
 
     _imageStats.clear();
+    // the stats walk all of the objects, so don't leave any unswept
+    newSpaceNormalSegments.completeSweep();
     // gather a fresh set of stats for all of the segments
     newSpaceNormalSegments.gatherStats(&_imageStats, &_imageStats.normalStats);
     newSpaceLargeSegments.gatherStats(&_imageStats, &_imageStats.largeStats);
@@ -1718,6 +1756,10 @@ void MemoryObject::shutdown()
 
     // release the livestack also, which is allocated separately.
     delete liveStack;
+
+    // and stop the parallel marking threads
+    delete markerPool;
+    markerPool = NULL;
 }
 
 
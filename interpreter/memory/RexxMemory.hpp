@@ -47,11 +47,13 @@
 
 #include "Memory.hpp"
 #include "MemoryStack.hpp"
+#include "ParallelMarker.hpp"
 #include "SysSemaphore.hpp"
 #include "IdentityTableClass.hpp"
 #include "QueueClass.hpp"
 
 #include <vector>
+#include <algorithm>
 
 // this can be enabled to switch on memory profiling info
 //#define MEMPROFILE
@@ -125,7 +127,7 @@ class MemoryObject : public RexxInternalObject
     void        unflattenProxyObjects(Envelope *envelope, RexxInternalObject *firstObject, RexxInternalObject *endObject);
 
     void        markObjects();
-    void        markObjectsMain(RexxInternalObject *);
+    void        markObjectsMain(RexxInternalObject *, size_t markers = 1);
     void        mark(RexxInternalObject *);
     void        markGeneral(void *);
     void        tracingMark(RexxInternalObject *root, MarkReason reason);
@@ -215,6 +217,9 @@ class MemoryObject : public RexxInternalObject
     inline void checkLiveStack(size_t needed) { if (!liveStack->checkRoom(needed)) liveStackFull(needed); }
     inline void pushLiveStack(RexxInternalObject *obj) { checkLiveStack(); liveStack->push(obj); }
     inline RexxInternalObject * popLiveStack() { return liveStack->pop(); }
+    inline void pushMarkStack(RexxInternalObject *obj) { if (parallelMarker != NULL) parallelMarker->push(obj); else pushLiveStack(obj); }
+    inline bool isParallelMarking() { return parallelMarker != NULL; }
+    inline void setMarkingThreads(size_t m) { markingThreads = std::max(std::min(m, (size_t)ParallelMarker::MaxMarkers), (size_t)1); }
     inline void bumpMarkWord() { markWord ^= ObjectHeader::MarkMask; }
 
     // set the live mark in an object referenced by a void pointer
@@ -303,6 +308,10 @@ private:
 
     size_t allocations;                  // number of allocations since last GC
     size_t collections;                  // number of garbage collections
+    size_t markedObjects;                // number of objects traced by the last collection
+    size_t markingThreads;               // the most threads used to mark a large live set
+    ParallelMarker *parallelMarker;      // the active parallel marker, if any
+    ParallelMarker *markerPool;          // the parallel marker and its helper threads, created on first use
 
     char *restoredImage;                 // our restored image.
     StringTable   *globalStrings;        // table of global strings
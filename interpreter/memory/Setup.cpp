@@ -1277,6 +1277,8 @@ AddMethod("maxArraySize", RexxInfo::getMaxArraySize, 0);
         AddMethod("executable", RexxInfo::getRexxExecutable, 0);
         AddMethod("libraryPath", RexxInfo::getRexxLibrary, 0);
 AddMethod("debug", RexxInfo::getDebug, 0);
+AddMethod("interpretCacheHits", RexxInfo::getInterpretCacheHits, 0);
+AddMethod("interpretCacheMisses", RexxInfo::getInterpretCacheMisses, 0);
 
 CompleteMethodDefinitions();
 
@@ -911,14 +911,15 @@ RexxInstruction* LanguageParser::assignmentNew(RexxToken  *target)
     // so far, we only know that the target is a symbol.  Verify that this
     // really is a variable symbol.  This handles raising an error if not valid.
     needVariable(target);
+    // measure the stack needed by the expression alone, see assignmentInstruction()
+    size_t outerStack = maxStack;
+    maxStack = 0;
     // everything after the "=" is the expression that is as to the variable.
     // The expression is required.
     RexxInternalObject *expr = requiredExpression(TERM_EOC, Error_Invalid_expression_assign);
 
     // build an instruction object and return it.
-    RexxInstruction *newObject = new_instruction(ASSIGNMENT, Assignment);
-    ::new((void *)newObject)RexxInstructionAssignment(addVariable(target), expr);
-    return newObject;
+    return assignmentInstruction(addVariable(target), expr, outerStack);
 }
 
 
@@ -935,6 +936,9 @@ RexxInstruction* LanguageParser::assignmentOpNew(RexxToken *target, RexxToken *o
 {
     // make sure this is a variable
     needVariable(target);
+    // measure the stack needed by the expression alone, see assignmentInstruction()
+    size_t outerStack = maxStack;
+    maxStack = 0;
     // we require an expression for the additional part, which is required
     RexxInternalObject *expr = requiredExpression(TERM_EOC, Error_Invalid_expression_assign);
 
@@ -945,8 +949,49 @@ RexxInstruction* LanguageParser::assignmentOpNew(RexxToken *target, RexxToken *o
     expr = new RexxBinaryOperator(operation->subtype(), variable, expr);
 
     // now everything is the same as an assignment operator
-    RexxInstruction *newObject = new_instruction(ASSIGNMENT, Assignment);
-    ::new((void *)newObject)RexxInstructionAssignment(variable, expr);
+    return assignmentInstruction(variable, expr, outerStack);
+}
+
+
+/**
+ * Create the instruction object for an assignment.  Assignments
+ * that append to a simple variable ("var = var || expr" and
+ * similar) get an instruction that can extend the variable's
+ * string value in place.
+ *
+ * @param variable   The assignment target.
+ * @param expr       The assignment expression.
+ * @param outerStack The maximum stack depth before the expression was
+ *                   parsed.  maxStack holds the depth of the expression.
+ *
+ * @return The constructed instruction object.
+ */
+RexxInstruction* LanguageParser::assignmentInstruction(RexxVariableBase *variable, RexxInternalObject *expr, size_t outerStack)
+{
+    // count the concatenations down the left side of the expression.  If
+    // we end up at the assignment target, this is an append.
+    size_t count = 0;
+    RexxInternalObject *term = expr;
+    while (isOfClass(BinaryOperatorTerm, term) && ((RexxBinaryOperator *)term)->isConcatenation())
+    {
+        count++;
+        term = ((RexxBinaryOperator *)term)->getLeftTerm();
+    }
+
+    if (count == 0 || term != variable || !isOfClass(VariableTerm, variable))
+    {
+        maxStack = std::max(maxStack, outerStack);
+        RexxInstruction *newObject = new_instruction(ASSIGNMENT, Assignment);
+        ::new((void *)newObject)RexxInstructionAssignment(variable, expr);
+        return newObject;
+    }
+
+    // an append keeps every converted operand on the stack until all of them
+    // are evaluated, where the expression only keeps one intermediate result
+    maxStack = std::max(maxStack + count - 1, outerStack);
+
+    RexxInstruction *newObject = new_variable_instruction(ASSIGNMENT, AppendAssignment, count, RexxBinaryOperator *);
+    ::new((void *)newObject)RexxInstructionAppendAssignment(variable, expr, count);
     return newObject;
 }
 
@@ -248,6 +248,7 @@ class LanguageParser: public RexxInternalObject
     RexxInstruction *addressNew();
     RexxInstruction *assignmentNew(RexxToken *);
     RexxInstruction *assignmentOpNew(RexxToken *, RexxToken *);
+    RexxInstruction *assignmentInstruction(RexxVariableBase *, RexxInternalObject *, size_t);
     RexxInstruction *callOnNew(InstructionSubKeyword type);
     RexxInstruction *dynamicCallNew(RexxToken *token);
     RexxInstruction *qualifiedCallNew(RexxToken *token);
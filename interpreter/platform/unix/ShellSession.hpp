@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/******************************************************************************/
+/* REXX Kernel                                                                */
+/*                                                                            */
+/* The persistent shell behind the SHSESSION command environment              */
+/*                                                                            */
+/******************************************************************************/
+#ifndef Included_ShellSession_hpp
+#define Included_ShellSession_hpp
+
+#include <sys/types.h>
+
+// The persistent shell session of an activity.  The "SHSESSION" environment
+// sends all of its commands to this shell instead of spawning a new shell
+// for each command.  Shell state like the working directory, shell variables,
+// or exported environment variables is kept from one command to the next.
+//
+// The shell reads its commands from a pipe on its stdin.  Each command is
+// sent as a single-quoted argument to eval, so the shell parses the complete
+// command text on its own and unbalanced braces, here-documents or quoting
+// errors can't break up the framing.  The command is run with the original
+// stdin of the interpreter (which the shell keeps on file descriptor 4), and
+// once it finishes the shell writes the command return code as a single line
+// to a separate status pipe on descriptor 3.  Neither descriptor is visible
+// to the command itself.
+class ShellSession
+{
+public:
+    inline ShellSession() : pid(-1), commandPipe(-1), statusPipe(-1) { }
+    inline ~ShellSession() { stop(); }
+
+    bool start();
+    void stop();
+    bool run(const char *command, int &rc);
+
+protected:
+    static int  moveDescriptor(int fd);
+    static bool createPipe(int fds[2]);
+    bool send(const char *command);
+    bool writeAll(const char *data, size_t length);
+    int  terminated();
+
+    pid_t pid;                    // the process id of the shell
+    int   commandPipe;            // our write end of the shell command pipe
+    int   statusPipe;             // our read end of the shell status pipe
+};
+
+#endif
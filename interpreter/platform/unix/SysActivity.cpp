@@ -53,6 +53,7 @@
 #include "RexxCore.h"
 #include "SysActivity.hpp"
 #include "SysThread.hpp"
+#include "ShellSession.hpp"
 
 
 /**
@@ -71,6 +72,7 @@ void *threadFnc(void *args)
  */
 void SysActivity::close()
 {
+    cleanupResources();
     threadId = 0;
 }
 
@@ -221,3 +223,30 @@ size_t SysActivity::getStackSize()
 #error no code for getStackSize()
 #endif
 }
+
+
+/**
+ * Return the shell session of an activity, creating a new (not
+ * yet started) one if needed.  The session ends when the activity
+ * finishes its current work or is terminated.
+ *
+ * @return The session object.
+ */
+ShellSession *SysActivity::getShellSession()
+{
+    if (shellSession == NULL)
+    {
+        shellSession = new ShellSession();
+    }
+    return shellSession;
+}
+
+
+/**
+ * Terminate the shell session of an activity, if there is one.
+ */
+void SysActivity::endShellSession()
+{
+    delete shellSession;
+    shellSession = NULL;
+}
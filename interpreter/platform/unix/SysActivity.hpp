@@ -60,11 +60,12 @@
 
 
 class Activity;
+class ShellSession;
 
 class SysActivity
 {
 public:
-    inline SysActivity() : valid(false) { }
+    inline SysActivity() : valid(false), shellSession(NULL) { }
     inline bool equals(thread_id_t t) { return pthread_equal(threadId, t); }
     void create(Activity *activity, size_t stackSize);
     void close();
@@ -72,6 +73,9 @@ public:
     void setPriority(int p);
     bool validateThread();
     inline thread_id_t getThreadID() { return (thread_id_t)threadId; }
+    inline void cleanupResources() { endShellSession(); }
+    ShellSession *getShellSession();
+    void endShellSession();
 
     static thread_id_t queryThreadID();
     static char* getStackBase();
@@ -80,6 +84,7 @@ public:
 protected:
     bool          valid;      // indicates whether opaque threadId is valid
     pthread_t     threadId;   // the thread identifier
+    ShellSession *shellSession; // the SHSESSION shell of this activity (NULL if none)
 };
 
 #endif
@@ -1092,6 +1092,35 @@ uint64_t SysFileSystem::getFileLength(const char *name)
 }
 
 
+/**
+ * Retrieve the information that identifies the current version
+ * of a file.
+ *
+ * @param name     The target name.
+ * @param identity The returned identity.
+ *
+ * @return true if the file exists, false otherwise.
+ */
+bool SysFileSystem::getFileIdentity(const char *name, SysFileIdentity &identity)
+{
+    struct stat64 st;
+    if (stat64(name, &st) != 0)
+    {
+        return false;
+    }
+    identity.device = st.st_dev;
+    identity.inode = st.st_ino;
+    identity.modified = (int64_t)st.st_mtime * 1000000000;
+#ifdef HAVE_STAT_ST_MTIM
+    identity.modified += st.st_mtim.tv_nsec;
+#elif defined HAVE_STAT_ST_MTIMESPEC
+    identity.modified += st.st_mtimespec.tv_nsec;
+#endif
+    identity.size = st.st_size;
+    return true;
+}
+
+
 /**
  * Create a directory in the file system.
  *
@@ -84,6 +84,26 @@
 class RexxString;
 class FileNameBuffer;
 
+/**
+ * Identifies a particular version of a file.  Used to check
+ * whether something derived from a file's contents is still
+ * current.
+ */
+class SysFileIdentity
+{
+ public:
+     inline bool operator==(const SysFileIdentity &o) const
+     {
+         return device == o.device && inode == o.inode && modified == o.modified && size == o.size;
+     }
+     inline bool operator!=(const SysFileIdentity &o) const { return !(*this == o); }
+
+     uint64_t device;       // the device holding the file
+     uint64_t inode;        // the file serial number
+     int64_t  modified;     // last modification time, in nanoseconds
+     uint64_t size;         // the file size
+};
+
 class SysFileSystem
 {
  public:
@@ -132,6 +152,7 @@ class SysFileSystem
      static bool  setLastAccessDate(const char *name, int64_t time);
 
      static uint64_t getFileLength(const char *name);
+     static bool  getFileIdentity(const char *name, SysFileIdentity &identity);
 
      static bool  makeDirectory(const char *name);
      static bool  isHidden(const char *name);
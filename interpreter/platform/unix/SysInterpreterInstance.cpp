@@ -45,6 +45,7 @@
 #include "RexxActivation.hpp"
 #include "InterpreterInstance.hpp"
 #include "SystemInterpreter.hpp"
+#include "ActivityManager.hpp"
 
 
 /**
@@ -69,6 +70,34 @@ void SysInterpreterInstance::initialize(InterpreterInstance *i, RexxOption *opti
         }
     }
 
+    // the external call cache can be turned off or told to skip file checks
+    const char *callCacheBuf = getenv("RXCALLCACHE");
+    if (callCacheBuf != NULL)
+    {
+        if (!Utilities::strCaselessCompare(callCacheBuf, "OFF"))
+        {
+            instance->externalPrograms.setMode(ExternalProgramCache::CACHE_OFF);
+        }
+        else if (!Utilities::strCaselessCompare(callCacheBuf, "TRUST"))
+        {
+            instance->externalPrograms.setMode(ExternalProgramCache::CACHE_TRUST);
+        }
+    }
+
+    // the number of idle threads kept around for reuse by START, REPLY and .Executor
+    const char *threadPoolBuf = getenv("RXTHREADPOOL");
+    if (threadPoolBuf != NULL && Utilities::isDigit(*threadPoolBuf))
+    {
+        ActivityManager::setThreadPoolSize(strtoul(threadPoolBuf, NULL, 10));
+    }
+
+    // the number of threads used to mark a large heap during garbage collection
+    const char *gcThreadsBuf = getenv("RXGCTHREADS");
+    if (gcThreadsBuf != NULL && Utilities::isDigit(*gcThreadsBuf))
+    {
+        memoryObject.setMarkingThreads(strtoul(gcThreadsBuf, NULL, 10));
+    }
+
     // add our default search extension as both upper and lower case
     addSearchExtension(".REX");
     addSearchExtension(".rex");
@@ -164,12 +164,18 @@
 #include "RexxUtilCommon.hpp"
 #include "Utilities.hpp"
 #include "RexxInternalApis.h"
+#include "SysThread.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
 
 #if defined __APPLE__
 #define open64 open
 // avoid warning: '(l)stat64' is deprecated: first deprecated in macOS 10.6
 #define stat64 stat
 #define lstat64 lstat
+#define fstatat64 fstatat
 #endif
 
 #define REXXMESSAGEFILE    "rexx.cat"
@@ -280,6 +286,9 @@ int getkey(char *ret, bool echo)
 }
 
 // below are Windows-specific implementations of TreeFinder methods.
+
+const size_t FILE_LINE_SIZE = 128;         // room for the time, size, and attributes of a file line
+
 inline char typeOfEntry(mode_t m)
 {
     if (S_ISLNK(m))
@@ -375,67 +384,64 @@ bool TreeFinder::checkNonPathDrive()
 
 /**
  * Format the system-specific file time, attribute mask, and size for
- * the given file.
+ * the given file.  This only uses the passed buffer, so it can be used
+ * by the tree walker threads.
  *
- * @param fileName The name of the file.
+ * @param finder   The finder holding the formatting options.
+ * @param fileLine The buffer for the formatted attributes.
+ * @param size     The size of the buffer.
+ * @param fileData The file information.
  */
-void formatFileAttributes(TreeFinder *finder, FileNameBuffer &foundFileLine, SysFileIterator::FileAttributes &attributes)
+void formatFileLine(TreeFinder *finder, char *fileLine, size_t size, const struct stat64 &fileData)
 {
-    char fileAttr[256];                 // File attribute string of found file
-
-#ifdef AIX
     struct tm stTimestamp;
-    struct tm *timestamp = localtime_r(&(attributes.findFileData.st_mtime), &stTimestamp);
-#else
-    struct tm *timestamp = localtime(&(attributes.findFileData.st_mtime));
-#endif
+    struct tm *timestamp = localtime_r(&(fileData.st_mtime), &stTimestamp);
 
     // tm_year is relative to 1900, with full year coverage of 0001 through 9999
+    int used;
     if (finder->longTime())
     {
-        snprintf(fileAttr, sizeof(fileAttr), "%4d-%02d-%02d %02d:%02d:%02d  ",
-                 timestamp->tm_year + 1900, timestamp->tm_mon + 1, timestamp->tm_mday,
-                 timestamp->tm_hour, timestamp->tm_min, timestamp->tm_sec);
+        used = snprintf(fileLine, size, "%4d-%02d-%02d %02d:%02d:%02d  ",
+                        timestamp->tm_year + 1900, timestamp->tm_mon + 1, timestamp->tm_mday,
+                        timestamp->tm_hour, timestamp->tm_min, timestamp->tm_sec);
     }
     else if (finder->editableTime())
     {
-        snprintf(fileAttr, sizeof(fileAttr), "%02d/%02d/%02d/%02d/%02d  ",
-                 (timestamp->tm_year + 10000) % 100, timestamp->tm_mon + 1, timestamp->tm_mday,
-                 timestamp->tm_hour, timestamp->tm_min);
+        used = snprintf(fileLine, size, "%02d/%02d/%02d/%02d/%02d  ",
+                        (timestamp->tm_year + 10000) % 100, timestamp->tm_mon + 1, timestamp->tm_mday,
+                        timestamp->tm_hour, timestamp->tm_min);
     }
     else
     {
-        snprintf(fileAttr, sizeof(fileAttr), "%2d/%02d/%02d  %2d:%02d%c  ",
-                 timestamp->tm_mon + 1, timestamp->tm_mday, (timestamp->tm_year  + 10000) % 100,
-                 timestamp->tm_hour < 13 && timestamp->tm_hour != 0 ?
-                  timestamp->tm_hour : abs(timestamp->tm_hour - 12),
-                 timestamp->tm_min, (timestamp->tm_hour < 12 || timestamp->tm_hour == 24) ? 'a' : 'p');
+        used = snprintf(fileLine, size, "%2d/%02d/%02d  %2d:%02d%c  ",
+                        timestamp->tm_mon + 1, timestamp->tm_mday, (timestamp->tm_year  + 10000) % 100,
+                        timestamp->tm_hour < 13 && timestamp->tm_hour != 0 ?
+                         timestamp->tm_hour : abs(timestamp->tm_hour - 12),
+                        timestamp->tm_min, (timestamp->tm_hour < 12 || timestamp->tm_hour == 24) ? 'a' : 'p');
     }
+    fileLine += used;
+    size -= used;
 
-    // this is the first part of the return value. Copy to the result buffer so we can
-    // reuse the buffer
-    foundFileLine = fileAttr;
-
-    // now the size information
+    // now the size information, the order is time, size, attributes
     if (finder->longSize())
     {
-        snprintf(fileAttr, sizeof(fileAttr), "%20jd  ", (intmax_t)attributes.findFileData.st_size);
+        used = snprintf(fileLine, size, "%20jd  ", (intmax_t)fileData.st_size);
     }
     else
     {
-        if (attributes.findFileData.st_size > 9999999999)
+        intmax_t fileSize = (intmax_t)fileData.st_size;
+        if (fileSize > 9999999999)
         {
-            attributes.findFileData.st_size = 9999999999;
+            fileSize = 9999999999;
         }
-        snprintf(fileAttr, sizeof(fileAttr), "%10jd  ", (intmax_t)attributes.findFileData.st_size);
+        used = snprintf(fileLine, size, "%10jd  ", fileSize);
     }
+    fileLine += used;
+    size -= used;
 
-    // the order is time, size, attributes
-    foundFileLine += fileAttr;
-
-    char tp = typeOfEntry(attributes.findFileData.st_mode);
+    char tp = typeOfEntry(fileData.st_mode);
 
-    mode_t st_mode = attributes.findFileData.st_mode;
+    mode_t st_mode = fileData.st_mode;
 
     // SUID       If set, then replaces "x" in the owner permissions to "s",
     // if owner has execute permissions, or to "S" otherwise. Examples:
@@ -451,7 +457,7 @@ void formatFileAttributes(TreeFinder *finder, FileNameBuffer &foundFileLine, Sys
     // if others have execute permissions, or to "T" otherwise. Examples:
     // -rwxrwxrwt both others execute and sticky bit are set
     // -rwxrwxr-T sticky bit is set, but others execute is not set
-    snprintf(fileAttr, sizeof(fileAttr), "%c%c%c%c%c%c%c%c%c%c  ",
+    snprintf(fileLine, size, "%c%c%c%c%c%c%c%c%c%c  ",
              tp,
              (S_IRUSR & st_mode) ? 'r' : '-',
              (S_IWUSR & st_mode) ? 'w' : '-',
@@ -462,9 +468,21 @@ void formatFileAttributes(TreeFinder *finder, FileNameBuffer &foundFileLine, Sys
              (S_IROTH & st_mode) ? 'r' : '-',
              (S_IWOTH & st_mode) ? 'w' : '-',
              (S_ISVTX & st_mode) ? (S_IXOTH & st_mode ? 't' : 'T') : (S_IXOTH & st_mode ? 'x' : '-'));
+}
+
+
+/**
+ * Format the system-specific file time, attribute mask, and size for
+ * the given file.
+ *
+ * @param fileName The name of the file.
+ */
+void formatFileAttributes(TreeFinder *finder, FileNameBuffer &foundFileLine, SysFileIterator::FileAttributes &attributes)
+{
+    char fileAttr[FILE_LINE_SIZE];      // File attribute string of found file
 
-    // add on this section
-    foundFileLine += fileAttr;
+    formatFileLine(finder, fileAttr, sizeof(fileAttr), attributes.findFileData);
+    foundFileLine = fileAttr;
 }
 
 
@@ -514,6 +532,413 @@ void TreeFinder::checkFile(SysFileIterator::FileAttributes &attributes)
 }
 
 
+/**
+ * The results of searching a single directory of a SysFileTree
+ * walk.  The located subdirectories are kept in the order the
+ * directory returned them, so the tree can be flattened into the
+ * same order a recursive search would produce.
+ */
+class TreeWalkDirectory
+{
+ public:
+     TreeWalkDirectory(const std::string &p) : path(p) { }
+     ~TreeWalkDirectory()
+     {
+         for (size_t i = 0; i < subdirectories.size(); i++)
+         {
+             delete subdirectories[i];
+         }
+     }
+
+     std::string path;                                // the directory path, including the final delimiter
+     std::string results;                             // the result lines, each one null terminated
+     std::vector<TreeWalkDirectory *> subdirectories; // the subdirectories to search, in directory order
+};
+
+
+/**
+ * Walks a directory tree for SysFileTree.  The directories waiting
+ * to be searched are shared by a small set of threads, with each
+ * searched directory adding its subdirectories to the queue.  None
+ * of the threads touch any interpreter objects, the results are
+ * kept in the TreeWalkDirectory objects until the walk completes.
+ */
+class TreeWalker
+{
+ public:
+     enum
+     {
+         MAX_WALKER_THREADS = 8      // the maximum number of threads searching, including the caller
+     };
+
+     TreeWalker(TreeFinder *f, const char *pattern);
+     ~TreeWalker();
+
+     void walk(TreeWalkDirectory *root);
+     void work();
+     bool outOfMemory() { return failed; }
+
+ protected:
+     void searchDirectory(TreeWalkDirectory *directory);
+     bool matchName(const char *name, bool caseLess);
+     TreeWalkDirectory *nextDirectory();
+     void directoryDone(TreeWalkDirectory *directory);
+
+     TreeFinder     *finder;           // the finder with the search options
+     const char     *patternSpec;      // the pattern file names are matched against
+#ifndef HAVE_FNM_CASEFOLD
+     const char     *upperPattern;     // the uppercased pattern for caseless matches
+#endif
+     pthread_mutex_t queueLock;        // protects the work queue
+     pthread_cond_t  queueChanged;     // signalled when work is added or the walk completes
+     std::deque<TreeWalkDirectory *> pending; // directories waiting to be searched
+     size_t          active;           // the number of directories currently being searched
+     bool            failed;           // a memory allocation failed during the walk
+};
+
+
+/**
+ * A helper thread for a tree walk.
+ */
+class TreeWalkerThread : public SysThread
+{
+ public:
+     inline TreeWalkerThread() : SysThread(), walker(NULL) { }
+     inline ~TreeWalkerThread() { terminate(); }
+
+     void start(TreeWalker *w)
+     {
+         walker = w;
+         SysThread::createThread();
+     }
+
+     virtual void dispatch()
+     {
+         walker->work();
+     }
+
+     TreeWalker *walker;          // the walker we're working for
+};
+
+
+/**
+ * Create a walker for a file search.
+ *
+ * @param f       The tree finder with the search options.
+ * @param pattern The file name pattern to match.
+ */
+TreeWalker::TreeWalker(TreeFinder *f, const char *pattern) : finder(f), active(0), failed(false)
+{
+    patternSpec = pattern;
+#ifndef HAVE_FNM_CASEFOLD
+    // without FNM_CASEFOLD, caseless searches need an uppercase copy of
+    // the pattern. We can't tell in advance if any directory will be caseless.
+    char *upperString = strdup(patternSpec);
+    Utilities::strupper(upperString);
+    upperPattern = upperString;
+#endif
+    pthread_mutex_init(&queueLock, NULL);
+    pthread_cond_init(&queueChanged, NULL);
+    // localtime_r() is not required to pick up the time zone itself
+    tzset();
+}
+
+
+/**
+ * Release the walker resources.
+ */
+TreeWalker::~TreeWalker()
+{
+    pthread_cond_destroy(&queueChanged);
+    pthread_mutex_destroy(&queueLock);
+#ifndef HAVE_FNM_CASEFOLD
+    free((void *)upperPattern);
+#endif
+}
+
+
+/**
+ * Search a complete directory tree.  The root directory is searched
+ * on the calling thread, helper threads are only started if there
+ * are subdirectories to be searched.  A root with few
+ * subdirectories can still lead to a wide tree below them, so the
+ * helper count does not depend on the root.  Helpers wait on the
+ * queue until work shows up or the walk is complete.
+ *
+ * @param root   The directory the search starts in.
+ */
+void TreeWalker::walk(TreeWalkDirectory *root)
+{
+    active = 1;
+    searchDirectory(root);
+    directoryDone(root);
+
+    size_t helpers = pending.empty() ? 0 : (size_t)MAX_WALKER_THREADS - 1;
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors > 0)
+    {
+        helpers = std::min(helpers, (size_t)processors - 1);
+    }
+
+    TreeWalkerThread threads[MAX_WALKER_THREADS - 1];
+    for (size_t i = 0; i < helpers; i++)
+    {
+        threads[i].start(this);
+    }
+
+    // the calling thread takes its share of the work too
+    work();
+
+    for (size_t i = 0; i < helpers; i++)
+    {
+        threads[i].waitForTermination();
+    }
+}
+
+
+/**
+ * Search directories from the queue until the walk is complete.
+ */
+void TreeWalker::work()
+{
+    TreeWalkDirectory *directory;
+    while ((directory = nextDirectory()) != NULL)
+    {
+        try
+        {
+            searchDirectory(directory);
+        }
+        catch (std::bad_alloc &)
+        {
+            // we can't raise an error on this thread. This gets reported
+            // once the walk has finished.
+            failed = true;
+        }
+        directoryDone(directory);
+    }
+}
+
+
+/**
+ * Take the next directory from the work queue, waiting if other
+ * threads might still add to it.
+ *
+ * @return The next directory to search or NULL if the walk is complete.
+ */
+TreeWalkDirectory *TreeWalker::nextDirectory()
+{
+    pthread_mutex_lock(&queueLock);
+    // directories being searched might add more work to the queue
+    while (pending.empty() && active > 0)
+    {
+        pthread_cond_wait(&queueChanged, &queueLock);
+    }
+
+    TreeWalkDirectory *directory = NULL;
+    // once we fail, all of the remaining work is discarded
+    if (!pending.empty() && !failed)
+    {
+        directory = pending.front();
+        pending.pop_front();
+        active++;
+    }
+    pthread_mutex_unlock(&queueLock);
+    return directory;
+}
+
+
+/**
+ * Add the subdirectories of a searched directory to the work queue.
+ *
+ * @param directory The directory that was searched.
+ */
+void TreeWalker::directoryDone(TreeWalkDirectory *directory)
+{
+    pthread_mutex_lock(&queueLock);
+    if (!failed)
+    {
+        try
+        {
+            pending.insert(pending.end(), directory->subdirectories.begin(), directory->subdirectories.end());
+        }
+        catch (std::bad_alloc &)
+        {
+            failed = true;
+        }
+    }
+    active--;
+    // wake up the waiters if there is new work or if this was the last directory
+    if (!directory->subdirectories.empty() || active == 0 || failed)
+    {
+        pthread_cond_broadcast(&queueChanged);
+    }
+    pthread_mutex_unlock(&queueLock);
+}
+
+
+/**
+ * Test a file name against the search pattern.
+ *
+ * @param name     The name to test.
+ * @param caseLess Indicates a caseless comparison.
+ *
+ * @return true if the name matches.
+ */
+bool TreeWalker::matchName(const char *name, bool caseLess)
+{
+    int flags = FNM_NOESCAPE | FNM_PATHNAME;
+    if (!caseLess)
+    {
+        return fnmatch(patternSpec, name, flags) == 0;
+    }
+#ifdef HAVE_FNM_CASEFOLD
+    return fnmatch(patternSpec, name, flags | FNM_CASEFOLD) == 0;
+#else
+    std::string upperName(name);
+    Utilities::strupper(&upperName[0]);
+    return fnmatch(upperPattern, upperName.c_str(), flags) == 0;
+#endif
+}
+
+
+/**
+ * Search a single directory.  Matching entries are formatted into the
+ * directory results and, for a recursive search, the subdirectories
+ * are recorded.  The directory is read only once, and d_type saves
+ * the stat call for every entry we would only need the type of.
+ * The remaining stats are made relative to the open directory.
+ *
+ * @param directory The directory to search.
+ */
+void TreeWalker::searchDirectory(TreeWalkDirectory *directory)
+{
+    DIR *handle = opendir(directory->path.c_str());
+    // if didn't open, this either doesn't exist or isn't a directory
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    int handleFd = dirfd(handle);
+    // caseLess can be explicit or implicit, based on the characteristics of the path.
+    bool caseLess = finder->caseless() || !SysFileSystem::isCaseSensitive(directory->path.c_str());
+    bool recurse = finder->recurse();
+    bool nameOnly = finder->nameOnly();
+    char fileLine[FILE_LINE_SIZE];
+
+    struct dirent *entry;
+    while ((entry = readdir(handle)) != NULL)
+    {
+        const char *name = entry->d_name;
+        // we skip the dot directories. We're already searching the first, and
+        // the second would send us backwards
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+        {
+            continue;
+        }
+
+        bool matched = matchName(name, caseLess);
+        if (!matched && !recurse)
+        {
+            continue;
+        }
+
+        struct stat64 fileData;
+        bool haveData = false;
+        // symbolic links need a stat to find out what they point to
+        if ((matched && !nameOnly) || entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK)
+        {
+            // a dangling link is reported as the link itself
+            if (fstatat64(handleFd, name, &fileData, 0) != 0 &&
+                fstatat64(handleFd, name, &fileData, AT_SYMLINK_NOFOLLOW) != 0)
+            {
+                continue;
+            }
+            haveData = true;
+        }
+        bool isDirectory = haveData ? S_ISDIR(fileData.st_mode) : entry->d_type == DT_DIR;
+
+        if (matched && (isDirectory ? finder->includeDirs() : finder->includeFiles()))
+        {
+            if (!nameOnly)
+            {
+                formatFileLine(finder, fileLine, sizeof(fileLine), fileData);
+                directory->results += fileLine;
+            }
+            directory->results += directory->path;
+            directory->results += name;
+            directory->results += '\0';
+        }
+
+        if (recurse && isDirectory)
+        {
+            std::string subdirectory(directory->path);
+            subdirectory += name;
+            subdirectory += '/';
+            directory->subdirectories.push_back(new TreeWalkDirectory(subdirectory));
+        }
+    }
+    closedir(handle);
+}
+
+
+/**
+ * Add the results of a completed tree walk to the result stem,
+ * parent directory results before those of its subdirectories.
+ *
+ * @param stemArray The handler for the result stem.
+ * @param directory The directory to add.
+ */
+void addTreeResults(StemHandler &stemArray, TreeWalkDirectory *directory)
+{
+    // the results are a list of null-terminated strings, and the string
+    // terminator gives us the final null.
+    stemArray.addList(directory->results.c_str());
+    // we no longer need this, so release the storage now.
+    std::string().swap(directory->results);
+
+    for (size_t i = 0; i < directory->subdirectories.size(); i++)
+    {
+        addTreeResults(stemArray, directory->subdirectories[i]);
+    }
+}
+
+
+/**
+ * Platform-specific TreeFinder method for walking the directory
+ * tree, starting with the resolved file path.  The walk itself runs
+ * without using any interpreter services, the results get added to
+ * the stem once the walk has completed.
+ */
+void TreeFinder::searchTree()
+{
+    bool outOfMemory = false;
+    {
+        TreeWalkDirectory root((const char *)filePath);
+        try
+        {
+            TreeWalker walker(this, nameSpec);
+            walker.walk(&root);
+            outOfMemory = walker.outOfMemory();
+            if (!outOfMemory)
+            {
+                addTreeResults(stemArray, &root);
+            }
+        }
+        catch (std::bad_alloc &)
+        {
+            outOfMemory = true;
+        }
+    }
+
+    // we raise this once all of the walk storage has been released
+    if (outOfMemory)
+    {
+        context->ThrowException0(Rexx_Error_System_resources);
+    }
+}
+
+
 /**
  * Platform-specific TreeFinder method for locating the end of the
  * fileSpec directory
@@ -42,12 +42,20 @@
 /*                                                                            */
 /******************************************************************************/
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <string.h>
 #include <sys/wait.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
 
 #include "RexxCore.h"
 #include "StringClass.hpp"
@@ -56,7 +64,7 @@
 #include "SystemInterpreter.hpp"
 #include "InterpreterInstance.hpp"
 #include "SysInterpreterInstance.hpp"
-#include "SysThread.hpp"
+#include "ShellSession.hpp"
 
 #include "RexxInternalApis.h"
 #include <sys/types.h>
@@ -77,114 +85,165 @@
 
 extern int putflag;
 
-// a thread that writes INPUT data to the command pipe
-class InputWriterThread : public SysThread
-{
+// the size of our chunks when reading OUTPUT and ERROR data from the command
+// pipes.  According to POSIX.1 PIPE_BUF is at least 512 bytes; on Linux it's
+// 4096 bytes.  We read several of those at once to reduce the number of calls.
+#define PIPE_READ_SIZE (PIPE_BUF * 4)
 
-public:
-    inline InputWriterThread() : SysThread(),
-        pipe(0), inputBuffer(NULL), bufferLength(0), error(0) { }
-    inline ~InputWriterThread() { terminate(); }
+// the pipes of a redirected command, indexed by INPUT_PIPE, OUTPUT_PIPE and
+// ERROR_PIPE.  A value of -1 means the pipe is not used (or already closed).
+enum { INPUT_PIPE = 0, OUTPUT_PIPE = 1, ERROR_PIPE = 2, PIPE_COUNT = 3 };
 
-    void start(int _pipe)
-    {
-        pipe = _pipe;
-        SysThread::createThread();
-    }
 
-    virtual void dispatch()
+/**
+ * Close one of the command pipes and mark it as no longer used.
+ *
+ * @param pipes  The array of command pipes.
+ * @param which  The index of the pipe to close.
+ */
+static void closeCommandPipe(int *pipes, int which)
+{
+    if (pipes[which] != -1)
     {
-
-        if (inputBuffer != NULL && bufferLength > 0)
-        {
-            if (write(pipe, inputBuffer, bufferLength) < 0)
-            {
-                // We may receive EPIPE, which we only expect if a spawned
-                // command finishes while we're still busy trying to pipe
-                // our input.  The command may simply not need (i. e. want
-                // to read) our input.  We dont' consider this an error.
-                if (errno != EPIPE)
-                {
-                    error = errno;
-                }
-            }
-            close(pipe);
-        }
+        close(pipes[which]);
+        pipes[which] = -1;
     }
-
-    int         pipe;             // the pipe we read the data from
-    const char *inputBuffer;      // the buffer of data to write
-    size_t      bufferLength;     // the length of the read data
-    int         error;            // and error that resulted.
-};
+}
 
 
-// a thread that reads ERROR data from the command pipe
-class ErrorReaderThread : public SysThread
+/**
+ * Transfer all INPUT, OUTPUT and ERROR data between us and a
+ * redirected command.  Rather than running separate threads for
+ * the INPUT and ERROR pipes, a single poll() loop services all of
+ * the pipes on the calling thread.  OUTPUT and ERROR data is
+ * handed to the redirection targets as soon as it arrives, so
+ * the command output is never accumulated in memory.
+ *
+ * @param ioContext The IO Redirector context.
+ * @param pipes     Our ends of the INPUT, OUTPUT, and ERROR pipes.  All of
+ *                  these will be closed on return.
+ *
+ * @return 0 if successful, otherwise the errno value of the failing call.
+ */
+static int transferCommandData(RexxIORedirectorContext *ioContext, int *pipes)
 {
+    const char *inputBuffer = NULL;
+    size_t inputLength = 0;
+    int result = 0;
 
-public:
-    inline ErrorReaderThread() : SysThread(),
-        pipe(0), errorBuffer(NULL), bufferLength(0), error(0) { }
-    inline ~ErrorReaderThread()
+    if (pipes[INPUT_PIPE] != -1)
     {
-        if (errorBuffer != NULL)
+        ioContext->ReadInputBuffer(&inputBuffer, &inputLength);
+        // if we have nothing to write, the command gets an immediate EOF
+        if (inputBuffer == NULL || inputLength == 0)
         {
-            free(errorBuffer);
+            closeCommandPipe(pipes, INPUT_PIPE);
+        }
+        // we must never block on a full INPUT pipe, as the command might be
+        // waiting for us to drain its OUTPUT or ERROR pipe at the same time
+        else if (fcntl(pipes[INPUT_PIPE], F_SETFL, fcntl(pipes[INPUT_PIPE], F_GETFL) | O_NONBLOCK) != 0)
+        {
+            result = errno;
         }
-        terminate();
     }
 
-    void start(int _pipe)
-    {
-        pipe = _pipe;
-        SysThread::createThread();
-    }
+    char readBuffer[PIPE_READ_SIZE];
 
-    virtual void dispatch()
+    while (result == 0 && (pipes[INPUT_PIPE] != -1 || pipes[OUTPUT_PIPE] != -1 || pipes[ERROR_PIPE] != -1))
     {
-        bufferLength = 0;
-        size_t bufferAllocation = PIPE_BUF;
+        struct pollfd fds[PIPE_COUNT];
+        int which[PIPE_COUNT];
+        nfds_t count = 0;
 
-        // allocate the initial buffer
-        if ((errorBuffer = (char *)malloc(PIPE_BUF)) == NULL)
+        for (int i = 0; i < PIPE_COUNT; i++)
         {
-            error = errno;
-            return;
+            if (pipes[i] != -1)
+            {
+                fds[count].fd = pipes[i];
+                fds[count].events = i == INPUT_PIPE ? POLLOUT : POLLIN;
+                fds[count].revents = 0;
+                which[count] = i;
+                count++;
+            }
         }
-        ssize_t length;
 
-        // Read until we hit EOF or an error.  Whenever the buffer gets too
-        // small, we reallocate it with twice the size.
-        while ((length = read(pipe, &errorBuffer[bufferLength], bufferAllocation - bufferLength)) > 0)
+        if (poll(fds, count, -1) < 0)
         {
-            bufferLength += length;
-            // do we need to increase our buffer allocation?
-            if (bufferLength >= bufferAllocation)
+            if (errno != EINTR)
             {
-                bufferAllocation += PIPE_BUF;  // add another increment
-                char *largerBuffer = (char *)realloc(errorBuffer, bufferAllocation);
-                if (largerBuffer == NULL)
-                {
-                    error = errno;
-                    return;
-                }
-                errorBuffer = largerBuffer;
+                result = errno;
             }
+            continue;
         }
-        if (length < 0) // error reading pipe
+
+        for (nfds_t i = 0; i < count && result == 0; i++)
         {
-            error = errno;
-            return;
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+
+            if (which[i] == INPUT_PIPE)
+            {
+                ssize_t written = write(pipes[INPUT_PIPE], inputBuffer, inputLength);
+                if (written >= 0)
+                {
+                    inputBuffer += written;
+                    inputLength -= written;
+                    // all done, signal EOF to the command
+                    if (inputLength == 0)
+                    {
+                        closeCommandPipe(pipes, INPUT_PIPE);
+                    }
+                }
+                // We may receive EPIPE, which we only expect if a spawned
+                // command finishes while we're still busy trying to pipe
+                // our input.  The command may simply not need (i. e. want
+                // to read) our input.  We dont' consider this an error.
+                else if (errno == EPIPE)
+                {
+                    closeCommandPipe(pipes, INPUT_PIPE);
+                }
+                else if (errno != EAGAIN && errno != EINTR)
+                {
+                    result = errno;
+                }
+            }
+            else
+            {
+                ssize_t length = read(pipes[which[i]], readBuffer, sizeof(readBuffer));
+                if (length > 0)
+                {
+                    // if we have stdout and stderr interleaved, both of them
+                    // arrive through the OUTPUT pipe
+                    if (which[i] == OUTPUT_PIPE)
+                    {
+                        ioContext->WriteOutputBuffer(readBuffer, length);
+                    }
+                    else
+                    {
+                        ioContext->WriteErrorBuffer(readBuffer, length);
+                    }
+                }
+                else if (length == 0) // EOF, the command closed its end
+                {
+                    closeCommandPipe(pipes, which[i]);
+                }
+                else if (errno != EAGAIN && errno != EINTR)
+                {
+                    result = errno;
+                }
+            }
         }
-        close(pipe);
     }
 
-    int    pipe;                  // the pipe we read the data from
-    char  *errorBuffer;           // dynamically allocated once we start reading
-    size_t bufferLength;          // the length of the read data
-    int    error;                 // and error that resulted.
-};
+    // after a failure some pipes may still be open
+    for (int i = 0; i < PIPE_COUNT; i++)
+    {
+        closeCommandPipe(pipes, i);
+    }
+    return result;
+}
 
 
 /**
@@ -788,7 +847,7 @@ RexxObjectPtr ErrorRedirection(RexxExitContext *context, int errCode)
 {
     // raise 98.923 Address command redirection failed
     context->RaiseException1(Error_Execution_address_redirection_failed,
-      context->CString(strerror(errno)));
+      context->CString(strerror(errCode)));
     return NULLOBJECT;
 }
 
@@ -806,6 +865,33 @@ RexxObjectPtr ErrorFailure(RexxExitContext *context, CSTRING commandString)
 }
 
 
+/**
+ * Convert a command return code into the command handler
+ * result, raising an ERROR or FAILURE condition as needed.
+ *
+ * @param context    The Exit context.
+ * @param command    The command name and arguments.
+ * @param rc         The command return code.
+ */
+RexxObjectPtr CommandResult(RexxExitContext *context, CSTRING commandString, int rc)
+{
+    // unknown command code?
+    // a FAILURE will be raised for any command returning 127
+    if (rc == UNKNOWN_COMMAND)
+    {
+        return ErrorFailure(context, commandString);
+    }
+    else if (rc != 0)
+    {
+        // for any non-zero return code we raise an ERROR condition
+        context->RaiseCondition("ERROR", context->String(commandString),
+          NULL, context->WholeNumberToObject(rc));
+        return NULLOBJECT;
+    }
+    return context->False(); // zero return code
+}
+
+
 /**
  * A redirecting test command handler.
  *
@@ -868,11 +954,8 @@ RexxObjectPtr RexxEntry ioCommandHandler(RexxExitContext *context, RexxStringObj
 
     if (ioContext->IsRedirectionRequested())
     {
-        InputWriterThread inputThread; // separate thread if we need to write INPUT
-        ErrorReaderThread errorThread; // separate thread if we need to read ERROR
-        bool need_to_write_input = false;
-        bool need_to_read_output = false;
-        bool need_to_read_error = false;
+        // our ends of the stdin, stdout, and stderr pipes
+        int pipes[PIPE_COUNT] = { -1, -1, -1 };
         int input[2], output[2], error[2];
 
         posix_spawn_file_actions_t action;
@@ -896,7 +979,7 @@ RexxObjectPtr RexxEntry ioCommandHandler(RexxExitContext *context, RexxStringObj
             }
             posix_spawn_file_actions_adddup2(&action, input[0], 0); // stdin reads from pipe
             posix_spawn_file_actions_addclose(&action, input[1]); // close unused write end in child
-            need_to_write_input = true;
+            pipes[INPUT_PIPE] = input[1];
         }
 
         // is stdout redirection requested?
@@ -914,7 +997,7 @@ RexxObjectPtr RexxEntry ioCommandHandler(RexxExitContext *context, RexxStringObj
             }
             posix_spawn_file_actions_adddup2(&action, output[1], 1); //stdout writes to pipe
             posix_spawn_file_actions_addclose(&action, output[0]); // close unused read end in child
-            need_to_read_output = true;
+            pipes[OUTPUT_PIPE] = output[0];
         }
 
         // now stderr redirection
@@ -928,90 +1011,45 @@ RexxObjectPtr RexxEntry ioCommandHandler(RexxExitContext *context, RexxStringObj
             }
             posix_spawn_file_actions_adddup2(&action, error[1], 2); // stderr writes to pipe
             posix_spawn_file_actions_addclose(&action, error[0]); // close unused read end in child
-            need_to_read_error = true;
+            pipes[ERROR_PIPE] = error[0];
         }
 
         // ok, everything is set up accordingly, let's fork the redirected command
-        if (posix_spawnp(&pid, argv[0], &action, NULL, argv, getEnvironment()) != 0)
-            {
-                return ErrorFailure(context, commandString);
-            }
+        int spawnResult = posix_spawnp(&pid, argv[0], &action, NULL, argv, getEnvironment());
+        posix_spawn_file_actions_destroy(&action);
 
         // Close all unneeded read- and write ends
-        if (need_to_write_input)
+        if (pipes[INPUT_PIPE] != -1)
         {
-            close(input[0]); // we close our unused stdout pipe write end
+            close(input[0]); // we close our unused stdin pipe read end
         }
-        if (need_to_read_output)
+        if (pipes[OUTPUT_PIPE] != -1)
         {
             close(output[1]); // we close our unused stdout pipe write end
         }
-        if (need_to_read_error)
+        if (pipes[ERROR_PIPE] != -1)
         {
             close(error[1]); // we close our unused stderr pipe write end
         }
 
-        if (need_to_write_input)
-        {
-            ioContext->ReadInputBuffer(&inputThread.inputBuffer, &inputThread.bufferLength);
-            // we start a separate thread to write INPUT data to the input pipe
-            inputThread.start(input[1]);
-        }
-        if (need_to_read_error)
-        {
-            // we start a separate thread to read ERROR data from the error pipe
-            errorThread.start(error[0]);
-        }
-
-        // do we need to read OUTPUT from the stdout pipe?
-        // we run this in the main thread instead of starting another new thread
-        // if we have stdout and sterr interleaved, we'll read both of them here
-        if (need_to_read_output)
-        {
-            // According to POSIX.1 PIPE_BUF is at least 512 bytes; on Linux
-            // it's 4096 bytes.
-            char outputBuffer[PIPE_BUF];
-            ssize_t outputLength;
-
-            while ((outputLength = read(output[0], &outputBuffer, PIPE_BUF)) > 0)
-            {
-                ioContext->WriteOutputBuffer(outputBuffer, outputLength);
-            }
-            if (outputLength != 0) // 0 is EOF, success
-            {
-                return ErrorRedirection(context, errno);
-            }
-            close(output[0]);
-        }
-
-        // did we start an ERROR thrad?
-        if (need_to_read_error)
+        if (spawnResult != 0)
         {
-            // wait for the ERROR thread to finish
-            errorThread.waitForTermination();
-            if (errorThread.bufferLength > 0)
-            {   // return what the ERROR thread read from its pipe
-                ioContext->WriteErrorBuffer(errorThread.errorBuffer, errorThread.bufferLength);
-            }
-            // the ERROR thread may have encountered an error .. raise it now
-            if (errorThread.error != 0)
+            for (int i = 0; i < PIPE_COUNT; i++)
             {
-                return ErrorRedirection(context, errorThread.error);
+                closeCommandPipe(pipes, i);
             }
+            return ErrorFailure(context, commandString);
         }
 
-        // if we started an INPUT thread, wait until it finishes
-        if (need_to_write_input)
+        // now feed INPUT and collect OUTPUT and ERROR until the command
+        // has closed all of its pipes
+        int transferError = transferCommandData(ioContext, pipes);
+        if (transferError != 0)
         {
-            inputThread.waitForTermination();
-            // the INPUT thread may have encountered an error .. raise it now
-            if (inputThread.error != 0)
-            {
-                return ErrorRedirection(context, inputThread.error);
-            }
+            // don't leave a zombie behind
+            waitpid(pid, &status, 0);
+            return ErrorRedirection(context, transferError);
         }
-
-        posix_spawn_file_actions_destroy(&action);
     }
     else // no redirection requested
     {
@@ -1047,20 +1085,321 @@ RexxObjectPtr RexxEntry ioCommandHandler(RexxExitContext *context, RexxStringObj
         }
     }
 
-    // unknown command code?
-    // a FAILURE will be raised for any command returning 127
-    if (rc == UNKNOWN_COMMAND)
+    return CommandResult(context, commandString, rc);
+}
+
+
+/**
+ * Move a pipe descriptor out of the range of the descriptors
+ * we set up for the shell and mark it close-on-exec, so neither
+ * the shell nor any other spawned command inherits it.
+ *
+ * @param fd     The descriptor to move.
+ *
+ * @return The new descriptor, or -1 on failure.
+ */
+int ShellSession::moveDescriptor(int fd)
+{
+    int newFd = fcntl(fd, F_DUPFD_CLOEXEC, 10);
+    close(fd);
+    return newFd;
+}
+
+
+/**
+ * Create a pipe whose descriptors are close-on-exec and out of
+ * the range we set up for the shell.  Where pipe2() exists the
+ * descriptors are never inheritable, so a command another thread
+ * spawns at the same time can't pick up a copy and keep the pipe
+ * open.
+ *
+ * @param fds    The returned read and write descriptors.
+ *
+ * @return true if the pipe was created.
+ */
+bool ShellSession::createPipe(int fds[2])
+{
+#ifdef HAVE_PIPE2
+    if (pipe2(fds, O_CLOEXEC) != 0)
+#else
+    if (pipe(fds) != 0)
+#endif
     {
-        return ErrorFailure(context, commandString);
+        return false;
     }
-    else if (rc != 0)
+
+    fds[0] = moveDescriptor(fds[0]);
+    fds[1] = moveDescriptor(fds[1]);
+    if (fds[0] == -1 || fds[1] == -1)
     {
-        // for any non-zero return code we raise an ERROR condition
-        context->RaiseCondition("ERROR", context->String(commandString),
-          NULL, context->WholeNumberToObject(rc));
-        return NULLOBJECT;
+        if (fds[0] != -1)
+        {
+            close(fds[0]);
+        }
+        if (fds[1] != -1)
+        {
+            close(fds[1]);
+        }
+        return false;
     }
-    return context->False(); // zero return code
+    return true;
+}
+
+
+/**
+ * Start the shell co-process.
+ *
+ * @return true if the shell was successfully started.
+ */
+bool ShellSession::start()
+{
+    int commands[2], status[2];
+
+    if (!createPipe(commands))
+    {
+        return false;
+    }
+    if (!createPipe(status))
+    {
+        close(commands[0]);
+        close(commands[1]);
+        return false;
+    }
+
+    posix_spawn_file_actions_t action;
+    posix_spawn_file_actions_init(&action);
+    posix_spawn_file_actions_adddup2(&action, 0, 4);            // keep the original stdin
+    posix_spawn_file_actions_adddup2(&action, commands[0], 0);  // read commands from the pipe
+    posix_spawn_file_actions_adddup2(&action, status[1], 3);    // and write return codes here
+
+    char shell[128 + 1 + 2 + 1];
+    strcpy(shell, SYSSHELLPATH);
+    if (shell[strlen(shell) - 1] != '/')
+    {   // append slash if we don't have one yet
+        strcat(shell, "/");
+    }
+    strcat(shell, "sh");
+    char *argv[] = { shell, NULL };
+
+    int spawnResult = posix_spawn(&pid, shell, &action, NULL, argv, getEnvironment());
+    posix_spawn_file_actions_destroy(&action);
+
+    // the child ends are no longer needed here
+    close(commands[0]);
+    close(status[1]);
+
+    if (spawnResult != 0)
+    {
+        pid = -1;
+        close(commands[1]);
+        close(status[0]);
+        return false;
+    }
+    commandPipe = commands[1];
+    statusPipe = status[0];
+    return true;
+}
+
+
+/**
+ * Shut down the shell co-process.  Closing the command pipe
+ * gives the shell an end-of-file, which makes it exit.
+ */
+void ShellSession::stop()
+{
+    if (pid != -1)
+    {
+        terminated();
+    }
+}
+
+
+/**
+ * Close our pipe ends and collect the exit status of the shell.
+ *
+ * @return The shell exit status, as a command return code.
+ */
+int ShellSession::terminated()
+{
+    close(commandPipe);
+    close(statusPipe);
+    int exitStatus;
+    while (waitpid(pid, &exitStatus, 0) == -1 && errno == EINTR)
+    {
+        ;
+    }
+    pid = -1;
+    commandPipe = -1;
+    statusPipe = -1;
+    return WIFEXITED(exitStatus) ? WEXITSTATUS(exitStatus) : -(WTERMSIG(exitStatus));
+}
+
+
+/**
+ * Write a complete buffer to the shell command pipe.  If the
+ * shell has gone away, the write fails with EPIPE.  SIGPIPE is
+ * blocked while writing and a SIGPIPE raised by our write is
+ * discarded, so a dead shell can't terminate the interpreter.
+ *
+ * @param data   The data to write.
+ * @param length The data length.
+ *
+ * @return true if everything was written.
+ */
+bool ShellSession::writeAll(const char *data, size_t length)
+{
+    sigset_t pipeSignal, pending, oldMask;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+
+    // if there's already a SIGPIPE pending, it's not ours to discard
+    sigpending(&pending);
+    bool alreadyPending = sigismember(&pending, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &oldMask);
+
+    bool success = true;
+    while (length > 0)
+    {
+        ssize_t written = write(commandPipe, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            success = false;
+            break;
+        }
+        data += written;
+        length -= written;
+    }
+
+    if (!success && errno == EPIPE && !alreadyPending)
+    {
+        sigpending(&pending);
+        if (sigismember(&pending, SIGPIPE))
+        {
+            int signal;
+            sigwait(&pipeSignal, &signal);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
+    return success;
+}
+
+
+/**
+ * Send a command to the shell.  The command text is quoted as a
+ * single eval argument, with each embedded single quote written
+ * as '\''.  "command eval" keeps the shell alive if the command
+ * has a syntax error, and the redirections give the command the
+ * original stdin while hiding the status pipe from it.
+ *
+ * @param command The command string.
+ *
+ * @return true if the complete command could be written.
+ */
+bool ShellSession::send(const char *command)
+{
+    static const char prefix[] = "command eval '";
+    static const char quote[] = "'\\''";
+    static const char suffix[] = "' 0<&4 3>&- 4<&-\necho $? >&3\n";
+
+    if (!writeAll(prefix, sizeof(prefix) - 1))
+    {
+        return false;
+    }
+    for (const char *quotePosition = strchr(command, '\''); quotePosition != NULL; quotePosition = strchr(command, '\''))
+    {
+        if (!writeAll(command, quotePosition - command) || !writeAll(quote, sizeof(quote) - 1))
+        {
+            return false;
+        }
+        command = quotePosition + 1;
+    }
+    return writeAll(command, strlen(command)) && writeAll(suffix, sizeof(suffix) - 1);
+}
+
+
+/**
+ * Run a command in the session shell, starting the shell if
+ * this is the first command (or if the previous shell exited).
+ *
+ * @param command The command string.
+ * @param rc      The returned command return code.
+ *
+ * @return false if the shell could not be started or was lost while
+ *         sending it the command.
+ */
+bool ShellSession::run(const char *command, int &rc)
+{
+    if (pid == -1 && !start())
+    {
+        return false;
+    }
+
+    // if we can't send the command, the shell has been terminated
+    // since the last command.  Try again once with a new shell.
+    if (!send(command))
+    {
+        stop();
+        if (!start() || !send(command))
+        {
+            stop();
+            return false;
+        }
+    }
+
+    char status[32];
+    size_t length = 0;
+    while (length < sizeof(status) - 1)
+    {
+        ssize_t count = read(statusPipe, &status[length], 1);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0 || status[length] == '\n')
+        {
+            break;
+        }
+        length++;
+    }
+
+    // no return code, so the shell has terminated.  This happens with
+    // an "exit" command.  We use the shell exit status and start a fresh
+    // shell with the next command.
+    if (length == 0 || status[length] != '\n')
+    {
+        rc = terminated();
+        return true;
+    }
+
+    status[length] = '\0';
+    rc = atoi(status);
+    return true;
+}
+
+
+/**
+ * The command handler for the persistent shell environment.
+ * Redirection isn't supported, as the commands don't get their
+ * own process we could connect any pipes to.
+ *
+ * @param context    The Exit context.
+ * @param address    The environment name.
+ * @param command    The command name and arguments.
+ */
+RexxObjectPtr RexxEntry sessionCommandHandler(RexxExitContext *context, RexxStringObject address, RexxStringObject command)
+{
+    CSTRING commandString = context->CString(command);
+
+    int rc;
+    if (!contextToActivity(context)->getSysActivity().getShellSession()->run(commandString, rc))
+    {
+        return ErrorFailure(context, commandString);
+    }
+    return CommandResult(context, commandString, rc);
 }
 
 
@@ -1091,5 +1430,10 @@ void SysInterpreterInstance::registerCommandHandlers(InterpreterInstance *_insta
     // This is a no-shell environment that searches PATH.  It is named "PATH"
     // which happens to be compatible with Regina.
     _instance->addCommandHandler("PATH", (REXXPFN)ioCommandHandler, HandlerType::REDIRECTING);
+
+    // A persistent "sh" co-process per activity.  Commands issued to this
+    // environment share one shell, which avoids a process spawn per
+    // command and keeps the shell state between commands.
+    _instance->addCommandHandler("SHSESSION", (REXXPFN)sessionCommandHandler, HandlerType::DIRECT);
 }
 
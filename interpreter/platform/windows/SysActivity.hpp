@@ -62,6 +62,7 @@ public:
     void useCurrentThread();
     bool validateThread();
     inline thread_id_t getThreadID() { return threadId; }
+    inline void cleanupResources() { }
 
     static thread_id_t queryThreadID();
     static char* getStackBase();
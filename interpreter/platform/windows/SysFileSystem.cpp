@@ -986,6 +986,30 @@ int64_t SysFileSystem::getFileLength(const char *name)
 }
 
 
+/**
+ * Retrieve the information that identifies the current version
+ * of a file.
+ *
+ * @param name     The target name.
+ * @param identity The returned identity.
+ *
+ * @return true if the file exists, false otherwise.
+ */
+bool SysFileSystem::getFileIdentity(const char *name, SysFileIdentity &identity)
+{
+    WIN32_FILE_ATTRIBUTE_DATA stat;
+
+    if (!GetFileAttributesEx(name, GetFileExInfoStandard, &stat))
+    {
+        return false;
+    }
+    identity.modified = (((uint64_t)stat.ftLastWriteTime.dwHighDateTime) << 32) + stat.ftLastWriteTime.dwLowDateTime;
+    identity.created = (((uint64_t)stat.ftCreationTime.dwHighDateTime) << 32) + stat.ftCreationTime.dwLowDateTime;
+    identity.size = (((uint64_t)stat.nFileSizeHigh) << 32) + stat.nFileSizeLow;
+    return true;
+}
+
+
 /**
  * Create a directory in the file system.
  *
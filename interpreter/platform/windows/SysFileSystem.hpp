@@ -51,6 +51,25 @@
 class RexxString;
 class FileNameBuffer;
 
+/**
+ * Identifies a particular version of a file.  Used to check
+ * whether something derived from a file's contents is still
+ * current.
+ */
+class SysFileIdentity
+{
+ public:
+     inline bool operator==(const SysFileIdentity &o) const
+     {
+         return modified == o.modified && created == o.created && size == o.size;
+     }
+     inline bool operator!=(const SysFileIdentity &o) const { return !(*this == o); }
+
+     uint64_t modified;     // last write time, as a FILETIME value
+     uint64_t created;      // creation time, as a FILETIME value
+     uint64_t size;         // the file size
+};
+
 class SysFileSystem
 {
  public:
@@ -114,6 +133,7 @@ class SysFileSystem
      static bool  setLastAccessDate(const char *name, int64_t time);
 
      static int64_t getFileLength(const char *name);
+     static bool  getFileIdentity(const char *name, SysFileIdentity &identity);
      static bool  makeDirectory(const char *name);
      static bool  isHidden(const char *name);
      static bool  setFileReadOnly(const char *name);
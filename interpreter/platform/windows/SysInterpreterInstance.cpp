@@ -45,6 +45,7 @@
 #include "ListClass.hpp"
 #include "SystemInterpreter.hpp"
 #include "RexxActivation.hpp"
+#include "ActivityManager.hpp"
 
 
 /**
@@ -71,6 +72,31 @@ void SysInterpreterInstance::initialize(InterpreterInstance *i, RexxOption *opti
 
     instance = i;
 
+    // the external call cache can be turned off or told to skip file checks
+    if (GetEnvironmentVariable("RXCALLCACHE", rxTraceBuf, 8))
+    {
+        if (!Utilities::strCaselessCompare(rxTraceBuf, "OFF"))
+        {
+            instance->externalPrograms.setMode(ExternalProgramCache::CACHE_OFF);
+        }
+        else if (!Utilities::strCaselessCompare(rxTraceBuf, "TRUST"))
+        {
+            instance->externalPrograms.setMode(ExternalProgramCache::CACHE_TRUST);
+        }
+    }
+
+    // the number of idle threads kept around for reuse by START, REPLY and .Executor
+    if (GetEnvironmentVariable("RXTHREADPOOL", rxTraceBuf, 8) && Utilities::isDigit(*rxTraceBuf))
+    {
+        ActivityManager::setThreadPoolSize(strtoul(rxTraceBuf, NULL, 10));
+    }
+
+    // the number of threads used to mark a large heap during garbage collection
+    if (GetEnvironmentVariable("RXGCTHREADS", rxTraceBuf, 8) && Utilities::isDigit(*rxTraceBuf))
+    {
+        memoryObject.setMarkingThreads(strtoul(rxTraceBuf, NULL, 10));
+    }
+
     // add our default search extension
     addSearchExtension(".REX");
 }
@@ -855,6 +855,16 @@ void TreeFinder::checkFile(SysFileIterator::FileAttributes &attributes)
 }
 
 
+/**
+ * Platform-specific TreeFinder method for walking the directory
+ * tree, starting with the resolved file path.
+ */
+void TreeFinder::searchTree()
+{
+    recursiveFindFile(filePath);
+}
+
+
 /**
  * Platform-specific TreeFinder method for locating the end of the
  * fileSpec directory
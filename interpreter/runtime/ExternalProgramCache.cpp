@@ -0,0 +1,312 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                     ExternalProgramCache.cpp   */
+/*                                                                            */
+/* Cache of resolved and translated external Rexx programs                    */
+/*                                                                            */
+/******************************************************************************/
+#include "RexxCore.h"
+#include "ExternalProgramCache.hpp"
+#include "PackageClass.hpp"
+#include "RoutineClass.hpp"
+#include "BufferClass.hpp"
+#include "ProgramSource.hpp"
+#include "LanguageParser.hpp"
+#include "ProtectedObject.hpp"
+
+
+/**
+ * Normal live marking.
+ */
+void ExternalProgramCache::live(size_t liveMark)
+{
+    if (entries == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < CACHE_SIZE; i++)
+    {
+        memory_mark(entries[i].name);
+        memory_mark(entries[i].context);
+        memory_mark(entries[i].routine);
+        memory_mark(entries[i].image);
+        memory_mark(entries[i].source);
+    }
+}
+
+
+/**
+ * Generalized live marking.
+ */
+void ExternalProgramCache::liveGeneral(MarkReason reason)
+{
+    // the cache is never part of a saved image
+    if (reason != SAVINGIMAGE && entries != NULL)
+    {
+        for (size_t i = 0; i < CACHE_SIZE; i++)
+        {
+            memory_mark_general(entries[i].name);
+            memory_mark_general(entries[i].context);
+            memory_mark_general(entries[i].routine);
+            memory_mark_general(entries[i].image);
+            memory_mark_general(entries[i].source);
+        }
+    }
+}
+
+
+/**
+ * Locate and translate an external program for a call.
+ *
+ * @param activity The current activity.
+ * @param context  The package making the call.
+ * @param name     The target name.
+ *
+ * @return The routine to run, or OREF_NULL if no program was found.
+ */
+RoutineClass *ExternalProgramCache::resolve(Activity *activity, PackageClass *context, RexxString *name)
+{
+    // only trust mode skips the search, using the result found for the
+    // same name called from the same package.
+    if (mode == CACHE_TRUST)
+    {
+        CacheEntry *entry = findEntry(context, name);
+        if (entry != NULL)
+        {
+            return getRoutine(entry);
+        }
+    }
+
+    // Get full name including path
+    Protected<RexxString> fileName = context->resolveProgramName(activity, name, RESOLVE_DEFAULT);
+
+    if (mode == CACHE_OFF)
+    {
+        return fileName.isNull() ? OREF_NULL : LanguageParser::createProgramFromFile(fileName);
+    }
+
+    // capture the identity before reading the file, so a change made while we
+    // are translating causes a reload on the next call
+    SysFileIdentity identity;
+    if (!fileName.isNull() && !SysFileSystem::getFileIdentity(fileName->getStringData(), identity))
+    {
+        fileName = OREF_NULL;
+    }
+
+    // in validating mode, the program is cached by the file the search found,
+    // so there is nothing to keep for a failed search.
+    if (mode == CACHE_VALIDATE)
+    {
+        if (fileName.isNull())
+        {
+            return OREF_NULL;
+        }
+
+        CacheEntry *entry = findEntry(OREF_NULL, fileName);
+        if (entry != NULL)
+        {
+            if (entry->identity == identity)
+            {
+                return getRoutine(entry);
+            }
+            // the file has changed, so translate it again
+            clearEntry(entry);
+        }
+    }
+
+    // try for a saved program or translate anew.  Errors are raised from here and
+    // nothing gets added to the cache
+    Protected<RoutineClass> routine;
+    if (!fileName.isNull())
+    {
+        routine = LanguageParser::createProgramFromFile(fileName);
+    }
+
+    // the key for the entry.  Trust mode caches by the call, the validating
+    // mode by the resolved file.
+    PackageClass *keyContext = mode == CACHE_TRUST ? context : OREF_NULL;
+    RexxString *keyName = mode == CACHE_TRUST ? name : (RexxString *)fileName;
+
+    // the translation may have given up the kernel, so we only pick the slot now
+    CacheEntry *entry = selectVictim(keyContext, keyName);
+    clearEntry(entry);
+
+    if (!routine.isNull())
+    {
+        PackageClass *package = routine->getPackageObject();
+        // installing classes and requires makes the package unusable for a later
+        // call, so we keep an image that can be restored for each call.
+        if (package->needsInstallation())
+        {
+            entry->image = routine->save();
+            entry->source = package->getProgramSource();
+        }
+        else
+        {
+            entry->routine = routine;
+        }
+        entry->identity = identity;
+    }
+
+    entry->name = keyName;
+    entry->context = keyContext;
+    entry->lastUsed = useCounter;
+    return routine;
+}
+
+
+/**
+ * Find the entry for a given key, if we have one.
+ *
+ * @param context The package making the call (OREF_NULL for an entry
+ *                keyed by the resolved file name).
+ * @param name    The target name or the resolved file name.
+ *
+ * @return The matching entry, or NULL.
+ */
+ExternalProgramCache::CacheEntry *ExternalProgramCache::findEntry(PackageClass *context, RexxString *name)
+{
+    if (entries == NULL)
+    {
+        return NULL;
+    }
+
+    // Objects never move, so the context address is stable while we reference it.
+    size_t hash = (size_t)name->getStringHash() + ((uintptr_t)context >> 4);
+    CacheEntry *set = entries + (hash & (CACHE_SETS - 1)) * CACHE_WAYS;
+
+    useCounter++;
+
+    for (size_t i = 0; i < CACHE_WAYS; i++)
+    {
+        CacheEntry *entry = set + i;
+        if (entry->name != OREF_NULL && entry->context == context && entry->name->memCompare(name))
+        {
+            entry->lastUsed = useCounter;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * Pick the slot for a new entry.  This is either an empty slot
+ * or the least recently used entry of the set.
+ *
+ * @param context The package making the call (OREF_NULL for an entry
+ *                keyed by the resolved file name).
+ * @param name    The target name or the resolved file name.
+ *
+ * @return The entry to replace.
+ */
+ExternalProgramCache::CacheEntry *ExternalProgramCache::selectVictim(PackageClass *context, RexxString *name)
+{
+    if (entries == NULL)
+    {
+        entries = new CacheEntry[CACHE_SIZE]();
+    }
+
+    size_t hash = (size_t)name->getStringHash() + ((uintptr_t)context >> 4);
+    CacheEntry *set = entries + (hash & (CACHE_SETS - 1)) * CACHE_WAYS;
+
+    CacheEntry *victim = set;
+    for (size_t i = 0; i < CACHE_WAYS; i++)
+    {
+        CacheEntry *entry = set + i;
+        // an empty slot is always the best candidate, and if another thread resolved
+        // the same key in the meantime, we replace that one.
+        if (entry->name == OREF_NULL || (entry->context == context && entry->name->memCompare(name)))
+        {
+            return entry;
+        }
+        if (entry->lastUsed < victim->lastUsed)
+        {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+
+/**
+ * Get the routine to run for a cache hit.
+ *
+ * @param entry  The entry for the call.
+ *
+ * @return A routine object, or OREF_NULL if the call did not resolve.
+ */
+RoutineClass *ExternalProgramCache::getRoutine(CacheEntry *entry)
+{
+    if (entry->routine != OREF_NULL || entry->image == OREF_NULL)
+    {
+        return entry->routine;
+    }
+
+    // restore a fresh copy from the saved image.  The image does not include the
+    // source, so give the copy the source we kept.
+    RoutineClass *routine = RoutineClass::restore(entry->image->getData(), entry->image->getDataLength());
+    routine->attachSource(entry->source);
+    return routine;
+}
+
+
+/**
+ * Reset a single entry.
+ *
+ * @param entry  The entry to clear.
+ */
+void ExternalProgramCache::clearEntry(CacheEntry *entry)
+{
+    entry->name = OREF_NULL;
+    entry->context = OREF_NULL;
+    entry->routine = OREF_NULL;
+    entry->image = OREF_NULL;
+    entry->source = OREF_NULL;
+    entry->lastUsed = 0;
+}
+
+
+/**
+ * Drop all cached programs, used at instance termination.
+ */
+void ExternalProgramCache::clear()
+{
+    delete [] entries;
+    entries = NULL;
+}
@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2026 Rexx Language Association. All rights reserved.         */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* https://www.oorexx.org/license.html                                        */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/* REXX Kernel                                     ExternalProgramCache.hpp   */
+/*                                                                            */
+/* Cache of resolved and translated external Rexx programs                    */
+/*                                                                            */
+/******************************************************************************/
+#ifndef Included_ExternalProgramCache
+#define Included_ExternalProgramCache
+
+#include "RexxCore.h"
+#include "SysFileSystem.hpp"
+
+class Activity;
+class PackageClass;
+class RoutineClass;
+class BufferClass;
+class ProgramSource;
+
+/**
+ * A per-instance cache of external Rexx programs invoked via
+ * CALL or a function call.  Without it, every call searches the
+ * path for the program file, reads it, and translates it again.
+ *
+ * A program whose package needs no installation step (no
+ * ::CLASS, ::REQUIRES or ::LIBRARY directives) is reused as is.
+ * For any other program, the translated image is kept and a
+ * fresh copy gets restored for each call, so every call still
+ * gets its own classes, just as if the file had been read again.
+ *
+ * In the default validating mode, every call still searches
+ * for the program file, so a file that appears earlier in the
+ * search order or a changed PATH is noticed just as before.
+ * Only the translation is cached, keyed by the resolved file
+ * name, and an entry is only used while the file still has the
+ * same identity (device, inode, modification time and size).
+ * In trust mode, entries are keyed by the target name and the
+ * package making the call, since the package's directory and
+ * extension steer the search.  The search is then skipped
+ * entirely, no checks are made, and lookups that found nothing
+ * are cached as well.  The mode is chosen with the RXCALLCACHE
+ * environment variable: OFF disables the cache, TRUST selects
+ * trust mode.
+ *
+ * The cache is organized as a set-associative table.  A key
+ * maps to a single set, and when that set is full, the least
+ * recently used entry gets replaced.
+ *
+ * The table holds at most CACHE_SIZE (1024) entries.  An entry
+ * keeps the translated program (and in trust mode, the
+ * calling package), along with everything they reference,
+ * alive until the entry is replaced or the instance
+ * terminates.  An instance that runs many different generated
+ * programs can therefore hold on to up to that many packages
+ * it no longer uses; RXCALLCACHE=OFF avoids this.
+ */
+class ExternalProgramCache
+{
+public:
+    // zero-filled storage is a valid cache in validating mode
+    typedef enum
+    {
+        CACHE_VALIDATE,
+        CACHE_TRUST,
+        CACHE_OFF,
+    } CacheMode;
+
+    void live(size_t liveMark);
+    void liveGeneral(MarkReason reason);
+
+    inline void setMode(CacheMode m) { mode = m; }
+    RoutineClass *resolve(Activity *activity, PackageClass *context, RexxString *name);
+    void clear();
+
+protected:
+
+    static const size_t CACHE_SETS = 256;    // number of sets, must be a power of two
+    static const size_t CACHE_WAYS = 4;      // entries per set
+    static const size_t CACHE_SIZE = CACHE_SETS * CACHE_WAYS;
+
+    /**
+     * A single cache entry.
+     */
+    typedef struct
+    {
+        RexxString    *name;         // the target name, or the resolved file name
+        PackageClass  *context;      // the package making the call (trust mode only)
+        RoutineClass  *routine;      // a reusable routine, if the package allows it
+        BufferClass   *image;        // otherwise, the flattened routine
+        ProgramSource *source;       // and the source to reattach to each copy
+        SysFileIdentity identity;    // the identity of the file when translated
+        size_t         lastUsed;     // the use counter value when last used
+    } CacheEntry;
+
+    CacheEntry *findEntry(PackageClass *context, RexxString *name);
+    CacheEntry *selectVictim(PackageClass *context, RexxString *name);
+    RoutineClass *getRoutine(CacheEntry *entry);
+    void clearEntry(CacheEntry *entry);
+
+    CacheEntry *entries;             // allocated on first use
+    CacheMode   mode;                // the validation mode
+    size_t      useCounter;          // increases with every lookup, used for LRU
+};
+
+#endif
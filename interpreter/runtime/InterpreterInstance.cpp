@@ -105,15 +105,21 @@ void InterpreterInstance::live(size_t liveMark)
     // the list itself is not a Rexx object, but its contents are, and this is
     // what keeps the activities alive. The resource lock is what the paths that
     // maintain the list hold; we already have kernel access here, so taking it
-    // in that order is permitted.
+    // in that order is permitted.  A parallel mark can run this on a helper
+    // thread, which must not wait for a lock the collecting thread might hold.
+    // The collecting thread holds the lock for the whole parallel mark instead.
     {
-        ResourceSection lock;
+        bool locked = !memoryObject.isParallelMarking() && Interpreter::getResourceLock();
         std::vector<Activity *> &acts = allActivities.contents();
         for (size_t i = 0; i < acts.size(); i++)
         {
             RexxInternalObject *entry = acts[i];
             memory_mark(entry);
         }
+        if (locked)
+        {
+            Interpreter::releaseResourceLock();
+        }
     }
     memory_mark(defaultEnvironment);
     memory_mark(searchPath);
@@ -122,6 +128,8 @@ void InterpreterInstance::live(size_t liveMark)
     memory_mark(localEnvironment);
     memory_mark(commandHandlers);
     memory_mark(requiresFiles);
+    externalPrograms.live(liveMark);
+    interpretCache.live(liveMark);
 }
 
 
@@ -167,6 +175,8 @@ void InterpreterInstance::liveGeneral(MarkReason reason)
         memory_mark_general(localEnvironment);
         memory_mark_general(commandHandlers);
         memory_mark_general(requiresFiles);
+        externalPrograms.liveGeneral(reason);
+        interpretCache.liveGeneral(reason);
     }
 }
 
@@ -576,12 +586,19 @@ bool InterpreterInstance::terminate()
         // before running the garbage collector
         rootActivity->clearLocalReferences();
 
+        // drop the cached interpret code first, so that objects only this
+        // cache kept alive get their uninits run below
+        interpretCache.clear();
+
         // before we update of the data structures, make sure we process any
         // pending uninit activity.
         memoryObject.collectAndUninit(Interpreter::lastInstance());
 
         // do system specific termination of an instance
         sysInstance.terminate();
+        // the cache storage is not a Rexx object, so release it while the
+        // collector is still locked out
+        externalPrograms.clear();
 
         // Unlink from the interpreter's instance list while we still hold kernel
         // access. That list is a Rexx object the collector walks, so it must not
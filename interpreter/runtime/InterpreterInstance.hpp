@@ -49,6 +49,8 @@
 #include "ActivationApiContexts.hpp"
 #include "SysInterpreterInstance.hpp"
 #include "CommandHandler.hpp"
+#include "ExternalProgramCache.hpp"
+#include "InterpretCache.hpp"
 
 class DirectoryClass;
 class CommandHandler;
@@ -126,6 +128,11 @@ public:
     PackageClass *loadRequires(Activity *activity, RexxString *shortName, RexxString *fullName);
     PackageClass *loadRequires(Activity *activity, RexxString *shortName, const char *data, size_t length);
     void          addRequiresFile(RexxString *shortName, RexxString *fullName, PackageClass *package);
+    inline RoutineClass *resolveExternalProgram(Activity *activity, PackageClass *context, RexxString *name)
+    {
+        return externalPrograms.resolve(activity, context, name);
+    }
+    inline InterpretCache &getInterpretCache() { return interpretCache; }
     inline void   setupProgram(RexxActivation *activation)
     {
         sysInstance.setupProgram(activation);
@@ -160,6 +167,8 @@ protected:
     DirectoryClass      *localEnvironment;   // the current local environment
     StringTable         *commandHandlers;    // our list of command environment handlers
     StringTable         *requiresFiles;      // our list of requires files used by this instance
+    ExternalProgramCache externalPrograms;   // external programs called by this instance
+    InterpretCache      interpretCache;      // strings interpreted by this instance
 
     bool terminating;                        // shutdown indicator
     bool terminated;                         // last thread cleared indicator
@@ -109,4 +109,21 @@ INTERNAL_METHOD(file_set_last_accessed)
 INTERNAL_METHOD(file_set_writable)
 INTERNAL_METHOD(file_temporary_path)
 INTERNAL_METHOD(file_search_path_impl)
+INTERNAL_METHOD(numarray_init)
+INTERNAL_METHOD(numarray_detach)
+INTERNAL_METHOD(numarray_items)
+INTERNAL_METHOD(numarray_at)
+INTERNAL_METHOD(numarray_put)
+INTERNAL_METHOD(numarray_append)
+INTERNAL_METHOD(numarray_appendrange)
+INTERNAL_METHOD(numarray_scale)
+INTERNAL_METHOD(numarray_combine)
+INTERNAL_METHOD(numarray_sort)
+INTERNAL_METHOD(numarray_sum)
+INTERNAL_METHOD(numarray_min)
+INTERNAL_METHOD(numarray_max)
+INTERNAL_METHOD(numarray_makearray)
+INTERNAL_METHOD(numarray_tostem)
+INTERNAL_METHOD(executor_set_worker)
+INTERNAL_METHOD(executor_worker_slot)
 
@@ -47,6 +47,10 @@
 #include <ctype.h>
 #include <cmath>
 #include <cfloat>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 #include "oorexxapi.h"
 #include "PackageManager.hpp"
 #include "RexxUtilCommon.hpp"
@@ -55,109 +59,321 @@
 #include "SysFile.hpp"
 #include "SysFileSystem.hpp"
 #include "SystemInterpreter.hpp"
+#include "SysThread.hpp"
 #include "Utilities.hpp"
 #include "Numerics.hpp"
 
 
 const int INVALID_FILE_NAME = 123;       // a return value for a SysFileTree name problem
+const size_t MaxSearchThreads = 8;       // the maximum number of threads searching for SysFileSearchAll
 
 const char TreeFinder::AttributeMask::maskChars[6] = "ADHRS";
 
 /**
- * A simple class for reading lines from a file.
+ * The lines located by a file search.  The lines are kept in a
+ * single buffer with their end offsets, as lines may contain
+ * embedded null characters.
  */
-class LineReader
+class SearchResults
 {
  public:
-     LineReader() : buffer(NULL), bufferSize(0), file()
-     { }
-     ~LineReader()
+     SearchResults() : error(NULL) { }
+
+     /**
+      * Add a located line to the results.
+      *
+      * @param lineNumber The line number, or 0 if line numbers are not included.
+      * @param line       The start of the line.
+      * @param length     The length of the line.
+      */
+     void addLine(size_t lineNumber, const char *line, size_t length)
      {
-         close();
+         lines.append(prefix);
+         if (lineNumber != 0)
+         {
+             char number[32]; // 64-bit numbers require 20 chars + blank + NUL
+             snprintf(number, sizeof(number), "%zu ", lineNumber);
+             lines.append(number);
+         }
+         lines.append(line, length);
+         ends.push_back(lines.length());
      }
 
      /**
-      * Open the file and set up for reading
+      * Add all of the located lines to a result stem or array.
       *
-      * @param fileName The name of the file
+      * @param stem   The handler for the result stem.
+      */
+     void addTo(StemHandler &stem)
+     {
+         size_t start = 0;
+         for (size_t i = 0; i < ends.size(); i++)
+         {
+             stem.addValue(lines.data() + start, ends[i] - start);
+             start = ends[i];
+         }
+     }
+
+     std::string prefix;           // a prefix added to each of the lines
+     std::string lines;            // the located lines, one after the other
+     std::vector<size_t> ends;     // the end offsets of each line
+     const char *error;            // any error return string
+};
+
+
+/**
+ * Searches a file for lines containing a string.  The file is read
+ * in large blocks and each block is searched as a whole, so line
+ * boundaries are only located around the hits.  Lines end with a
+ * newline character or with a carriage return/newline pair, the
+ * same rules used by SysFile::gets().
+ *
+ * The searcher does not use any interpreter services, so several
+ * of these can run in parallel.
+ */
+class FileSearcher
+{
+ public:
+     FileSearcher(const char *n, size_t l, bool s, bool ln) : needle(n), needleLength(l), sensitive(s), lineNumbers(ln),
+         lineNumber(0)
+     {
+         // caseless searches are done on an uppercased copy of the data
+         if (!sensitive)
+         {
+             upperNeedle.assign(needle, needleLength);
+             for (size_t i = 0; i < needleLength; i++)
+             {
+                 upperNeedle[i] = Utilities::toUpper(upperNeedle[i]);
+             }
+             needle = upperNeedle.data();
+         }
+     }
+
+     /**
+      * Search a file for lines containing the needle.
       *
-      * @return true if we were able to open the file, false for any failures.
+      * @param fileName The fully qualified file name.
+      * @param results  The object receiving the located lines.
       */
-     bool open(const char *fileName)
+     void search(const char *fileName, SearchResults &results)
      {
+         SysFile file;
          // if this is a directory or we can't open the file, return
          if (SysFileSystem::isDirectory(fileName) ||
              !file.open(fileName, RX_O_RDONLY, RX_S_IREAD, RX_SH_DENYWR))
          {
-             return false;
+             results.error = ERROR_FILEOPEN;
+             return;
+         }
+         // we do our own buffering with much larger blocks
+         file.setBuffering(false, 0);
+
+         size_t bufferSize = BlockSize;
+         AutoFree buffer = (char *)malloc(bufferSize);
+         AutoFree upperBuffer = (char *)(sensitive ? NULL : malloc(bufferSize));
+         if (buffer == (char *)NULL || (!sensitive && upperBuffer == (char *)NULL))
+         {
+             results.error = ERROR_NOMEM;
+             return;
+         }
+
+         lineNumber = 0;
+         // the partial line carried over from the previous block
+         size_t dataLength = 0;
+
+         try
+         {
+             for (;;)
+             {
+                 size_t bytesRead = 0;
+                 size_t wanted = bufferSize - dataLength;
+                 // a short read (or an error) ends the file, the partial line is the last line
+                 bool atEnd = !file.read(buffer + dataLength, wanted, bytesRead) || bytesRead < wanted;
+                 dataLength += bytesRead;
+
+                 // only complete lines get searched until we reach the end
+                 size_t searchLength = dataLength;
+                 if (!atEnd)
+                 {
+                     while (searchLength > 0 && buffer[searchLength - 1] != '\n')
+                     {
+                         searchLength--;
+                     }
+                     // a single line that does not fit, make the buffers bigger and read more
+                     if (searchLength == 0)
+                     {
+                         bufferSize *= 2;
+                         if (!buffer.realloc(bufferSize) || (!sensitive && !upperBuffer.realloc(bufferSize)))
+                         {
+                             results.error = ERROR_NOMEM;
+                             return;
+                         }
+                         continue;
+                     }
+                 }
+
+                 if (!sensitive)
+                 {
+                     for (size_t i = 0; i < searchLength; i++)
+                     {
+                         upperBuffer[i] = Utilities::toUpper(buffer[i]);
+                     }
+                 }
+
+                 searchBlock(buffer, sensitive ? (const char *)buffer : (const char *)upperBuffer, searchLength, results);
+
+                 if (atEnd)
+                 {
+                     return;
+                 }
+                 // move the partial last line to the front of the buffer
+                 dataLength -= searchLength;
+                 memmove(buffer, buffer + searchLength, dataLength);
+             }
+         }
+         catch (std::bad_alloc &)
+         {
+             // we still return the items we've collected so far
+             results.error = ERROR_NOMEM;
          }
-         bufferSize = InitialBufferSize;
-         buffer = (char *)malloc(bufferSize);
-         return buffer != NULL;
      }
 
+ protected:
 
      /**
-      * Read an entire line into buffer, expanding buffer as necessary.
+      * Search a block of complete lines.  The last line is only
+      * allowed to be missing its newline at the end of the file.
       *
-      * @return true if a line could be read, false otherwise.
+      * @param data     The block data.
+      * @param target   The data to search, either data or an uppercased copy.
+      * @param length   The length of the block.
+      * @param results  The object receiving the located lines.
       */
-     bool getLine(const char *&line, size_t &size)
+     void searchBlock(const char *data, const char *target, size_t length, SearchResults &results)
      {
-         size = 0;
-         // loop until an entire line has been read.
-         for (;;)
+         size_t position = 0;        // where the next search starts
+         size_t lineStart = 0;       // the start of the line holding position
+         size_t counted = 0;         // the newlines before this are included in lineNumber
+
+         while (position < length)
          {
-             line = buffer;
-             size_t bytesRead = 0;
-             if (!file.gets(buffer + size, bufferSize - size, bytesRead))
+             const char *hit = findNeedle(target + position, length - position);
+             if (hit == NULL)
              {
-                 // we might have data from a previous iteration of the loop
-                 return size == 0 ? false : true;
+                 break;
              }
-             // update the size of the line now
-             size += bytesRead;
+             size_t hitOffset = hit - target;
 
-             // Check for new line character first.  If we are at eof and the last
-             // line ended in a new line, we don't want the \n in the returned
-             // string.
+             // back up to the start of the line holding the hit
+             size_t start = hitOffset;
+             while (start > lineStart && data[start - 1] != '\n')
+             {
+                 start--;
+             }
+             // and find its end, a carriage return before the newline is not part of the line
+             const char *newline = (const char *)memchr(data + hitOffset, '\n', length - hitOffset);
+             size_t lineEnd = newline != NULL ? newline - data : length;
+             size_t dataEnd = lineEnd;
+             if (newline != NULL && dataEnd > start && data[dataEnd - 1] == '\r')
+             {
+                 dataEnd--;
+             }
 
-             // If we have a new line character in the last position, we have
-             // a line.  The gets() function has translated crlf sequences into
-             // single lf characters.
-             if (buffer[size - 1] == '\n')
+             // a hit running into the line end does not count, but there
+             // might be another one later in the same line
+             if (hitOffset + needleLength > dataEnd)
              {
-                 size--;
-                 return true;
+                 position = hitOffset + 1;
+                 lineStart = start;
+                 continue;
              }
 
-             bufferSize += BufferExpansionSize;
-             if (!buffer.realloc(bufferSize))
+             size_t number = 0;
+             if (lineNumbers)
              {
-                 return false;
+                 lineNumber += countLines(data + counted, start - counted);
+                 counted = start;
+                 number = lineNumber + 1;
              }
+             results.addLine(number, data + start, dataEnd - start);
+
+             // continue with the next line
+             position = lineEnd + 1;
+             lineStart = position;
+         }
+
+         if (lineNumbers)
+         {
+             lineNumber += countLines(data + counted, length - counted);
          }
      }
 
+     /**
+      * Find the next occurrence of the needle.  memchr() is used to
+      * locate candidates, C libraries implement this with vector
+      * instructions.
+      *
+      * @param haystack The data to search.
+      * @param length   The length of the data.
+      *
+      * @return A pointer to the hit or NULL if there is none.
+      */
+     const char *findNeedle(const char *haystack, size_t length)
+     {
+         // we never return a hit for a null string search or if the needle is longer than the haystack
+         if (needleLength == 0 || needleLength > length)
+         {
+             return NULL;
+         }
+
+         const char *last = haystack + length - needleLength;
+         char firstChar = needle[0];
+
+         while (haystack <= last)
+         {
+             haystack = (const char *)memchr(haystack, firstChar, last - haystack + 1);
+             if (haystack == NULL)
+             {
+                 return NULL;
+             }
+             if (memcmp(haystack + 1, needle + 1, needleLength - 1) == 0)
+             {
+                 return haystack;
+             }
+             haystack++;
+         }
+         return NULL;
+     }
 
      /**
-      * Close the read operation.
+      * Count the newline characters in a section of data.
+      *
+      * @param data   The start of the data.
+      * @param length The length to scan.
+      *
+      * @return The number of newlines.
       */
-     void close()
+     size_t countLines(const char *data, size_t length)
      {
-         file.close();
+         size_t count = 0;
+         const char *end = data + length;
+         while ((data = (const char *)memchr(data, '\n', end - data)) != NULL)
+         {
+             count++;
+             data++;
+         }
+         return count;
      }
 
+     // the size of the blocks we read
+     const size_t BlockSize = 0x100000;
 
- protected:
-     // the initial size of our buffer
-     const size_t InitialBufferSize = 0x01000;
-     // amount we extend the buffer by if a line is longer
-     const size_t BufferExpansionSize = 0x01000;
-
-     AutoFree buffer;              // the current buffer
-     size_t   bufferSize;          // current size of the buffer
-     SysFile  file;                // the file we are reading
+     const char *needle;           // the string we search for (uppercased for caseless searches)
+     size_t      needleLength;     // the length of the needle
+     bool        sensitive;        // indicates a case sensitive search
+     bool        lineNumbers;      // indicates the line numbers are returned
+     std::string upperNeedle;      // the uppercased needle for caseless searches
+     size_t      lineNumber;       // the number of lines before the current search position
 };
 
 
@@ -348,8 +564,8 @@ void TreeFinder::findFiles()
     // this could fail.
     getFullPath();
 
-    // now start the search
-    recursiveFindFile(filePath);
+    // now start the search, using the platform's tree walk
+    searchTree();
 }
 
 
@@ -747,80 +963,6 @@ void TreeFinder::addResult(const char *v)
 }
 
 
-/**
- * Determines if the string 'needle' is in the
- * string 'haystack' by returning it's position or
- * a NULL if not found.  The length of haystack and
- * needle are given by 'hlen' and 'nlen' respectively.
- *
- * If 'sensitive' is true, then the search is case
- * sensitive, else it is case insensitive.
- *
- * @param haystack  The haystack to search in.
- * @param needle    The needle to search for
- * @param hlen      the length of the haystack string
- * @param nlen      The lenght of the needle string
- * @param sensitive if true, a case sensitive search is performed. if false, the search is case insensitive.
- *
- * @return A pointer to the first match position or NULL if the string is not found.
- */
-const char* mystrstr(const char *haystack, const char *needle, size_t hlen, size_t nlen, bool sensitive)
-{
-    // we never return a hit for a null string search or if the needle is longer than the haystack
-    if (nlen == 0 || nlen > hlen)
-    {
-        return NULL;
-    }
-
-    // different loops for the sensitive and insensitive searches
-    if (sensitive)
-    {
-        // we scan, looking for a hit on the first character
-        char firstChar = needle[0];
-
-        size_t current = 0;
-        // this is maximum number of places we can get a hit
-        size_t limit = hlen - nlen + 1;
-        for (current = 0; current < limit; current++)
-        {
-            // if we have a hit on the first character, check the entire string
-            if (firstChar == haystack[current])
-            {
-                // if everything compares, return the hit
-                if (memcmp(haystack + current, needle, nlen) == 0)
-                {
-                    return haystack + current;
-                }
-            }
-        }
-    }
-    else
-    {
-        // we scan, looking for a hit on the first character
-        char firstChar = Utilities::toUpper(needle[0]);
-
-        size_t current = 0;
-        // this is maximum number of places we can get a hit
-        size_t limit = hlen - nlen + 1;
-        for (current = 0; current < limit; current++)
-        {
-            // if we have a hit on the first character, check the entire string
-            if (firstChar == Utilities::toUpper(haystack[current]))
-            {
-                // if everything compares, return the hit
-                if (Utilities::memicmp(haystack + current, needle, nlen) == 0)
-                {
-                    return haystack + current;
-                }
-            }
-        }
-    }
-    // if the loops terminate, there are no hits
-    return NULL;
-}
-
-
-
 /*************************************************************************
 * Function:  SysDropFuncs                                                *
 *                                                                        *
@@ -1695,26 +1837,18 @@ RexxRoutine1(int, SysFileDelete, CSTRING, path)
 
 
 /**
- * SysFileSearch searches a file for lines containing needle.
+ * Process the options for SysFileSearch and SysFileSearchAll.
  *
- * @param needle  The string to search for.
- * @param file    The name of the file to search.
- * @param stem    The name of the stem variable that will receive each
- *                file line containing needle.
- * @param opts    A string of options.  A combination of the following chars:
- *                'C' - Case-sensitive search (non-default)
- *                'I' - Case-insensitive search (default)
- *                'N' - Precede each found string in result stem
- *                      with its line number in file (non-default)
- * @return  0 on success, non-zero on error.
- *         ERROR_FILEOPEN if file cannot be opened.
- *         ERROR_NOMEM if not enough memory.
+ * @param context   The call context.
+ * @param name      The name of the calling routine.
+ * @param opts      The specified options (or NULL).
+ * @param linenums  Returns the line numbers option.
+ * @param sensitive Returns the case sensitive option.
  */
-
-RexxRoutine4(CSTRING, SysFileSearch, RexxStringObject, needle, CSTRING, file, RexxObjectPtr, stem, OPTIONAL_CSTRING, opts)
+void getSearchOptions(RexxCallContext *context, const char *name, const char *opts, bool &linenums, bool &sensitive)
 {
-    bool        linenums = false;        // should line numbers be inclued in the output
-    bool        sensitive = false;       // how should searches be performed
+    linenums = false;
+    sensitive = false;
 
     // was the option specified?
     if (opts != NULL)
@@ -1745,73 +1879,252 @@ RexxRoutine4(CSTRING, SysFileSearch, RexxStringObject, needle, CSTRING, file, Re
                 {
                     char buf[256] = { 0 };
                     snprintf(buf, sizeof(buf),
-                             "SysFileSearch options argument must be a combination of C, I, or N; found \"%s\"",
-                             opts);
+                             "%s options argument must be a combination of C, I, or N; found \"%s\"",
+                             name, opts);
 
                     context->ThrowException1(Rexx_Error_Incorrect_call_user_defined, context->String(buf));
                 }
             }
         }
     }
+}
+
+
+/**
+ * SysFileSearch searches a file for lines containing needle.
+ *
+ * @param needle  The string to search for.
+ * @param file    The name of the file to search.
+ * @param stem    The name of the stem variable that will receive each
+ *                file line containing needle.
+ * @param opts    A string of options.  A combination of the following chars:
+ *                'C' - Case-sensitive search (non-default)
+ *                'I' - Case-insensitive search (default)
+ *                'N' - Precede each found string in result stem
+ *                      with its line number in file (non-default)
+ * @return  0 on success, non-zero on error.
+ *         ERROR_FILEOPEN if file cannot be opened.
+ *         ERROR_NOMEM if not enough memory.
+ */
+
+RexxRoutine4(CSTRING, SysFileSearch, RexxStringObject, needle, CSTRING, file, RexxObjectPtr, stem, OPTIONAL_CSTRING, opts)
+{
+    bool        linenums;                // should line numbers be inclued in the output
+    bool        sensitive;               // how should searches be performed
+
+    getSearchOptions(context, "SysFileSearch", opts, linenums, sensitive);
 
     StemHandler stemVariable(context, stem, 3);
-    LineReader fileSource;
     RoutineQualifiedName qualifiedName(context, file);
 
-    // if we can't open, return the error indicator
-    if (!fileSource.open(qualifiedName))
+    FileSearcher searcher(context->StringData(needle), context->StringLength(needle), sensitive, linenums);
+    SearchResults results;
+    searcher.search(qualifiedName, results);
+
+    // even after an error, we return the items we've collected so far
+    results.addTo(stemVariable);
+    return results.error != NULL ? results.error : "0";
+}
+
+
+/**
+ * The files searched by SysFileSearchAll, along with the results
+ * for each of them.  The files are handed out to the searching
+ * threads one at a time.
+ */
+class FileSearchJob
+{
+ public:
+     FileSearchJob(const char *n, size_t l, bool s, bool ln) : needle(n), needleLength(l), sensitive(s), lineNumbers(ln), nextFile(0) { }
+
+     /**
+      * Search files until all of them have been handed out.
+      */
+     void work()
+     {
+         FileSearcher searcher(needle, needleLength, sensitive, lineNumbers);
+         size_t index;
+         while ((index = nextFile++) < files.size())
+         {
+             searcher.search(files[index].c_str(), results[index]);
+         }
+     }
+
+     const char *needle;                  // the string we search for
+     size_t      needleLength;            // the length of the needle
+     bool        sensitive;               // indicates a case sensitive search
+     bool        lineNumbers;             // indicates the line numbers are returned
+     std::vector<std::string> files;      // the qualified names of the files to search
+     std::vector<SearchResults> results;  // the results for each file
+     std::atomic<size_t> nextFile;        // the index of the next file to search
+};
+
+
+/**
+ * A helper thread for a SysFileSearchAll search.
+ */
+class FileSearchThread : public SysThread
+{
+ public:
+     inline FileSearchThread() : SysThread(), job(NULL) { }
+     inline ~FileSearchThread() { terminate(); }
+
+     void start(FileSearchJob *j)
+     {
+         job = j;
+         SysThread::createThread();
+     }
+
+     virtual void dispatch()
+     {
+         job->work();
+     }
+
+     FileSearchJob *job;           // the job we're working for
+};
+
+
+/**
+ * Add the files matching a file specification to a search job.
+ * Only the last section of the specification may contain wildcards,
+ * and directories are not included.
+ *
+ * @param context  The call context.
+ * @param job      The job receiving the file names.
+ * @param fileSpec The file specification.
+ */
+void addSearchFiles(RexxCallContext *context, FileSearchJob &job, const char *fileSpec)
+{
+    // split into the directory and the name pattern
+    const char *pattern = fileSpec;
+    for (const char *p = fileSpec; *p != '\0'; p++)
     {
-        // no items are returned
-        return ERROR_FILEOPEN;
+        if (*p == SysFileSystem::PathDelimiter || *p == '/')
+        {
+            pattern = p + 1;
+        }
     }
 
-    const char *line;
-    size_t lineLength;
+    RoutineFileNameBuffer directory(context);
+    if (pattern == fileSpec)
+    {
+        directory = ".";
+    }
+    else
+    {
+        directory.set(fileSpec, pattern - fileSpec);
+    }
 
-    const char *needleString = context->StringData(needle);
-    size_t needleLength = context->StringLength(needle);
+    RoutineQualifiedName qualifiedDirectory(context, directory);
+    directory = (const char *)qualifiedDirectory;
+    directory.addFinalPathDelimiter();
 
-    size_t currentLine = 0;
+    RoutineFileNameBuffer fileName(context);
+    SysFileIterator finder(directory, pattern, fileName);
+    SysFileIterator::FileAttributes attributes;
 
-    // keep reading while we find lines
-    while (fileSource.getLine(line, lineLength))
+    std::vector<std::string> names;
+    while (finder.hasNext())
     {
-        currentLine++;
-        const char *ptr = mystrstr(line, needleString, lineLength, needleLength, sensitive);
-
-        if (ptr != NULL)
+        finder.next(fileName, attributes);
+        if (!attributes.isDirectory() && fileName.length() > 0)
         {
-            if (linenums)
-            {
-                char lineNumber[32]; // 64-bit numbers require 20 chars + blank + NUL
-                snprintf(lineNumber, sizeof(lineNumber), "%zu ", currentLine);
+            names.push_back(std::string(directory) + (const char *)fileName);
+        }
+    }
+    finder.close();
 
-                size_t lineNumberLength = strlen(lineNumber);
-                size_t totalLineSize = lineNumberLength + lineLength;
+    // the directory order is arbitrary, we return the results sorted by file name
+    std::sort(names.begin(), names.end());
+    job.files.insert(job.files.end(), names.begin(), names.end());
+}
 
-                AutoFree lineBuffer = (char *)malloc(totalLineSize);
-                if (lineBuffer == NULL)
-                {
-                    // we still return the items we've collected so far
-                    return ERROR_NOMEM;
-                }
 
-                // now build the return value
-                memcpy((char *)lineBuffer, lineNumber, lineNumberLength);
-                memcpy((char *)lineBuffer + lineNumberLength, line, lineLength);
+/**
+ * SysFileSearchAll searches several files for lines containing
+ * needle.  The files are searched in parallel, and the located lines
+ * are returned in the order of the files.
+ *
+ * @param needle  The string to search for.
+ * @param files   Either an array of file names or a file specification
+ *                with wildcards in its name section.
+ * @param stem    The name of the stem variable that will receive each
+ *                file line containing needle, preceded by the file name
+ *                and a tab character.
+ * @param opts    A string of options, the same as for SysFileSearch.
+ *
+ * @return  0 on success, non-zero on error.
+ *         ERROR_FILEOPEN if any file cannot be opened.
+ *         ERROR_NOMEM if not enough memory.
+ */
+RexxRoutine4(CSTRING, SysFileSearchAll, RexxStringObject, needle, RexxObjectPtr, files, RexxObjectPtr, stem, OPTIONAL_CSTRING, opts)
+{
+    bool        linenums;                // should line numbers be inclued in the output
+    bool        sensitive;               // how should searches be performed
+
+    getSearchOptions(context, "SysFileSearchAll", opts, linenums, sensitive);
 
-                stemVariable.addValue(lineBuffer, totalLineSize);
-            }
-            else
+    StemHandler stemVariable(context, stem, 3);
+
+    FileSearchJob job(context->StringData(needle), context->StringLength(needle), sensitive, linenums);
+
+    // the file names are resolved before any searching starts, this needs the interpreter
+    if (context->IsArray(files))
+    {
+        RexxArrayObject fileArray = (RexxArrayObject)files;
+        size_t count = context->ArraySize(fileArray);
+        for (size_t i = 1; i <= count; i++)
+        {
+            RexxObjectPtr item = context->ArrayAt(fileArray, i);
+            if (item != NULLOBJECT)
             {
-                stemVariable.addValue(line, lineLength);
+                RoutineQualifiedName qualifiedName(context, context->ObjectToStringValue(item));
+                job.files.push_back(std::string(qualifiedName));
             }
         }
     }
+    else
+    {
+        addSearchFiles(context, job, context->ObjectToStringValue(files));
+    }
+
+    job.results.resize(job.files.size());
+    for (size_t i = 0; i < job.files.size(); i++)
+    {
+        job.results[i].prefix = job.files[i] + '\t';
+    }
 
-    fileSource.close();
+    // the calling thread searches too.  No more threads than there are
+    // processors, if we can tell how many there are
+    size_t threadLimit = MaxSearchThreads;
+    size_t processors = std::thread::hardware_concurrency();
+    if (processors > 0)
+    {
+        threadLimit = std::min(threadLimit, processors);
+    }
+    FileSearchThread threads[MaxSearchThreads - 1];
+    size_t helpers = job.files.size() > 1 ? std::min(job.files.size(), threadLimit) - 1 : 0;
+    for (size_t i = 0; i < helpers; i++)
+    {
+        threads[i].start(&job);
+    }
+    job.work();
+    for (size_t i = 0; i < helpers; i++)
+    {
+        threads[i].waitForTermination();
+    }
 
-    return "0"; // success
+    const char *rc = "0";
+    for (size_t i = 0; i < job.results.size(); i++)
+    {
+        job.results[i].addTo(stemVariable);
+        // a memory failure takes precedence over files that could not be opened
+        if (job.results[i].error != NULL && strcmp(rc, ERROR_NOMEM) != 0)
+        {
+            rc = job.results[i].error;
+        }
+    }
+    return rc;
 }
 
 
@@ -2181,6 +2494,7 @@ RexxRoutineEntry rexxutil_routines[] =
     REXX_TYPED_ROUTINE(SysRmDir,               SysRmDir),
     REXX_TYPED_ROUTINE(SysFileDelete,          SysFileDelete),
     REXX_TYPED_ROUTINE(SysFileSearch,          SysFileSearch),
+    REXX_TYPED_ROUTINE(SysFileSearchAll,       SysFileSearchAll),
     REXX_TYPED_ROUTINE(SysSearchPath,          SysSearchPath),
     REXX_TYPED_ROUTINE(SysSleep,               SysSleep),
     REXX_TYPED_ROUTINE(SysFileMove,            SysFileMove),
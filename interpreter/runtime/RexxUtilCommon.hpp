@@ -380,6 +380,7 @@ class TreeFinder
      void adjustFileSpec();
      void checkFile(SysFileIterator::FileAttributes &attributes);
      void recursiveFindFile(FileNameBuffer &path);
+     void searchTree();
      void addResult(const char *v);
      int findDirectoryEnd();
      bool checkNonPathDrive();
@@ -392,6 +393,8 @@ class TreeFinder
      bool longTime() { return options[LONG_TIME]; }
      bool editableTime() { return options[EDITABLE_TIME]; }
      bool longSize() { return options[LONG_SIZE]; }
+     bool recurse() { return options[RECURSE]; }
+     bool caseless() { return options[CASELESS]; }
 
      bool archiveSelected(bool onOff) { return targetAttributes.isSelected(AttributeMask::Archive, onOff); }
      bool directorySelected(bool onOff) { return targetAttributes.isSelected(AttributeMask::Directory, onOff); }
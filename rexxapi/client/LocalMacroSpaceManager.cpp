@@ -41,6 +41,8 @@
 #include "SysLibrary.hpp"
 #include "ClientMessage.hpp"
 #include "SysFile.hpp"
+#include "SysAPIManager.hpp"
+#include "SynchronizedBlock.hpp"
 #include "rexx.h"
 #include <stdio.h>
 
@@ -272,9 +274,10 @@ void MacroSpaceFile::read(ManagedRxstring &data, size_t length)
 }
 
 
-LocalMacroSpaceManager::LocalMacroSpaceManager() : LocalAPISubsystem()
+LocalMacroSpaceManager::LocalMacroSpaceManager() : LocalAPISubsystem(),
+    directoryDisabled(false), directoryValid(false), generation(NULL), generationFile(0), directoryGeneration(0), directory()
 {
-    // no state in this
+    directoryLock.create();
 }
 
 
@@ -520,6 +523,14 @@ RexxReturnCode LocalMacroSpaceManager::removeMacro(const char *name)
  */
 RexxReturnCode LocalMacroSpaceManager::queryMacro(const char *name, size_t *pos)
 {
+    // the interpreter checks the macro space for every external call, so
+    // try to answer this from our copy of the directory first.
+    RexxReturnCode result;
+    if (queryDirectory(name, pos, result))
+    {
+        return result;
+    }
+
     ClientMessage message(MacroSpaceManager, QUERY_MACRO, name);
     message.send();
     *pos = message.parameter1;
@@ -527,6 +538,143 @@ RexxReturnCode LocalMacroSpaceManager::queryMacro(const char *name, size_t *pos)
 }
 
 
+/**
+ * Try to resolve a macro query using our local copy of the
+ * macro space directory.  The copy is only used while the
+ * server's change counter still matches the value it was
+ * built from.
+ *
+ * @param name   The name to check.
+ * @param pos    The returned search position.
+ * @param result The returned query result.
+ *
+ * @return true if the query was resolved locally, false if the server
+ *         needs to be asked.
+ */
+bool LocalMacroSpaceManager::queryDirectory(const char *name, size_t *pos, RexxReturnCode &result)
+{
+    Lock lock(directoryLock);
+
+    // the counter only exists once a server that supports the directory
+    // query is running.  The first query of a process may be the one that
+    // starts rxapi, so keep trying until the server says it can't help.
+    if (generation == NULL && !directoryDisabled)
+    {
+        generation = SysAPIManager::mapMacroSpaceGeneration(false, generationFile);
+    }
+    if (generation == NULL)
+    {
+        return false;
+    }
+
+    if (!directoryValid || generation->load() != directoryGeneration)
+    {
+        if (!refreshDirectory())
+        {
+            return false;
+        }
+    }
+
+    // names are matched the same way the server does it
+    char key[ServiceMessage::NAMESIZE];
+    Utilities::strncpy(key, name, ServiceMessage::NAMESIZE);
+    for (char *c = key; *c != '\0'; c++)
+    {
+        *c = Utilities::toLower(*c);
+    }
+
+    std::map<std::string, size_t>::iterator it = directory.find(key);
+    if (it == directory.end())
+    {
+        result = RXMACRO_NOT_FOUND;
+    }
+    else
+    {
+        *pos = it->second;
+        result = RXMACRO_OK;
+    }
+    return true;
+}
+
+
+/**
+ * Rebuild the local copy of the macro space directory from
+ * the server.
+ *
+ * @return true if the directory was refreshed, false if the server
+ *         does not support the query.
+ */
+bool LocalMacroSpaceManager::refreshDirectory()
+{
+    directoryValid = false;
+    directory.clear();
+
+    // a server that shut down bumped the counter and removed its file.
+    // Drop the old mapping so the next query maps the new server's counter.
+    if (!SysAPIManager::isMacroSpaceGenerationCurrent(generationFile))
+    {
+        releaseGeneration();
+        return false;
+    }
+
+    ClientMessage message(MacroSpaceManager, QUERY_MACRO_DIRECTORY);
+    try
+    {
+        message.send();
+    }
+    catch (ServiceException *e)
+    {
+        // an older server won't recognize the operation, so stop trying.
+        // Anything else gets sorted out by the normal query.
+        if (e->getErrorCode() == INVALID_OPERATION)
+        {
+            releaseGeneration();
+            directoryDisabled = true;
+        }
+        delete e;
+        return false;
+    }
+
+    if (message.result != MACRO_DIRECTORY_RETURNED)
+    {
+        releaseGeneration();
+        directoryDisabled = true;
+        return false;
+    }
+
+    // the directory is a sequence of one byte search positions followed by
+    // the ASCII-Z macro name
+    const char *current = (const char *)message.getMessageData();
+    const char *end = current + message.getMessageDataLength();
+    while (current < end)
+    {
+        size_t position = (unsigned char)*current++;
+        std::string key(current);
+        current += key.length() + 1;
+        for (size_t i = 0; i < key.length(); i++)
+        {
+            key[i] = Utilities::toLower(key[i]);
+        }
+        directory[key] = position;
+    }
+
+    directoryGeneration = message.parameter1;
+    directoryValid = true;
+    return true;
+}
+
+
+/**
+ * Drop our mapping of the server's macro space change counter.
+ */
+void LocalMacroSpaceManager::releaseGeneration()
+{
+    SysAPIManager::unmapMacroSpaceGeneration(generation);
+    generation = NULL;
+    generationFile = 0;
+}
+
+
 /**
  * Change the search order for a macro item.
  *
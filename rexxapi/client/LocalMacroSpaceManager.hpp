@@ -45,6 +45,10 @@
 #include "Rxstring.hpp"
 #include "Utilities.hpp"
 #include "SysFile.hpp"
+#include "SysSemaphore.hpp"
+#include <atomic>
+#include <map>
+#include <string>
 
 // Macro space version information
 #define RXVERSION  "REXX-ooRexx 6.00"
@@ -184,6 +188,19 @@ public:
     void readRxstringFromFile(SysFile *file, ManagedRxstring &target, size_t size);
     RexxReturnCode mapReturnResult(ServiceMessage &m);
     RexxReturnCode processServiceException(ServiceException *e) override;
+
+protected:
+    bool queryDirectory(const char *name, size_t *pos, RexxReturnCode &result);
+    bool refreshDirectory();
+    void releaseGeneration();
+
+    SysMutex directoryLock;                  // serializes access to the directory copy
+    bool directoryDisabled;                  // the server can't return the directory
+    bool directoryValid;                     // the directory contents are usable
+    std::atomic<uint64_t> *generation;       // the server's macro space change counter
+    uint64_t generationFile;                 // identity of the file holding the counter
+    uint64_t directoryGeneration;            // the counter value our copy was built from
+    std::map<std::string, size_t> directory; // lower case macro name to search position
 };
 
 
@@ -135,6 +135,10 @@ typedef enum
     PROCESS_CLEANUP,
     CONNECTION_ACTIVE,
     CLOSE_CONNECTION,
+
+    // added after the fact, so the values of the operations above stay
+    // compatible with older servers
+    QUERY_MACRO_DIRECTORY,
 } ServerOperation;
 
 typedef enum
@@ -182,7 +186,10 @@ typedef enum
 
     // API manager results
     SERVER_STOPPED,
-    SERVER_NOT_STOPPABLE
+    SERVER_NOT_STOPPABLE,
+
+    // macro space results added after the fact
+    MACRO_DIRECTORY_RETURNED,
 
 }  ServiceReturn;
 
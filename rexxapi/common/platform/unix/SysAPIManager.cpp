@@ -37,6 +37,14 @@
 /*----------------------------------------------------------------------------*/
 
 #include "SysAPIManager.hpp"
+#include "SysCSStream.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 /**
@@ -62,3 +70,131 @@ void SysAPIManager::releaseMemory(void *p)
 }
 
 
+/**
+ * Build the name of the file holding the macro space change
+ * counter.  The file lives next to the service socket.
+ *
+ * @param fileName The buffer for the returned name.
+ * @param size     The size of the buffer.
+ */
+static void getGenerationFileName(char *fileName, size_t size)
+{
+    char location[PATH_MAX];
+    SysServerLocalSocketConnectionManager::getServiceLocation(location, sizeof(location));
+    snprintf(fileName, size, "%s.macros", location);
+}
+
+
+/**
+ * Map the macro space change counter shared between the rxapi
+ * server and its clients.  The counter lives in a small file
+ * next to the service socket.  The server maps it writable and
+ * increments it on every change to the macro space, clients map
+ * it read-only to check if their copy of the macro space
+ * directory is still current.
+ *
+ * The counter is only shared where 64-bit atomics are lock free.
+ * Otherwise std::atomic guards it with a lock private to each
+ * process, which does nothing for the other processes mapping
+ * the same file, and every query goes to the server instead.
+ *
+ * The inode of the mapped file is returned as its identity.  A
+ * restarted server may have created a new file, which the old
+ * mapping never sees, so clients compare the identity with
+ * isMacroSpaceGenerationCurrent() before trusting the counter.
+ * The inode number can't be reused for another file while the
+ * old one is still mapped.
+ *
+ * @param server true for the server side of the mapping.
+ * @param fileId The returned identity of the counter file.
+ *
+ * @return A pointer to the counter, or NULL if it is not available.
+ */
+std::atomic<uint64_t> *SysAPIManager::mapMacroSpaceGeneration(bool server, uint64_t &fileId)
+{
+    fileId = 0;
+#if ATOMIC_LLONG_LOCK_FREE != 2 || ATOMIC_LONG_LOCK_FREE != 2
+    return NULL;
+#else
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "the shared counter must be a plain 64-bit word");
+
+    char fileName[PATH_MAX + 100];
+    getGenerationFileName(fileName, sizeof(fileName));
+
+    int fd = server ? open(fileName, O_RDWR | O_CREAT | O_NOFOLLOW, S_IRUSR | S_IWUSR) : open(fileName, O_RDONLY | O_NOFOLLOW);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    // the file may be in a shared location, so only use one we own
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_uid != geteuid() || !S_ISREG(st.st_mode) ||
+        (server && ftruncate(fd, sizeof(uint64_t)) != 0) ||
+        (!server && (size_t)st.st_size < sizeof(uint64_t)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *counter = mmap(NULL, sizeof(uint64_t), server ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (counter == MAP_FAILED)
+    {
+        return NULL;
+    }
+    fileId = (uint64_t)st.st_ino;
+    return (std::atomic<uint64_t> *)counter;
+#endif
+}
+
+
+/**
+ * Release a mapping of the macro space change counter.
+ *
+ * @param generation The mapped counter.
+ */
+void SysAPIManager::unmapMacroSpaceGeneration(std::atomic<uint64_t> *generation)
+{
+    if (generation != NULL)
+    {
+        munmap((void *)generation, sizeof(uint64_t));
+    }
+}
+
+
+/**
+ * Check that the counter file is still the one that was mapped.
+ * The file is gone or replaced once the server that created it
+ * has shut down.
+ *
+ * @param fileId The identity returned when the counter was mapped.
+ *
+ * @return true if the mapped counter is still the server's counter.
+ */
+bool SysAPIManager::isMacroSpaceGenerationCurrent(uint64_t fileId)
+{
+    char fileName[PATH_MAX + 100];
+    getGenerationFileName(fileName, sizeof(fileName));
+
+    struct stat st;
+    return lstat(fileName, &st) == 0 && (uint64_t)st.st_ino == fileId;
+}
+
+
+/**
+ * Remove the macro space change counter file when the server
+ * shuts down.  The file is only removed if it is still the one
+ * this server mapped.
+ *
+ * @param fileId The identity returned when the counter was mapped.
+ */
+void SysAPIManager::removeMacroSpaceGeneration(uint64_t fileId)
+{
+    if (isMacroSpaceGenerationCurrent(fileId))
+    {
+        char fileName[PATH_MAX + 100];
+        getGenerationFileName(fileName, sizeof(fileName));
+        unlink(fileName);
+    }
+}
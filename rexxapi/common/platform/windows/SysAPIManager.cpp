@@ -62,3 +62,52 @@ void SysAPIManager::releaseMemory(void *p)
 }
 
 
+/**
+ * Map the shared macro space change counter.  This is not
+ * implemented here, so clients always ask the server.
+ *
+ * @param server true for the server side of the mapping.
+ * @param fileId The returned identity of the counter file.
+ *
+ * @return Always NULL.
+ */
+std::atomic<uint64_t> *SysAPIManager::mapMacroSpaceGeneration(bool server, uint64_t &fileId)
+{
+    fileId = 0;
+    return NULL;
+}
+
+
+/**
+ * Release a mapping of the macro space change counter.  Nothing
+ * is ever mapped here.
+ *
+ * @param generation The mapped counter.
+ */
+void SysAPIManager::unmapMacroSpaceGeneration(std::atomic<uint64_t> *generation)
+{
+}
+
+
+/**
+ * Check that the counter file is still the one that was mapped.
+ *
+ * @param fileId The identity returned when the counter was mapped.
+ *
+ * @return Always false.
+ */
+bool SysAPIManager::isMacroSpaceGenerationCurrent(uint64_t fileId)
+{
+    return false;
+}
+
+
+/**
+ * Remove the macro space change counter file.  There is no file
+ * here, so this does nothing.
+ *
+ * @param fileId The identity returned when the counter was mapped.
+ */
+void SysAPIManager::removeMacroSpaceGeneration(uint64_t fileId)
+{
+}
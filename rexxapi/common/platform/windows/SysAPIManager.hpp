@@ -39,11 +39,18 @@
 #ifndef SysAPIManager_HPP_INCLUDED
 #define SysAPIManager_HPP_INCLUDED
 
+#include <atomic>
+#include <stdint.h>
+
 class SysAPIManager
 {
 public:
     static void *allocateMemory(size_t length);
     static void releaseMemory(void *p);
+    static std::atomic<uint64_t> *mapMacroSpaceGeneration(bool server, uint64_t &fileId);
+    static void unmapMacroSpaceGeneration(std::atomic<uint64_t> *generation);
+    static bool isMacroSpaceGenerationCurrent(uint64_t fileId);
+    static void removeMacroSpaceGeneration(uint64_t fileId);
 };
 
 #endif
@@ -54,6 +54,7 @@ void APIServer::initServer(ServerConnectionManager *c)
     connectionManager = c;
 
     lock.create(true);         // create the mutex.
+    ServerMacroSpaceManager::initializeGeneration();
     serverActive = true;
 }
 
@@ -63,6 +64,9 @@ void APIServer::initServer(ServerConnectionManager *c)
  */
 void APIServer::terminateServer()
 {
+    // remove the macro space counter while we still hold the service
+    // location, so a new server can't have created its own file yet
+    ServerMacroSpaceManager::terminateGeneration();
     // flip the sign over to the closed side.
     connectionManager->disconnect();
     delete connectionManager;
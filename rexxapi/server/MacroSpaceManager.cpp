@@ -37,7 +37,13 @@
 /*----------------------------------------------------------------------------*/
 
 #include "MacroSpaceManager.hpp"
+#include "SynchronizedBlock.hpp"
+#include "SysAPIManager.hpp"
 #include "Utilities.hpp"
+#include <string.h>
+
+std::atomic<uint64_t> *ServerMacroSpaceManager::generation = NULL;
+uint64_t ServerMacroSpaceManager::generationFile = 0;
 
 /**
  * Create a macro item entry.
@@ -145,6 +151,51 @@ MacroItem *MacroTable::remove(const char *name)
 }
 
 
+/**
+ * Map the macro space change counter shared with the client
+ * processes.  The counter is bumped once at startup so clients
+ * holding a directory from an earlier server run will refresh.
+ */
+void ServerMacroSpaceManager::initializeGeneration()
+{
+    generation = SysAPIManager::mapMacroSpaceGeneration(true, generationFile);
+    if (generation != NULL)
+    {
+        generation->fetch_add(1);
+    }
+}
+
+
+/**
+ * Remove the macro space change counter at server shutdown.  The
+ * counter is bumped one last time first, so clients refresh, find
+ * the file gone and map the next server's counter.
+ */
+void ServerMacroSpaceManager::terminateGeneration()
+{
+    if (generation != NULL)
+    {
+        generation->fetch_add(1);
+        SysAPIManager::removeMacroSpaceGeneration(generationFile);
+        SysAPIManager::unmapMacroSpaceGeneration(generation);
+        generation = NULL;
+    }
+}
+
+
+/**
+ * Note a change in the macro space so any client copies
+ * of the directory get refreshed.
+ */
+void ServerMacroSpaceManager::macroSpaceChanged()
+{
+    if (generation != NULL)
+    {
+        generation->fetch_add(1);
+    }
+}
+
+
 // Add an item to the macro space.  The message arguments have the
 // following meanings:
 //
@@ -166,6 +217,7 @@ void ServerMacroSpaceManager::addMacro(ServiceMessage &message)
     }
     // we're keeping the storage here, so detach it from the message.
     message.clearMessageData();
+    macroSpaceChanged();
     message.setResult(MACRO_ADDED);
 }
 
@@ -181,6 +233,7 @@ void ServerMacroSpaceManager::deleteMacro(ServiceMessage &message)
     if (item != NULL)
     {
         macros.remove(message.nameArg);
+        macroSpaceChanged();
         message.setResult(MACRO_REMOVED);
     }
     else
@@ -194,6 +247,7 @@ void ServerMacroSpaceManager::deleteMacro(ServiceMessage &message)
 void ServerMacroSpaceManager::clear(ServiceMessage &message)
 {
     macros.clear();
+    macroSpaceChanged();
     message.setResult(MACRO_SPACE_CLEARED);
 }
 
@@ -230,6 +284,7 @@ void ServerMacroSpaceManager::reorderMacro(ServiceMessage &message)
     if (item != NULL)
     {
         item->searchPosition = message.parameter1;
+        macroSpaceChanged();
         message.setResult(MACRO_ORDER_CHANGED);
     }
     else
@@ -360,6 +415,36 @@ void ServerMacroSpaceManager::getImage(ServiceMessage &message)
 }
 
 
+// Return the names and search positions of all macros in a single
+// message.  The generation the directory was built from is returned
+// in parameter1, and the directory is passed back as message data in
+// the form of a one byte search position followed by the ASCII-Z name
+// of the macro for each macro in the space.
+void ServerMacroSpaceManager::queryDirectory(ServiceMessage &message)
+{
+    message.parameter1 = generation != NULL ? generation->load() : 0;
+
+    size_t length = 0;
+    for (MacroItem *item = macros.firstMacro(); item != NULL; item = item->next)
+    {
+        length += strlen(item->name) + 2;
+    }
+
+    if (length > 0)
+    {
+        char *directory = (char *)message.allocateMessageData(length);
+        for (MacroItem *item = macros.firstMacro(); item != NULL; item = item->next)
+        {
+            size_t nameLength = strlen(item->name) + 1;
+            *directory++ = (char)item->searchPosition;
+            memcpy(directory, item->name, nameLength);
+            directory += nameLength;
+        }
+    }
+    message.setResult(MACRO_DIRECTORY_RETURNED);
+}
+
+
 /**
  * Dispatch an inbound operation to this service manager.
  *
@@ -367,6 +452,9 @@ void ServerMacroSpaceManager::getImage(ServiceMessage &message)
  */
 void ServerMacroSpaceManager::dispatch(ServiceMessage &message)
 {
+    // each client connection is serviced on its own thread
+    Lock managerLock(lock);
+
     switch (message.operation)
     {
         case ADD_MACRO:
@@ -402,6 +490,9 @@ void ServerMacroSpaceManager::dispatch(ServiceMessage &message)
         case NEXT_MACRO_IMAGE:
             nextImage(message);
             break;
+        case QUERY_MACRO_DIRECTORY:
+            queryDirectory(message);
+            break;
         default:
             message.setExceptionInfo(INVALID_OPERATION, "Invalid macro space manager operation");
             break;
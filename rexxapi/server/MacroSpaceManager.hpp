@@ -41,6 +41,7 @@
 
 #include "ServiceMessage.hpp"
 #include "SysSemaphore.hpp"
+#include <atomic>
 
 class MacroItem
 {
@@ -115,6 +116,9 @@ public:
         return count;
     }
 
+    // start of the chain, for walks that must not disturb the iterator
+    inline MacroItem *firstMacro() { return macros; }
+
     inline bool iterating() { return iterator != NULL; }
     inline void startIteration() { iterator = macros; }
     inline bool hasMore() { return iterator != NULL; }
@@ -170,17 +174,26 @@ public:
     void nextImage(ServiceMessage &message);
     void getDescriptor(ServiceMessage &message);
     void getImage(ServiceMessage &message);
+    void queryDirectory(ServiceMessage &message);
     void dispatch(ServiceMessage &message);
     void cleanupProcessResources(SessionID session);
 
+    static void initializeGeneration();
+    static void terminateGeneration();
+
     inline bool isStoppable()
     {
         return macros.isEmpty();
     }
 
 protected:
+    void macroSpaceChanged();
+
     SysMutex     lock;                 // our subsystem lock
     MacroTable   macros;               // all of the manaaged macros.
+
+    static std::atomic<uint64_t> *generation;  // change counter shared with the clients
+    static uint64_t generationFile;            // identity of the file holding the counter
 };
 
 #endif